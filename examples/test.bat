@@ -123,8 +123,13 @@ call :compile package_use
 if %errorlevel% neq 0 popd & exit /b %errorlevel%
 call :compile pragma
 if %errorlevel% neq 0 popd & exit /b %errorlevel%
+REM This file should always fail
+call :compile pragma_march_error
+if %errorlevel% neq 1 popd & exit /b %errorlevel%
 call :compile primitives
 if %errorlevel% neq 0 popd & exit /b %errorlevel%
+call :compile prune_type_info
+if %errorlevel% neq 0 popd & exit /b %errorlevel%
 call :compile repeat
 if %errorlevel% neq 0 popd & exit /b %errorlevel%
 call :compile repeat_args
@@ -133,6 +138,11 @@ call :compile repeat_fields
 if %errorlevel% neq 0 popd & exit /b %errorlevel%
 call :compile return_ten
 if %errorlevel% neq 0 popd & exit /b %errorlevel%
+REM Programs run by the compiler should pass their exit code through
+call :compile return_ten --jit
+if %errorlevel% neq 10 popd & exit /b 1
+call :compile return_ten -e
+if %errorlevel% neq 10 popd & exit /b 1
 call :compile scoped_variables
 if %errorlevel% neq 0 popd & exit /b %errorlevel%
 call :compile sizeof
@@ -73,11 +73,17 @@ compile order || exit $?
 compile package || exit $?
 compile package_use || exit $?
 compile pragma || exit $?
+# This file should always fail
+!(compile pragma_march_error) || exit $?
 compile primitives || exit $?
+compile prune_type_info || exit $?
 compile repeat || exit $?
 compile repeat_args || exit $?
 compile repeat_fields || exit $?
 compile return_ten || exit $?
+# Programs run by the compiler should pass their exit code through
+compile return_ten --jit; [ $? -eq 10 ] || exit 1
+compile return_ten -e; [ $? -eq 10 ] || exit 1
 compile scoped_variables || exit $?
 compile sizeof || exit $?
 compile standard || exit $?
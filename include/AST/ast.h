@@ -14,6 +14,7 @@ extern "C" {
 
 #include "UTIL/trait.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
 #include "AST/ast_type.h"
 #include "AST/ast_expr.h"
 #include "AST/meta_directives.h"
@@ -118,6 +119,7 @@ typedef struct {
     ast_struct_t *structs;
     length_t structs_length;
     length_t structs_capacity;
+    hash_index_t structs_index; // Indices of structures by name
     ast_alias_t *aliases;
     length_t aliases_length;
     length_t aliases_capacity;
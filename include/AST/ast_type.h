@@ -17,6 +17,7 @@ extern "C" {
     ---------------------------------------------------------------------------
 */
 
+#include "UTIL/hash.h"
 #include "UTIL/trait.h"
 #include "UTIL/ground.h"
 
@@ -102,6 +103,21 @@ typedef struct {
     char flow; // in | out | inout
 } ast_unnamed_arg_t;
 
+// ---------------- ast_type_interner_t ----------------
+// Set of AST types where each distinct type exists only once,
+// so that interned types are identical if and only if they
+// are the same pointer
+// NOTE: Types are the same to the interner when they're
+//       identical according to 'ast_types_identical'
+// NOTE: Interned types are clones owned by the interner,
+//       and must never be modified
+typedef struct {
+    ast_type_t **types;
+    length_t types_length;
+    length_t types_capacity;
+    hash_index_t index;
+} ast_type_interner_t;
+
 // ---------------- ast_type_clone ----------------
 // Clones an AST type, producing a duplicate
 ast_type_t ast_type_clone(const ast_type_t *type);
@@ -152,10 +168,52 @@ void ast_type_make_generic_float(ast_type_t *type);
 // Generates a c-string given an AST type
 strong_cstr_t ast_type_str(const ast_type_t *type);
 
+// ---------------- ast_type_str_hash ----------------
+// Continues a hash with the c-string that 'ast_type_str' would
+// generate for an AST type, without generating it
+// NOTE: ast_type_str_hash(type, HASH_SEED) == hash_cstr(ast_type_str(type))
+hash_t ast_type_str_hash(const ast_type_t *type, hash_t hash);
+
+// ---------------- ast_type_str_match ----------------
+// Checks whether a c-string begins with what 'ast_type_str' would
+// generate for an AST type, without generating it
+// Returns a pointer to the rest of the c-string, or NULL if it doesn't match
+const char *ast_type_str_match(const ast_type_t *type, const char *str);
+
+// ---------------- ast_type_str_equals ----------------
+// Returns whether a c-string is exactly what 'ast_type_str'
+// would generate for an AST type, without generating it
+bool ast_type_str_equals(const ast_type_t *type, const char *str);
+
+// ---------------- ast_type_hash ----------------
+// Continues a hash with the contents of an AST type
+// NOTE: Types that are identical according to 'ast_types_identical'
+//       always have the same hash
+hash_t ast_type_hash(const ast_type_t *type, hash_t hash);
+
 // ---------------- ast_types_identical ----------------
 // Returns whether or not two AST types are identical
 bool ast_types_identical(const ast_type_t *a, const ast_type_t *b);
 
+// ---------------- ast_type_interner_init ----------------
+// Initializes an empty AST type interner
+void ast_type_interner_init(ast_type_interner_t *interner);
+
+// ---------------- ast_type_interner_free ----------------
+// Frees an AST type interner along with its interned types
+void ast_type_interner_free(ast_type_interner_t *interner);
+
+// ---------------- ast_type_intern ----------------
+// Gets the interned copy of a type, cloning it into the
+// interner if it hasn't been seen before
+// NOTE: 'type' itself can be temporary
+const ast_type_t *ast_type_intern(ast_type_interner_t *interner, const ast_type_t *type);
+
+// ---------------- ast_type_intern_find ----------------
+// Gets the interned copy of a type without adding it
+// Returns NULL if the type hasn't been interned
+const ast_type_t *ast_type_intern_find(ast_type_interner_t *interner, const ast_type_t *type);
+
 // ---------------- ast_type_is_void ----------------
 // Returns whether an AST type is "void"
 bool ast_type_is_void(const ast_type_t *type);
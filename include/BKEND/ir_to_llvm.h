@@ -8,6 +8,8 @@
     ---------------------------------------------------------------------------
 */
 
+#include <llvm/Config/llvm-config.h>
+
 #include "DRVR/compiler.h"
 
 // ---------------- value_catalog_block_t ----------------
@@ -19,15 +21,85 @@ typedef struct { LLVMValueRef *value_references; } value_catalog_block_t;
 // Contains a 'value_catalog_block_t' list that
 // holds the resulting values from every instruction
 // of every block in a function
-typedef struct { value_catalog_block_t *blocks; length_t blocks_length; } value_catalog_t;
+// NOTE: 'value_references' holds the resulting values of the
+//       whole function in flat order, which the blocks point into
+typedef struct { value_catalog_block_t *blocks; length_t blocks_length; LLVMValueRef *value_references; } value_catalog_t;
 
 // ---------------- varstack_t ----------------
 // A list of stack variables for a function
 typedef struct { LLVMValueRef *values; LLVMTypeRef *types; length_t length; } varstack_t;
 
+// ---------------- llvm_type_cache_entry_t ----------------
+// An entry within an 'llvm_type_cache_t'
+typedef struct { ir_type_t *ir_type; LLVMTypeRef llvm_type; } llvm_type_cache_entry_t;
+
+// ---------------- llvm_type_cache_t ----------------
+// Hash table that maps IR types (by identity) to the
+// LLVM types that were generated for them
+// NOTE: 'capacity' is always a power of two
+typedef struct {
+    llvm_type_cache_entry_t *entries;
+    length_t length;
+    length_t capacity;
+} llvm_type_cache_t;
+
+#if LLVM_VERSION_MAJOR >= 8
+
+// ---------------- llvm_debug_file_t ----------------
+// Debugging information for a source file
+// NOTE: 'line_starts' contains the buffer index of the
+//       beginning of each line
+typedef struct {
+    LLVMMetadataRef file;
+    length_t *line_starts;
+    length_t line_starts_length;
+} llvm_debug_file_t;
+
+// ---------------- llvm_debug_t ----------------
+// State for generating DWARF debugging information
+// NOTE: 'files' has an entry for every object in the compiler,
+//       with each one created the first time that it's needed
+typedef struct {
+    LLVMDIBuilderRef builder;
+    LLVMMetadataRef compile_unit;
+    LLVMMetadataRef subroutine_type;
+    LLVMMetadataRef subprogram; // Subprogram of the function being generated
+    llvm_debug_file_t **files;
+    length_t files_length;
+} llvm_debug_t;
+
+#else
+
+// NOTE: Debugging information isn't generated before LLVM 8,
+//       so these are never created
+typedef struct llvm_debug_file llvm_debug_file_t;
+typedef struct llvm_debug llvm_debug_t;
+
+#endif // LLVM_VERSION_MAJOR >= 8
+
+// ---------------- llvm_partition_t ----------------
+// A contiguous range of IR functions that is lowered into
+// its own LLVM context and module, and then emitted as its
+// own object file
+// NOTE: Only the first partition defines global variables
+typedef struct {
+    compiler_t *compiler;
+    object_t *object;
+    const char *triple;
+    LLVMTargetMachineRef target_machine;
+    length_t index;
+    length_t count;
+    length_t funcs_begin;
+    length_t funcs_end;
+    char *object_filename;
+    int object_fd; // File descriptor of temporary object file (or -1)
+    errorcode_t result;
+} llvm_partition_t;
+
 // ---------------- llvm_context_t ----------------
 // A general container for the LLVM exporting context
 typedef struct {
+    LLVMContextRef context;
     LLVMModuleRef module;
     LLVMBuilderRef builder;
     value_catalog_t *catalog;
@@ -37,7 +109,10 @@ typedef struct {
     LLVMValueRef *anon_global_variables;
     LLVMTargetDataRef data_layout;
     LLVMValueRef memcpy_intrinsic;
+    llvm_type_cache_t type_cache;
     compiler_t *compiler;
+    llvm_partition_t *partition;
+    llvm_debug_t *debug; // NULL if not generating debugging information
 
     LLVMValueRef null_check_on_fail_func;
     LLVMBasicBlockRef null_check_on_fail_block;
@@ -45,26 +120,136 @@ typedef struct {
 
 // ---------------- ir_to_llvm_type ----------------
 // Converts an IR type to an LLVM type
-LLVMTypeRef ir_to_llvm_type(ir_type_t *ir_type);
+// NOTE: Non-primitive results are cached in 'llvm->type_cache'
+LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type);
+
+// ---------------- ir_to_llvm_struct_types ----------------
+// Creates named LLVM struct types for every structure in
+// the IR type map and stores them in the type cache
+errorcode_t ir_to_llvm_struct_types(llvm_context_t *llvm, object_t *object);
+
+// ---------------- llvm_type_cache_init ----------------
+// Initializes an LLVM type cache
+void llvm_type_cache_init(llvm_type_cache_t *cache);
+
+// ---------------- llvm_type_cache_free ----------------
+// Frees an LLVM type cache
+void llvm_type_cache_free(llvm_type_cache_t *cache);
+
+// ---------------- llvm_type_cache_slot ----------------
+// Returns the index of the entry for an IR type within a
+// list of cache entries, or the empty slot where it belongs
+length_t llvm_type_cache_slot(llvm_type_cache_entry_t *entries, length_t capacity, ir_type_t *ir_type);
+
+// ---------------- llvm_type_cache_find ----------------
+// Finds the cached LLVM type for an IR type
+// Returns NULL if the IR type isn't cached
+LLVMTypeRef llvm_type_cache_find(llvm_type_cache_t *cache, ir_type_t *ir_type);
+
+// ---------------- llvm_type_cache_insert ----------------
+// Caches the LLVM type for an IR type
+void llvm_type_cache_insert(llvm_type_cache_t *cache, ir_type_t *ir_type, LLVMTypeRef llvm_type);
 
 // ---------------- ir_to_llvm_value ----------------
 // Converts an IR value to an LLVM value
 LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value);
 
+// ---------------- ir_to_llvm_operand ----------------
+// Converts an operand of a flat IR instruction to an LLVM value
+LLVMValueRef ir_to_llvm_operand(llvm_context_t *llvm, ir_flat_func_t *flat, ir_flat_operand_t operand);
+
+// ---------------- ir_to_llvm_literal ----------------
+// Converts a literal stored inline within a flat IR function
+// to an LLVM value
+LLVMValueRef ir_to_llvm_literal(llvm_context_t *llvm, ir_flat_literal_t *literal);
+
+// ---------------- ir_to_llvm_integer_math ----------------
+// Builds an integer add, subtract, or multiply instruction
+// for an IR math instruction, with 'nsw'/'nuw' if the compiler
+// is allowed to assume that integer math never overflows
+LLVMValueRef ir_to_llvm_integer_math(llvm_context_t *llvm, ir_flat_func_t *flat, ir_flat_instr_t *instr);
+
+// ---------------- ir_to_llvm_fast_math ----------------
+// Gives a floating-point LLVM instruction the compiler's
+// fast-math flags if the compiler is in fast-math mode
+void ir_to_llvm_fast_math(llvm_context_t *llvm, LLVMValueRef instr);
+
+// ---------------- ir_to_llvm_enum_attribute ----------------
+// Adds an LLVM attribute (by name) to a function, to its
+// return value, or to one of its parameters
+// NOTE: Parameter 'n' is at index 'n + 1'
+void ir_to_llvm_enum_attribute(llvm_context_t *llvm, LLVMValueRef func, LLVMAttributeIndex index, const char *name);
+
 // ---------------- ir_to_llvm_functions ----------------
 // Generates LLVM function skeletons for IR functions
 errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object);
 
 // ---------------- ir_to_llvm_function_bodies ----------------
-// Generates LLVM function bodies for IR functions
+// Generates LLVM function bodies for the IR functions
+// that belong to the partition being lowered
 errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object);
 
 // ---------------- ir_to_llvm_globals ----------------
 // Generates LLVM globals for IR globals
 errorcode_t ir_to_llvm_globals(llvm_context_t *llvm, object_t *object);
 
+// ---------------- ir_to_llvm_lower_partition ----------------
+// Lowers and optimizes a single partition of an object's IR
+// module into a new LLVM context and module
+// NOTE: The caller is responsible for disposing of both
+errorcode_t ir_to_llvm_lower_partition(llvm_partition_t *partition, LLVMContextRef *out_context, LLVMModuleRef *out_module);
+
+// ---------------- ir_to_llvm_partition ----------------
+// Lowers, optimizes, and emits a single partition of an
+// object's IR module into the partition's object file
+errorcode_t ir_to_llvm_partition(llvm_partition_t *partition);
+
+// ---------------- ir_to_llvm_jit ----------------
+// Lowers and optimizes an entire IR module and then runs its
+// 'main' function in-process using LLVM's MCJIT
+// NOTE: The exit code of 'main' is stored in 'compiler->execute_result'
+errorcode_t ir_to_llvm_jit(llvm_partition_t *partition);
+
+// ---------------- ir_to_llvm_partition_thread ----------------
+// Thread entry point for 'ir_to_llvm_partition'
+// NOTE: The result is stored in 'partition->result'
+void *ir_to_llvm_partition_thread(void *partition);
+
+#ifndef _WIN32
+// ---------------- ir_to_llvm_temporary_object ----------------
+// Creates and opens a new temporary object file
+// Returns the filename and stores the file descriptor
+// into 'out_fd' (which will be -1 on failure)
+char *ir_to_llvm_temporary_object(int *out_fd);
+
+// ---------------- ir_to_llvm_run_program ----------------
+// Runs a program directly (without a shell) and waits for it
+// to finish. Returns SUCCESS if the program exited with zero
+// NOTE: 'argv' must be NULL terminated
+errorcode_t ir_to_llvm_run_program(char **argv);
+
+// ---------------- ir_to_llvm_execute_program ----------------
+// Runs a program directly (without a shell) and waits for it
+// to finish. Returns the exit code of the program, or 128 plus
+// the signal number if it was killed by a signal
+// NOTE: 'argv' must be NULL terminated
+int ir_to_llvm_execute_program(char **argv);
+#endif
+
+// ---------------- ir_to_llvm_split_partitions ----------------
+// Splits the functions of an IR module into 'count' contiguous
+// ranges that contain roughly the same number of instructions
+// NOTE: Only depends on the IR module and 'count', so output
+//       doesn't depend on how the partitions are scheduled
+void ir_to_llvm_split_partitions(llvm_partition_t *partitions, length_t count, ir_module_t *module);
+
 // ---------------- ir_to_llvm_config_optlvl ----------------
 // Converts optimization level to LLVM optimization constant
 LLVMCodeGenOptLevel ir_to_llvm_config_optlvl(compiler_t *compiler);
 
+// ---------------- ir_to_llvm_optimize ----------------
+// Runs the LLVM function and module pass pipelines that
+// correspond to the compiler's optimization level
+void ir_to_llvm_optimize(compiler_t *compiler, LLVMModuleRef module, LLVMTargetMachineRef target_machine);
+
 #endif // IR_TO_LLVM_H
@@ -0,0 +1,43 @@
+
+#ifndef IR_TO_LLVM_DEBUG_H
+#define IR_TO_LLVM_DEBUG_H
+
+/*
+    ============================ ir_to_llvm_debug.h ============================
+    Module for generating DWARF debugging information when
+    exporting intermediate representation to LLVM
+    ----------------------------------------------------------------------------
+*/
+
+#include "BKEND/ir_to_llvm.h"
+
+// ---------------- ir_to_llvm_debug_init ----------------
+// Prepares to generate debugging information for the module
+// being created if the compiler was asked for debug symbols
+// NOTE: Sets 'llvm->debug' to NULL otherwise
+void ir_to_llvm_debug_init(llvm_context_t *llvm, object_t *object);
+
+// ---------------- ir_to_llvm_debug_finalize ----------------
+// Finishes and frees the debugging information for the module
+void ir_to_llvm_debug_finalize(llvm_context_t *llvm);
+
+// ---------------- ir_to_llvm_debug_file ----------------
+// Gets the debugging information for the source file of an object
+// NOTE: Created the first time each object is needed
+llvm_debug_file_t *ir_to_llvm_debug_file(llvm_context_t *llvm, length_t object_index);
+
+// ---------------- ir_to_llvm_debug_location ----------------
+// Converts an index within a source file into a line and column
+// NOTE: Both will be zero if the source text isn't available
+void ir_to_llvm_debug_location(llvm_debug_file_t *file, length_t index, unsigned int *out_line, unsigned int *out_column);
+
+// ---------------- ir_to_llvm_debug_function ----------------
+// Attaches a subprogram to an LLVM function and makes it the
+// scope for the locations of instructions built after this
+void ir_to_llvm_debug_function(llvm_context_t *llvm, LLVMValueRef func, ir_func_t *ir_func);
+
+// ---------------- ir_to_llvm_debug_set_location ----------------
+// Sets the source location of instructions built after this
+void ir_to_llvm_debug_set_location(llvm_context_t *llvm, source_t source);
+
+#endif // IR_TO_LLVM_DEBUG_H
@@ -0,0 +1,35 @@
+
+#ifndef IR_TO_LLVM_SHIM_H
+#define IR_TO_LLVM_SHIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= ir_to_llvm_shim.h =============================
+    Module for using parts of LLVM that the LLVM C API doesn't
+    provide (or only provides in newer versions of LLVM)
+
+    NOTE: Implemented in C++ (ir_to_llvm_shim.cpp)
+    ----------------------------------------------------------------------------
+*/
+
+#include <llvm-c/Core.h>
+
+#include "UTIL/trait.h"
+
+// ---------------- ir_to_llvm_shim_fast_math ----------------
+// Sets the fast-math flags of a floating-point LLVM instruction
+// 'flags' -> FAST_MATH_* flags
+// NOTE: Does nothing for values that can't have fast-math flags,
+//       such as constants that were folded by the builder
+// NOTE: Before LLVM 6, 'FAST_MATH_REASSOC' and 'FAST_MATH_APPROX_FUNC'
+//       can only be expressed together with every other flag
+void ir_to_llvm_shim_fast_math(LLVMValueRef value, trait_t flags);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IR_TO_LLVM_SHIM_H
@@ -13,6 +13,7 @@ extern "C" {
     ----------------------------------------------------------------------------
 */
 
+#include "UTIL/hash.h"
 #include "AST/ast_type.h"
 
 #ifndef ADEPT_INSIGHT_BUILD
@@ -37,11 +38,14 @@ typedef struct {
 
 // ---------------- bridge_var_list_t ----------------
 // A list for tracking variables within a scope
+// NOTE: 'index' maps the hash of a variable name to the
+//       indices of the variables with that name
 typedef struct {
     // Actual names, ast_types and ir_types aren't owned
     bridge_var_t *variables;
     length_t length;
     length_t capacity;
+    hash_index_t index;
 } bridge_var_list_t;
 
 // ---------------- bridge_var_scope_t ----------------
@@ -97,6 +101,11 @@ const char* bridge_var_scope_nearest(bridge_var_scope_t *scope, const char *name
 // Inner recursive implementation of bridge_var_scope_nearest
 void bridge_var_scope_nearest_inner(bridge_var_scope_t *scope, const char *name, char **out_nearest_name, int *out_distance);
 
+// ---------------- bridge_var_list_find ----------------
+// Finds a variable within a bridge variable list by name
+// Returns -1 if no variable with that name is in the list
+maybe_index_t bridge_var_list_find(bridge_var_list_t *list, const char *name);
+
 // ---------------- bridge_var_list_nearest ----------------
 // Finds the nearest variable name to the given variable name
 // within the bridge variable list.
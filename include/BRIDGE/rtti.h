@@ -8,6 +8,18 @@
 
 // ---------------- rtti_for ----------------
 // NOTE: Returns NULL on failure
+// NOTE: Assumes the type table has been reduced
 ir_value_t* rtti_for(ir_builder_t *builder, ast_type_t *target, source_t sourceOnFailure);
 
-#endif // RTTI_H
\ No newline at end of file
+// ---------------- rtti_table_prune ----------------
+// Removes the records of an object's reduced type table that
+// aren't reachable from any of the types used with 'rtti_for'
+// NOTE: Updates the indices that were given out by 'rtti_for'
+void rtti_table_prune(object_t *object);
+
+// ---------------- rtti_table_reach ----------------
+// Marks a record of a type table as reachable and adds
+// it to the worklist if it wasn't already reachable
+void rtti_table_reach(type_table_t *table, bool *reachable, length_t *worklist, length_t *worklist_length, const ast_type_t *type);
+
+#endif // RTTI_H
@@ -29,11 +29,17 @@ typedef struct {
 // ---------------- type_table_t ----------------
 // A bridging type table
 // (used to generate runtime type table)
+// NOTE: 'index' is a hash table of records by name, where each
+//       slot holds a record index plus one (or zero if empty)
+// NOTE: 'index_capacity' is always a power of two
+// NOTE: Records are unique, duplicates are never inserted
 typedef struct {
     type_table_record_t *records;
     length_t length;
     length_t capacity;
     bool reduced;
+    length_t *index;
+    length_t index_capacity;
 } type_table_t;
 
 // ---------------- type_table_init ----------------
@@ -52,15 +58,35 @@ void type_table_give(type_table_t *table, ast_type_t *type, maybe_null_strong_cs
 // (same as type_table_give with an ast_type_t containing a single ast_elem_base_t)
 void type_table_give_base(type_table_t *table, weak_cstr_t name);
 
+// ---------------- type_table_insert ----------------
+// Adds a record to a bridging type table
+// NOTE: Assumes a record with the same name doesn't already exist
+// NOTE: Takes ownership of 'name' and 'type'
+void type_table_insert(type_table_t *table, strong_cstr_t name, ast_type_t type, bool is_alias);
+
 // ---------------- type_table_reduce ----------------
-// Reduces a bridging type table by removing duplicate entries
-// and sorting the remaining unique records
+// Finishes a bridging type table by sorting its records
 void type_table_reduce(type_table_t *table);
 
+// ---------------- type_table_index ----------------
+// Rebuilds the hash index of a bridging type table
+// NOTE: Must be called after records are moved or removed
+void type_table_index(type_table_t *table);
+
 // ---------------- type_table_find ----------------
 // Finds a type_table_record_t within a bridging type table
 maybe_index_t type_table_find(type_table_t *table, const char *name);
 
+// ---------------- type_table_find_type ----------------
+// Finds the type_table_record_t for an AST type within a
+// bridging type table, without generating the name of the type
+maybe_index_t type_table_find_type(type_table_t *table, const ast_type_t *type);
+
+// ---------------- type_table_find_type_with_prefix ----------------
+// Finds the type_table_record_t whose name is 'prefix' followed
+// by the name of an AST type within a bridging type table
+maybe_index_t type_table_find_type_with_prefix(type_table_t *table, const char *prefix, const ast_type_t *type);
+
 // ---------------- type_table_records_free ----------------
 // Frees a set of bridging type table records
 void type_table_records_free(type_table_record_t *records, length_t length);
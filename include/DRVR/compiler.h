@@ -14,6 +14,7 @@ extern "C" {
 
 #include "UTIL/trait.h"
 #include "UTIL/ground.h"
+#include "UTIL/cstr_interner.h"
 #include "DRVR/object.h"
 
 // Possible compiler trait options
@@ -26,12 +27,28 @@ extern "C" {
 #define COMPILER_NO_UNDEF         TRAIT_7
 #define COMPILER_NO_TYPE_INFO     TRAIT_8
 #define COMPILER_NO_REMOVE_OBJECT TRAIT_A
+#define COMPILER_JIT              TRAIT_B
+#define COMPILER_NO_OVERFLOW      TRAIT_C
+#define COMPILER_FAST_MATH        TRAIT_D
+#define COMPILER_PRUNE_TYPE_INFO  TRAIT_E
+#define COMPILER_NO_IR_OPT        TRAIT_F
 
 // Possible compiler trait checks
 #define COMPILER_NULL_CHECKS      TRAIT_1
 #define COMPILER_LEAK_CHECKS      TRAIT_2
 #define COMPILER_BOUNDS_CHECKS    TRAIT_3
 
+// Possible fast-math flags (used when in fast-math mode)
+#define FAST_MATH_REASSOC         TRAIT_1
+#define FAST_MATH_CONTRACT        TRAIT_2
+#define FAST_MATH_NO_NANS         TRAIT_3
+#define FAST_MATH_NO_INFS         TRAIT_4
+#define FAST_MATH_NO_SIGNED_ZEROS TRAIT_5
+#define FAST_MATH_RECIPROCAL      TRAIT_6
+#define FAST_MATH_APPROX_FUNC     TRAIT_7
+#define FAST_MATH_DEFAULT         (FAST_MATH_REASSOC | FAST_MATH_CONTRACT | FAST_MATH_NO_NANS | FAST_MATH_NO_INFS)
+#define FAST_MATH_ALL             (FAST_MATH_DEFAULT | FAST_MATH_NO_SIGNED_ZEROS | FAST_MATH_RECIPROCAL | FAST_MATH_APPROX_FUNC)
+
 // Possible optimization levels
 #define OPTIMIZATION_NONE       0x00
 #define OPTIMIZATION_LESS       0x01
@@ -44,6 +61,7 @@ extern "C" {
 #define COMPILER_DEBUG_DUMP            TRAIT_2
 #define COMPILER_DEBUG_LLVMIR          TRAIT_3
 #define COMPILER_DEBUG_NO_VERIFICATION TRAIT_4
+#define COMPILER_DEBUG_POOL_STATS      TRAIT_5
 #endif // ENABLE_DEBUG_FEATURES
 
 // Possible compiler result flags (for internal use)
@@ -59,13 +77,20 @@ typedef struct {
     object_t **objects;
     length_t objects_length;
     length_t objects_capacity;
+    cstr_interner_t identifiers; // Strings of TOKEN_WORD tokens (shared by every object)
 
     // Compiler command-line configuration options
     trait_t traits;            // COMPILER_* options
     char *output_filename;     // owned c-string
     unsigned int optimization; // 0 - 3 using OPTIMIZATION_* constants
     trait_t result_flags;      // Results flag (for internal use)
+    int execute_result;        // Exit code of the program run with '-e' or '--jit'
     trait_t checks;
+    trait_t fast_math;         // FAST_MATH_* flags used when in fast-math mode
+    length_t jobs;             // Number of code generation partitions
+    length_t ir_pool_size;     // Size in bytes of the first fragment of each IR module's pool
+    char *target_cpu;          // owned c-string (or NULL for generic)
+    char *target_features;     // owned c-string (or NULL for none)
 
     #ifdef ENABLE_DEBUG_FEATURES
     trait_t debug_traits;      // COMPILER_DEBUG_* options
@@ -74,6 +99,7 @@ typedef struct {
 
 // ---------------- compiler_run ----------------
 // Runs a compiler with the given arguments.
+// NOTE: When the compiled program is also run, its exit code is returned
 errorcode_t compiler_run(compiler_t *compiler, int argc, char **argv);
 
 // ---------------- compiler_invoke ----------------
@@ -98,6 +124,16 @@ object_t* compiler_new_object(compiler_t *compiler);
 // argv[0] is ignored
 errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, char **argv);
 
+// ---------------- parse_argument_count ----------------
+// Reads the decimal digits of a numeric argument (e.g. "4" of "--jobs=4")
+// NOTE: 'argument' is the whole argument, and is only used for errors
+errorcode_t parse_argument_count(const char *argument, const char *digits, length_t *out_count);
+
+// ---------------- parse_fast_math_flags ----------------
+// Reads a comma separated list of LLVM fast-math flag names
+// (e.g. "reassoc,contract,nnan,ninf") into FAST_MATH_* flags
+errorcode_t parse_fast_math_flags(const char *list, trait_t *out_flags);
+
 // ---------------- break_into_arguments ----------------
 // Breaks a string into pseudo program arguments
 // (*out_argv)[0] will be a blank constant c-string
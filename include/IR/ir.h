@@ -91,6 +91,9 @@
 #define INSTRUCTION_BIT_LGC_RSHIFT 0x0000004C // ir_instr_math_t
 #define INSTRUCTION_NEGATE         0x0000004D // ir_instr_unary_t
 #define INSTRUCTION_FNEGATE        0x0000004E // ir_instr_unary_t
+#define INSTRUCTION_PTR_ADD        0x0000004F // ir_instr_math_t (a = pointer, b = integer)
+#define INSTRUCTION_PTR_SUBTRACT   0x00000050 // ir_instr_math_t (a = pointer, b = integer)
+#define INSTRUCTION_PTR_DIFFERENCE 0x00000051 // ir_instr_math_t (a = pointer, b = pointer)
 
 // =============================================================
 // ------------------ Possible IR value types ------------------
@@ -107,6 +110,7 @@
 #define VALUE_TYPE_CSTR_OF_LEN         0x00000009 // data = pointer to an 'ir_value_cstr_of_len_t'
 #define VALUE_TYPE_CONST_BITCAST       0x0000000A // data = pointer to an 'ir_value_t'
 #define VALUE_TYPE_STRUCT_CONSTRUCTION 0x0000000B // data = pointer to an 'ir_value_struct_construction_t'
+#define VALUE_TYPE_OFFSETOF            0x0000000C // data = pointer to an 'ir_value_offsetof_t'
 
 #define VALUE_TYPE_IS_CONSTANT(a) (a & VALUE_TYPE_LITERAL || a & VALUE_TYPE_NULLPTR || a & VALUE_TYPE_ARRAY_LITERAL || a & VALUE_TYPE_STRUCT_LITERAL || a & VALUE_TYPE_CONST_ANON_GLOBAL)
 
@@ -119,9 +123,12 @@ typedef struct {
 
 // ---------------- ir_type_map_t ----------------
 // A list of mappings from names to IR types
+// NOTE: 'index' maps the hash of a name to the indices
+//       of the mappings with that name
 typedef struct {
     ir_type_mapping_t *mappings;
     length_t mappings_length;
+    hash_index_t index;
 } ir_type_map_t;
 
 // ---------------- ir_value_t ----------------
@@ -181,12 +188,22 @@ typedef struct {
     length_t length;
 } ir_value_struct_construction_t;
 
+// ---------------- ir_value_offsetof_t ----------------
+// Structure for 'extra' field of 'ir_value_t' if
+// the value is the offset of a member within a structure
+// NOTE: The offset isn't known until the target's data layout is
+typedef struct {
+    ir_type_t *type;
+    length_t index;
+} ir_value_offsetof_t;
+
 // ---------------- ir_instr_t ----------------
 // General structure for intermediate
 // representation instructions
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
 } ir_instr_t;
 
 // ---------------- ir_instr_math_t ----------------
@@ -196,6 +213,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *a, *b;
 } ir_instr_math_t;
 
@@ -206,6 +224,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
 } ir_instr_unary_t;
 
@@ -215,6 +234,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
 } ir_instr_ret_t;
 
@@ -223,6 +243,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     length_t func_id;
     ir_value_t **values;
     length_t values_length;
@@ -233,6 +254,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *address;
     ir_value_t **values;
     length_t values_length;
@@ -243,6 +265,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_type_t *type;
     unsigned int amount;
 } ir_instr_alloc_t;
@@ -252,6 +275,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_type_t *type;
     ir_value_t *amount;
 } ir_instr_malloc_t;
@@ -261,6 +285,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
 } ir_instr_free_t;
 
@@ -269,6 +294,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
     ir_value_t *destination;
 } ir_instr_store_t;
@@ -278,6 +304,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
 } ir_instr_load_t;
 
@@ -288,6 +315,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     length_t index;
 } ir_instr_varptr_t;
 
@@ -297,6 +325,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     length_t block_id;
 } ir_instr_break_t;
 
@@ -306,6 +335,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
     length_t true_block_id;
     length_t false_block_id;
@@ -317,6 +347,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
     length_t member;
 } ir_instr_member_t;
@@ -326,6 +357,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
     ir_value_t *index;
 } ir_instr_array_access_t;
@@ -337,6 +369,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     const char *name;
     length_t func_id;
 } ir_instr_func_address_t;
@@ -347,6 +380,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *value;
 } ir_instr_cast_t;
 
@@ -355,6 +389,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_type_t *type;
 } ir_instr_sizeof_t;
 
@@ -363,6 +398,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_type_t *type;
     length_t index;
 } ir_instr_offsetof_t;
@@ -373,6 +409,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     length_t index;
 } ir_instr_varzeroinit_t;
 
@@ -382,6 +419,7 @@ typedef struct {
 typedef struct {
     unsigned int id;
     ir_type_t *result_type;
+    source_t source;
     ir_value_t *destination;
     ir_value_t *value;
     ir_value_t *bytes;
@@ -397,8 +435,82 @@ typedef struct {
     trait_t traits;
 } ir_basicblock_t;
 
+// ---------------- ir_flat_operand_t ----------------
+// A 32-bit reference to an operand of a flat instruction
+// The low two bits say what the rest of it is an index into:
+// IR_FLAT_OPERAND_NONE    -> nothing (e.g. the value of a void 'ret')
+// IR_FLAT_OPERAND_RESULT  -> 'instructions' (the result of that instruction)
+// IR_FLAT_OPERAND_LITERAL -> 'literals'
+// IR_FLAT_OPERAND_VALUE   -> 'values' (for every other kind of value)
+typedef unsigned int ir_flat_operand_t;
+
+// Possible kinds of 'ir_flat_operand_t'
+#define IR_FLAT_OPERAND_NONE    0x0
+#define IR_FLAT_OPERAND_RESULT  0x1
+#define IR_FLAT_OPERAND_LITERAL 0x2
+#define IR_FLAT_OPERAND_VALUE   0x3
+
+#define IR_FLAT_OPERAND(kind, index)   ((ir_flat_operand_t) (((index) << 2) | (kind)))
+#define IR_FLAT_OPERAND_KIND(operand)  ((operand) & 0x3)
+#define IR_FLAT_OPERAND_INDEX(operand) ((operand) >> 2)
+
+// ---------------- ir_flat_literal_t ----------------
+// A literal that is stored inline within a flat function
+// 'bits' -> the integer or boolean (extended to 64 bits),
+//           or the bits of the 'double' for floating point types
+typedef struct {
+    ir_type_t *type;
+    unsigned long long bits;
+} ir_flat_literal_t;
+
+// ---------------- ir_flat_instr_t ----------------
+// An instruction that is stored inline within a flat function
+// 'operands' -> index of its first operand within the function's 'operands'
+// 'details' -> numbers that an instruction needs besides its operands:
+//     call, funcaddr -> [0] = func_id
+//     varptr, globalvarptr, varzeroinit -> [0] = index of variable
+//     break -> [0] = block_id
+//     condbreak -> [0] = true_block_id, [1] = false_block_id
+//     member -> [0] = member
+//     offsetof -> [0] = index
+//     memcpy -> [0] = is_volatile
+// 'extra' -> type for malloc, sizeof, and offsetof, or name for funcaddr
+typedef struct {
+    unsigned int id;
+    unsigned int operands;
+    unsigned int operands_length;
+    unsigned int details[2];
+    ir_type_t *result_type;
+    void *extra;
+} ir_flat_instr_t;
+
+// ---------------- ir_flat_func_t ----------------
+// The instructions of an IR function laid out back to back in a
+// single buffer, in the order of the basic blocks they come from
+// NOTE: The instructions of basic block 'b' are the ones from
+//       'block_starts[b]' up until 'block_starts[b + 1]'
+// NOTE: 'sources' holds the source of each instruction
+typedef struct {
+    ir_flat_instr_t *instructions;
+    source_t *sources;
+    length_t instructions_length;
+    length_t *block_starts;
+    length_t blocks_length;
+    ir_flat_operand_t *operands;
+    length_t operands_length;
+    length_t operands_capacity;
+    ir_flat_literal_t *literals;
+    length_t literals_length;
+    length_t literals_capacity;
+    ir_value_t **values;
+    length_t values_length;
+    length_t values_capacity;
+} ir_flat_func_t;
+
 // ---------------- ir_func_t ----------------
 // An intermediate representation function
+// NOTE: 'flat' is made from 'basicblocks' by 'ir_flatten_module'
+//       once they won't change anymore
 typedef struct {
     const char *name;
     trait_t traits;
@@ -407,8 +519,10 @@ typedef struct {
     length_t arity;
     ir_basicblock_t *basicblocks;
     length_t basicblocks_length;
+    ir_flat_func_t flat;
     bridge_var_scope_t *var_scope;
     length_t variable_count;
+    source_t source;
 } ir_func_t;
 
 // Possible traits for ir_func_t
@@ -425,7 +539,8 @@ typedef struct {
     ast_func_t *ast_func;
     ir_func_t *module_func;
     length_t func_id;
-    char is_beginning_of_group; // 1 == yes, 0 == no, -1 == uncalculated
+    bool is_beginning_of_group; // (set by ir_gen_find_index)
+    const ast_type_t **arg_types; // Interned argument types (set by ir_gen_find_index)
 } ir_func_mapping_t;
 
 // ---------------- ir_method_t ----------------
@@ -436,18 +551,24 @@ typedef struct {
     ast_func_t *ast_func;
     ir_func_t *module_func;
     length_t func_id;
-    char is_beginning_of_group; // 1 == yes, 0 == no, -1 == uncalculated
+    bool is_beginning_of_group; // (set by ir_gen_find_index)
+    const ast_type_t **arg_types; // Interned argument types (set by ir_gen_find_index)
 } ir_method_t;
 
 // ---------------- ir_global_t ----------------
 // An intermediate representation global variable
+// NOTE: 'static_initializer' is NULL unless the global's
+//       initial value is known at compile time
 typedef struct {
     const char *name;
     ir_type_t *type;
     trait_t traits;
+    ir_value_t *static_initializer;
 } ir_global_t;
 
+// Possible traits for 'ir_global_t'
 #define IR_GLOBAL_EXTERNAL TRAIT_1
+#define IR_GLOBAL_MUTABLE  TRAIT_2 // Global was referenced as a mutable value
 
 // ---------------- ir_anon_global_t ----------------
 // An intermediate representation anonymous global variable
@@ -466,36 +587,90 @@ typedef struct {
 
 } ir_metadata_t;
 
+// ---------------- ir_management_t ----------------
+// Which management functions a type has, where each is
+// either an index into the module's methods/function
+// mappings or -1 if the type doesn't have it
+// NOTE: Found the first time they are needed for a type
+typedef struct {
+    strong_cstr_t type_name;
+    maybe_index_t defer_method;  // Index into 'methods' of '__defer__'
+    maybe_index_t pass_mapping;  // Index into 'func_mappings' of '__pass__'
+    maybe_index_t assign_method; // Index into 'methods' of '__assign__'
+} ir_management_t;
+
+// ---------------- ir_constant_t ----------------
+// A constant IR value that is shared by everything that
+// builds an identical one
+// NOTE: 'bits' holds the value of a literal (or zero)
+// NOTE: 'type' is NULL for values that always have the same type
+typedef struct {
+    unsigned int value_type;
+    ir_type_t *type;
+    unsigned long long bits;
+    ir_value_t *value;
+} ir_constant_t;
+
 // ---------------- ir_shared_common_t ----------------
 // General data that can be directly accessed by the
 // entire IR module
 // 'ir_funcptr_type' -> type used for function pointer implementation
 typedef struct {
     ir_type_t *ir_funcptr;
+    ir_type_t *ir_int;
     ir_type_t *ir_usize;
     ir_type_t *ir_usize_ptr;
     ir_type_t *ir_bool;
+    ir_type_t *ir_ptrdiff;
     ir_type_t *ir_string_struct;
+    maybe_index_t rtti_array_index; // Index of '__types__' global variable (or -1)
 } ir_shared_common_t;
 
+// ---------------- ir_rtti_relocation_t ----------------
+// A reference to the index of a type within the runtime type
+// table, which changes if the table is pruned
+// NOTE: 'index_ref' points to the value of a usize literal
+typedef struct {
+    unsigned long long *index_ref;
+} ir_rtti_relocation_t;
+
 // ---------------- ir_module_t ----------------
 // An intermediate representation module
 typedef struct {
     ir_shared_common_t common;
     ir_metadata_t metadata;
     ir_pool_t pool;
+    ir_pool_t shared_pool; // For shared types and constants, never rolled back by snapshots
     ir_type_map_t type_map;
+    ir_type_interner_t type_interner; // Pointer, fixed array, and function pointer types
     ir_func_t *funcs;
     ir_func_mapping_t *func_mappings;
     length_t funcs_length;
     ir_method_t *methods;
     length_t methods_length;
     length_t methods_capacity;
+    hash_index_t func_groups;       // First function mapping of each group by name
+    hash_index_t func_signatures;   // Function mappings by name and argument types
+    hash_index_t method_groups;     // First method of each group by struct name and name
+    hash_index_t method_signatures; // Methods by struct name, name, and argument types
+    ast_type_interner_t ast_type_interner; // Argument types of functions and methods
+    ir_management_t *managements;
+    length_t managements_length;
+    length_t managements_capacity;
+    hash_index_t managements_index; // Management records by type name
+    ir_constant_t *constants;
+    length_t constants_length;
+    length_t constants_capacity;
+    hash_index_t constants_index;   // Constants by value type, type, and bits
     ir_global_t *globals;
     length_t globals_length;
+    hash_index_t globals_index;     // Globals by name
     ir_anon_global_t *anon_globals;
     length_t anon_globals_length;
     length_t anon_globals_capacity;
+    ir_rtti_relocation_t *rtti_relocations;
+    length_t rtti_relocations_length;
+    length_t rtti_relocations_capacity;
 } ir_module_t;
 
 // ---------------- ir_value_str ----------------
@@ -503,10 +678,30 @@ typedef struct {
 // an intermediate representation value
 strong_cstr_t ir_value_str(ir_value_t *value);
 
+// ---------------- ir_value_is_constant ----------------
+// Returns whether an IR value is known at compile time
+// and can be used as the initializer of a global variable
+bool ir_value_is_constant(ir_value_t *value);
+
 // ---------------- ir_type_map_find ----------------
 // Finds a type inside an IR type map by name
 successful_t ir_type_map_find(ir_type_map_t *type_map, char *name, ir_type_t **type_ptr);
 
+// ---------------- ir_module_constant ----------------
+// Finds the shared value for a constant within a module
+// Returns a pointer to where the value is stored, which is
+// NULL if the constant hasn't been built yet
+// NOTE: The caller is responsible for filling in a missing
+//       value, which must be allocated from 'shared_pool'
+// NOTE: The returned pointer is only valid until the next call
+ir_value_t** ir_module_constant(ir_module_t *module, unsigned int value_type, ir_type_t *type, unsigned long long bits);
+
+// ---------------- ir_instr_operand ----------------
+// Gets where the 'index'th operand value of an instruction is stored
+// Returns NULL if the instruction doesn't have that many operands
+// NOTE: An operand can itself be NULL (e.g. the value of a void 'ret')
+ir_value_t **ir_instr_operand(ir_instr_t *instruction, length_t index);
+
 // ---------------- ir_basicblock_new_instructions ----------------
 // Ensures that there is enough room for 'amount' more instructions
 void ir_basicblock_new_instructions(ir_basicblock_t *block, length_t amount);
@@ -514,19 +709,22 @@ void ir_basicblock_new_instructions(ir_basicblock_t *block, length_t amount);
 // ---------------- ir_module_dump ----------------
 // Generates a string representation from an IR
 // module and writes it to a file
+// NOTE: Dumps the flat instructions of each function
 void ir_module_dump(ir_module_t *ir_module, const char *filename);
 
 // ---------------- ir_dump_functions (and friends) ----------------
 // Dumps a specific part of an IR module
 void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_length);
-void ir_dump_math_instruction(FILE *file, ir_instr_math_t *instruction, int i, const char *instruction_name);
-void ir_dump_call_instruction(FILE *file, ir_instr_call_t *instruction, int i);
-void ir_dump_call_address_instruction(FILE *file, ir_instr_call_address_t *instruction, int i);
+void ir_dump_math_instruction(FILE *file, ir_flat_func_t *flat, ir_flat_instr_t *instruction, int i, const char *instruction_name);
+void ir_dump_call_instruction(FILE *file, ir_flat_func_t *flat, ir_flat_instr_t *instruction, int i);
+void ir_dump_call_address_instruction(FILE *file, ir_flat_func_t *flat, ir_flat_instr_t *instruction, int i);
 void ir_dump_var_scope_layout(FILE *file, bridge_var_scope_t *scope);
 
 // ---------------- ir_module_free ----------------
 // Initializes an IR module for use
-void ir_module_init(ir_module_t *ir_module, length_t funcs_length, length_t globals_length);
+// NOTE: 'pool_size' is the size in bytes of the first
+//       fragment of the module's main memory pool
+void ir_module_init(ir_module_t *ir_module, length_t funcs_length, length_t globals_length, length_t pool_size);
 
 // ---------------- ir_module_free ----------------
 // Frees data within an IR module
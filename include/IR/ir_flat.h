@@ -0,0 +1,51 @@
+
+#ifndef IR_FLAT_H
+#define IR_FLAT_H
+
+/*
+    ================================ ir_flat.h =================================
+    Module for laying out the instructions of IR functions in a single
+    buffer per function, so that they can be walked from start to end
+    ----------------------------------------------------------------------------
+*/
+
+#include "IR/ir.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_flatten_module ----------------
+// Makes the flat instructions of every function within an IR module
+// NOTE: Should be done after the IR module is optimized
+void ir_flatten_module(ir_module_t *module);
+
+// ---------------- ir_flatten_func ----------------
+// Makes the flat instructions of a single IR function
+void ir_flatten_func(ir_func_t *func);
+
+// ---------------- ir_flatten_operand ----------------
+// Adds an operand value to a flat function
+// NOTE: Literal integers, booleans, and floats are stored inline
+ir_flat_operand_t ir_flatten_operand(ir_flat_func_t *flat, ir_value_t *value);
+
+// ---------------- ir_flat_operand_type ----------------
+// Gets the IR type of an operand of a flat function
+// Returns NULL for IR_FLAT_OPERAND_NONE
+ir_type_t *ir_flat_operand_type(ir_flat_func_t *flat, ir_flat_operand_t operand);
+
+// ---------------- ir_flat_operand_str ----------------
+// Generates a c-string representation from an operand
+// of a flat function (the same as 'ir_value_str')
+strong_cstr_t ir_flat_operand_str(ir_flat_func_t *flat, ir_flat_operand_t operand);
+
+// ---------------- ir_flat_block_of ----------------
+// Finds which basic block an instruction of a flat function came from
+length_t ir_flat_block_of(ir_flat_func_t *flat, length_t instruction);
+
+// ---------------- ir_flat_func_init ----------------
+// Initializes a flat function to have no instructions
+void ir_flat_func_init(ir_flat_func_t *flat);
+
+// ---------------- ir_flat_func_free ----------------
+// Frees data within a flat function
+void ir_flat_func_free(ir_flat_func_t *flat);
+
+#endif // IR_FLAT_H
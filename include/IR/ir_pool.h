@@ -4,6 +4,19 @@
 
 #include "UTIL/ground.h"
 
+// ---------------- IR_POOL_DEFAULT_FRAGMENT_SIZE ----------------
+// Size in bytes of the first fragment of an IR pool
+#define IR_POOL_DEFAULT_FRAGMENT_SIZE 512
+
+// ---------------- IR_POOL_MAX_FRAGMENT_SIZE ----------------
+// Largest size in bytes that fragments will grow to
+// NOTE: Larger allocations still get a fragment big enough for them
+#define IR_POOL_MAX_FRAGMENT_SIZE 1048576
+
+// ---------------- IR_POOL_MAX_ALIGNMENT ----------------
+// Largest alignment that allocations in an IR pool need
+#define IR_POOL_MAX_ALIGNMENT 8
+
 // ---------------- ir_pool_fragment_t ----------------
 // A memory fragment within an 'ir_pool_t'
 typedef struct {
@@ -15,10 +28,15 @@ typedef struct {
 // ---------------- ir_pool_t ----------------
 // A memory pool containing all allocated
 // IR structures for an IR module
+// NOTE: Fragments released by snapshot restores are kept
+//       in 'spare_fragments' so they can be reused
 typedef struct {
     ir_pool_fragment_t *fragments; // Blocks of memory in which small allocations stored
     length_t fragments_length;
     length_t fragments_capacity;
+    ir_pool_fragment_t *spare_fragments;
+    length_t spare_fragments_length;
+    length_t spare_fragments_capacity;
 } ir_pool_t;
 
 // ---------------- ir_pool_snapshot_t ----------------
@@ -32,14 +50,36 @@ typedef struct {
     length_t fragments_length; // Current fragment count
 } ir_pool_snapshot_t;
 
+// ---------------- ir_pool_stats_t ----------------
+// Memory usage statistics for an 'ir_pool_t'
+typedef struct {
+    length_t bytes_used;      // Bytes allocated (including alignment padding)
+    length_t bytes_reserved;  // Bytes of all fragments (including spare fragments)
+    length_t bytes_wasted;    // Bytes left unused at the end of filled fragments
+    length_t fragments;       // Number of fragments in use
+    length_t spare_fragments; // Number of fragments kept for reuse
+} ir_pool_stats_t;
+
 // ---------------- ir_pool_init ----------------
 // Initializes an IR memory pool
 void ir_pool_init(ir_pool_t *pool);
 
+// ---------------- ir_pool_init_sized ----------------
+// Initializes an IR memory pool with a first fragment of a certain size
+void ir_pool_init_sized(ir_pool_t *pool, length_t initial_size);
+
 // ---------------- ir_pool_alloc ----------------
 // Allocates memory in an IR memory pool
+// NOTE: Memory is aligned to the largest power of two that
+//       divides 'bytes' (up to IR_POOL_MAX_ALIGNMENT), which
+//       is always enough for a type of that size
 void* ir_pool_alloc(ir_pool_t *pool, length_t bytes);
 
+// ---------------- ir_pool_alloc_aligned ----------------
+// Allocates memory with a specific alignment in an IR memory pool
+// NOTE: 'alignment' must be a power of two no greater than IR_POOL_MAX_ALIGNMENT
+void* ir_pool_alloc_aligned(ir_pool_t *pool, length_t bytes, length_t alignment);
+
 // ---------------- ir_pool_free ----------------
 // Frees all memory allocated by an IR memory pool
 void ir_pool_free(ir_pool_t *pool);
@@ -52,4 +92,12 @@ void ir_pool_snapshot_capture(ir_pool_t *pool, ir_pool_snapshot_t *snapshot);
 // Restores an IR pool to a previous memory usage snapshot
 void ir_pool_snapshot_restore(ir_pool_t *pool, ir_pool_snapshot_t *snapshot);
 
+// ---------------- ir_pool_stats ----------------
+// Gathers memory usage statistics of an IR pool
+void ir_pool_stats(ir_pool_t *pool, ir_pool_stats_t *out_stats);
+
+// ---------------- ir_pool_print_stats ----------------
+// Prints memory usage statistics of an IR pool
+void ir_pool_print_stats(ir_pool_t *pool);
+
 #endif // IR_POOL_H
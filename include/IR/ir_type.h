@@ -4,6 +4,7 @@
 
 #include "UTIL/trait.h"
 #include "UTIL/ground.h"
+#include "UTIL/hash.h"
 #include "IR/ir_pool.h"
 
 // ============================================================
@@ -73,6 +74,22 @@ typedef struct {
     length_t length;
 } ir_type_extra_fixed_array_t;
 
+// ---------------- ir_type_interner_t ----------------
+// Set of IR types where each distinct type exists only once,
+// so that interned types are identical if and only if they
+// are the same pointer
+// NOTE: Types are compared by kind and by the identity of
+//       the types that they're made of
+// NOTE: Interned types live in 'pool', which must never be
+//       rolled back by a pool snapshot
+typedef struct {
+    ir_pool_t *pool;
+    ir_type_t **types;
+    length_t types_length;
+    length_t types_capacity;
+    hash_index_t index;
+} ir_type_interner_t;
+
 // ---------------- ir_type_str ----------------
 // Generates a c-string representation from
 // an intermediate representation type
@@ -82,14 +99,50 @@ strong_cstr_t ir_type_str(ir_type_t *type);
 // Returns whether two IR types are identical
 bool ir_types_identical(ir_type_t *a, ir_type_t *b);
 
+// ---------------- ir_type_interner_init ----------------
+// Initializes an empty IR type interner whose types will
+// be allocated from 'pool'
+void ir_type_interner_init(ir_type_interner_t *interner, ir_pool_t *pool);
+
+// ---------------- ir_type_interner_free ----------------
+// Frees an IR type interner
+// NOTE: The interned types themselves belong to its pool
+void ir_type_interner_free(ir_type_interner_t *interner);
+
+// ---------------- ir_type_intern_hash ----------------
+// Hashes a type for an IR type interner
+hash_t ir_type_intern_hash(ir_type_t *type);
+
+// ---------------- ir_type_intern_equals ----------------
+// Returns whether two types are the same type to an IR type interner
+// NOTE: The types that they're made of are compared by identity
+bool ir_type_intern_equals(ir_type_t *a, ir_type_t *b);
+
+// ---------------- ir_type_intern ----------------
+// Gets the interned copy of a type, copying it into the
+// interner if it hasn't been seen before
+// NOTE: Only types without 'extra' data, pointers, fixed arrays,
+//       and function pointers can be interned
+// NOTE: 'type' itself can be temporary
+ir_type_t* ir_type_intern(ir_type_interner_t *interner, ir_type_t *type);
+
 // ---------------- ir_type_pointer_to ----------------
-// Gets the type of a pointer to a type
-ir_type_t* ir_type_pointer_to(ir_pool_t *pool, ir_type_t *base);
+// Gets the interned type of a pointer to a type
+ir_type_t* ir_type_pointer_to(ir_type_interner_t *interner, ir_type_t *base);
+
+// ---------------- ir_type_fixed_array_of ----------------
+// Gets the interned type of a fixed array of a type
+ir_type_t* ir_type_fixed_array_of(ir_type_interner_t *interner, ir_type_t *subtype, length_t length);
 
 // ---------------- ir_type_dereference ----------------
 // Gets the type pointed to by a pointer type
 ir_type_t* ir_type_dereference(ir_type_t *type);
 
+// ---------------- ir_type_is_integer ----------------
+// Returns whether an IR type is an integer type
+// NOTE: Booleans and pointers aren't considered integers
+bool ir_type_is_integer(ir_type_t *type);
+
 // ---------------- global_type_kind_sizes_64 ----------------
 // Contains the general sizes of each TYPE_KIND_*
 // (For 64 bit systems only)
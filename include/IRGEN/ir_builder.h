@@ -42,6 +42,7 @@ typedef struct {
     length_t next_var_id;
     length_t *next_reference_id;
     troolean has_string_struct;
+    source_t source; // Source that new instructions are attributed to
 } ir_builder_t;
 
 // ---------------- build_basicblock ----------------
@@ -56,12 +57,20 @@ void build_using_basicblock(ir_builder_t *builder, length_t basicblock_id);
 
 // ---------------- build_instruction ----------------
 // Builds a new undetermined instruction
+// NOTE: The instruction is attributed to 'builder->source'
 ir_instr_t *build_instruction(ir_builder_t *builder, length_t size);
 
 // ---------------- build_value_from_prev_instruction ----------------
 // Builds an IR value from the result of the previsous instruction
 ir_value_t *build_value_from_prev_instruction(ir_builder_t *builder);
 
+// ---------------- build_value_with_extra ----------------
+// Builds an IR value whose 'extra' payload of 'extra_size' bytes
+// is allocated directly after it, so that reading a literal or
+// instruction result doesn't have to follow a second allocation
+// NOTE: The payload is left uninitialized
+ir_value_t *build_value_with_extra(ir_pool_t *pool, unsigned int value_type, ir_type_t *type, length_t extra_size);
+
 // ---------------- build_varptr ----------------
 // Builds a varptr instruction
 ir_value_t* build_varptr(ir_builder_t *builder, ir_type_t *ptr_type, length_t variable_id);
@@ -92,7 +101,7 @@ ir_value_t *build_struct_construction(ir_pool_t *pool, ir_type_t *type, ir_value
 
 // ---------------- build_static_array ----------------
 // Builds a static array
-ir_value_t *build_static_array(ir_pool_t *pool, ir_type_t *type, ir_value_t **values, length_t length);
+ir_value_t *build_static_array(ir_module_t *module, ir_type_t *type, ir_value_t **values, length_t length);
 
 // ---------------- build_anon_global ----------------
 // Builds an anonymous global variable
@@ -114,17 +123,37 @@ ir_type_t* ir_builder_usize(ir_builder_t *builder);
 // Gets a shared IR usize pointer type
 ir_type_t* ir_builder_usize_ptr(ir_builder_t *builder);
 
+// ---------------- ir_builder_ptrdiff ----------------
+// Gets a shared IR type for the difference between pointers
+ir_type_t* ir_builder_ptrdiff(ir_builder_t *builder);
+
 // ---------------- ir_builder_bool ----------------
 // Gets a shared IR boolean type
 ir_type_t* ir_builder_bool(ir_builder_t *builder);
 
+// ---------------- ir_builder_int ----------------
+// Gets a shared IR int type
+ir_type_t* ir_builder_int(ir_builder_t *builder);
+
+// ---------------- ir_builder_constant ----------------
+// Finds the shared value for a constant within the module
+// being built (see 'ir_module_constant')
+ir_value_t** ir_builder_constant(ir_builder_t *builder, unsigned int value_type, ir_type_t *type, unsigned long long bits);
+
 // ---------------- build_literal_int ----------------
 // Builds a literal int value
-ir_value_t* build_literal_int(ir_pool_t *pool, long long value);
+// NOTE: Identical literals are shared, so they must not be modified
+ir_value_t* build_literal_int(ir_builder_t *builder, long long value);
 
 // ---------------- build_literal_usize ----------------
 // Builds a literal usize value
-ir_value_t* build_literal_usize(ir_pool_t *pool, length_t value);
+// NOTE: Identical literals are shared, so they must not be modified
+ir_value_t* build_literal_usize(ir_builder_t *builder, length_t value);
+
+// ---------------- build_offsetof_value ----------------
+// Builds a constant usize value of the offset of
+// a member within a structure
+ir_value_t* build_offsetof_value(ir_pool_t *pool, ir_type_t *type, length_t index);
 
 // ---------------- build_literal_str ----------------
 // Builds a literal string value
@@ -141,11 +170,13 @@ ir_value_t* build_literal_cstr_of_length(ir_builder_t *builder, weak_cstr_t valu
 
 // ---------------- build_null_pointer ----------------
 // Builds a literal null pointer value
-ir_value_t* build_null_pointer(ir_pool_t *pool);
+// NOTE: The value is shared, so it must not be modified
+ir_value_t* build_null_pointer(ir_builder_t *builder);
 
 // ---------------- build_null_pointer_of_type ----------------
 // Builds a literal null pointer value
-ir_value_t* build_null_pointer_of_type(ir_pool_t *pool, ir_type_t *type);
+// NOTE: Null pointers of the same type are shared, so they must not be modified
+ir_value_t* build_null_pointer_of_type(ir_builder_t *builder, ir_type_t *type);
 
 // ---------------- build_bitcast ----------------
 // Builds a bitcast instruction
@@ -172,9 +203,18 @@ ir_value_t* build_sitofp(ir_builder_t *builder, ir_value_t *from, ir_type_t *to)
 // Bulids a basic math instruction
 ir_value_t *build_math(ir_builder_t *builder, unsigned int instr_id, ir_value_t *a, ir_value_t *b, ir_type_t *result);
 
+// ---------------- build_pointer_math ----------------
+// Builds pointer arithmetic for an add or subtract instruction
+// if the operands are a pointer and an integer (in either order
+// for add), or two pointers of the same type (for subtract)
+// The pointer operand will always be the first operand
+// Returns NULL if the operands aren't used for pointer arithmetic
+ir_value_t *build_pointer_math(ir_builder_t *builder, unsigned int instr_id, ir_value_t *a, ir_value_t *b);
+
 // ---------------- build_bool ----------------
 // Builds a literal boolean value
-ir_value_t *build_bool(ir_pool_t *pool, bool value);
+// NOTE: Identical literals are shared, so they must not be modified
+ir_value_t *build_bool(ir_builder_t *builder, bool value);
 
 // ---------------- prepare_for_new_label ----------------
 // Ensures there's enough room for another label
@@ -33,10 +33,18 @@ errorcode_t ir_gen_globals(compiler_t *compiler, object_t *object);
 
 // ---------------- ir_gen_globals_init ----------------
 // Generates IR instructions for initializing global variables
+// NOTE: Globals with initial values known at compile time are
+//       given static initializers instead
 errorcode_t ir_gen_globals_init(ir_builder_t *builder);
 
+// ---------------- ir_gen_special_globals ----------------
+// Finishes the runtime type table and generates the
+// static initializers of all special global variables
+// NOTE: Must be called after all function bodies are generated
+errorcode_t ir_gen_special_globals(compiler_t *compiler, object_t *object);
+
 // ---------------- ir_gen_special_global ----------------
-// Generates IR instructions for initializing special global variables
+// Generates the static initializer of a special global variable
 errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_global, length_t global_variable_id);
 
 // ---------------- ir_func_mapping_cmp ----------------
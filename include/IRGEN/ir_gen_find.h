@@ -23,6 +23,55 @@ typedef struct {
     length_t func_id;
 } funcpair_t;
 
+// ---------------- ir_gen_find_index ----------------
+// Builds the indices used to find functions and methods
+// by name and by signature within an IR module
+// NOTE: Must be called once the function mappings and
+//       methods of the IR module have been sorted
+void ir_gen_find_index(ir_module_t *module);
+
+// ---------------- ir_gen_find_intern_arg_types ----------------
+// Interns the argument types of a function, so that they can
+// be compared by pointer
+// NOTE: The returned array is owned by the caller
+const ast_type_t **ir_gen_find_intern_arg_types(ir_module_t *module, ast_func_t *func);
+
+// ---------------- ir_gen_find_interned_types ----------------
+// Finds the interned copies of a list of AST types
+// Returns false if some of them haven't been interned
+// NOTE: Types that haven't been interned are NULL in 'out_interned'
+bool ir_gen_find_interned_types(ir_module_t *module, ast_type_t *types, length_t length, const ast_type_t **out_interned);
+
+// ---------------- func_signature_hash ----------------
+// Hashes the name of a function (or method) along with
+// its interned argument types
+hash_t func_signature_hash(hash_t name_hash, const ast_type_t **arg_types, length_t arity);
+
+// ---------------- ir_gen_find_func_group ----------------
+// Finds the first function mapping of the group of functions with a name
+// Returns -1 if there are no functions with that name
+maybe_index_t ir_gen_find_func_group(ir_module_t *ir_module, const char *name);
+
+// ---------------- ir_gen_find_func_exact ----------------
+// Finds the non-variadic function mapping that exactly matches
+// a name and argument types. Returns -1 if there isn't one
+maybe_index_t ir_gen_find_func_exact(ir_module_t *ir_module, const char *name, ast_type_t *arg_types, length_t arg_types_length);
+
+// ---------------- ir_gen_find_func_interned ----------------
+// Same as 'ir_gen_find_func_exact', except with interned argument types
+maybe_index_t ir_gen_find_func_interned(ir_module_t *ir_module, const char *name, const ast_type_t **arg_types, length_t arg_types_length);
+
+// ---------------- ir_gen_find_method_group ----------------
+// Finds the first method of the group of methods with a name for a struct
+// Returns -1 if there are no methods with that name
+maybe_index_t ir_gen_find_method_group(ir_module_t *ir_module, const char *struct_name, const char *name);
+
+// ---------------- ir_gen_find_method_exact ----------------
+// Finds the non-variadic method that exactly matches a struct name,
+// name, and argument types. Returns -1 if there isn't one
+maybe_index_t ir_gen_find_method_exact(ir_module_t *ir_module, const char *struct_name, const char *name,
+    ast_type_t *arg_types, length_t arg_types_length);
+
 // ---------------- ir_gen_find_func ----------------
 // Finds a function that exactly matches the given
 // name and arguments. Result info stored 'result'
@@ -38,29 +87,36 @@ errorcode_t ir_gen_find_func_named(compiler_t *compiler, object_t *object,
 // ---------------- ir_gen_find_func_conforming ----------------
 // Finds a function that has the given name and conforms.
 // to the arguments given. Result info stored 'result'
+// NOTE: A function whose arguments match exactly is preferred
 errorcode_t ir_gen_find_func_conforming(ir_builder_t *builder, const char *name, ir_value_t **arg_values,
         ast_type_t *arg_types, length_t type_list_length, funcpair_t *result);
 
 // ---------------- ir_gen_find_method_conforming ----------------
 // Finds a method that has the given name and conforms.
 // to the arguments given. Result info stored 'result'
+// NOTE: A method whose arguments match exactly is preferred
 errorcode_t ir_gen_find_method_conforming(ir_builder_t *builder, const char *struct_name,
     const char *name, ir_value_t **arg_values, ast_type_t *arg_types,
     length_t type_list_length, funcpair_t *result);
 
-// ---------------- find_beginning_of_func_group ----------------
-// Searches for beginning of function group in a list of mappings
-maybe_index_t find_beginning_of_func_group(ir_func_mapping_t *mappings, length_t length, const char *name);
+// ---------------- ir_gen_find_global ----------------
+// Finds a global variable by name
+// Returns -1 if no global variable has that name
+// NOTE: The index is the same for the AST global and the IR global
+maybe_index_t ir_gen_find_global(ir_module_t *ir_module, const char *name);
 
-// ---------------- find_beginning_of_method_group ----------------
-// Searches for beginning of method group in a list of methods
-maybe_index_t find_beginning_of_method_group(ir_method_t *methods, length_t length,
-    const char *struct_name, const char *name);
+// ---------------- ir_gen_find_management ----------------
+// Finds which management functions a type (by base name) has
+// NOTE: The result is remembered, so later lookups for the same type are cheap
+// NOTE: The returned pointer is only valid until the next call
+ir_management_t *ir_gen_find_management(ir_module_t *ir_module, weak_cstr_t type_name);
 
 // ---------------- func_args_match ----------------
 // Returns whether a function's arguments match
 // the arguments supplied.
-successful_t func_args_match(ast_func_t *func, ast_type_t *type_list, length_t type_list_length);
+// NOTE: Both 'arg_types' (the function's) and 'type_list'
+//       must be interned types
+successful_t func_args_match(ast_func_t *func, const ast_type_t **arg_types, const ast_type_t **type_list, length_t type_list_length);
 
 // ---------------- func_args_conform ----------------
 // Returns whether a function's arguments conform
@@ -0,0 +1,169 @@
+
+#ifndef IR_OPTIMIZE_H
+#define IR_OPTIMIZE_H
+
+/*
+    =============================== ir_optimize.h ==============================
+    Module for simplifying intermediate representation before it's
+    lowered, so that the backend has less of it to deal with
+    ---------------------------------------------------------------------------
+*/
+
+#include "IR/ir.h"
+#include "UTIL/hash.h"
+#include "UTIL/ground.h"
+
+// ---------------- ir_optimizer_block_t ----------------
+// What the optimizer knows about each instruction in a basic block
+// 'replacements' -> value that replaces the result of an instruction (or NULL)
+// 'results' -> value for the result of an instruction (or NULL if not made yet)
+// 'uses' -> how many kept instructions use the result of an instruction
+// 'new_ids' -> where each kept instruction ends up once the block is compacted
+typedef struct {
+    ir_value_t **replacements;
+    ir_value_t **results;
+    length_t *uses;
+    length_t *new_ids;
+    bool reachable;
+    length_t new_id;
+} ir_optimizer_block_t;
+
+// ---------------- ir_optimizer_variable_t ----------------
+// What the optimizer knows about a stack variable at the
+// current point within a basic block
+// 'value' -> value that the variable is known to hold (or NULL)
+// 'pointer' -> value of the first 'varptr' to the variable (or NULL)
+// 'touched' -> whether the variable is in the optimizer's 'touched' list
+typedef struct {
+    ir_value_t *value;
+    ir_value_t *pointer;
+    bool touched;
+} ir_optimizer_variable_t;
+
+// ---------------- ir_optimizer_t ----------------
+// State for optimizing a single IR function
+// NOTE: 'touched' lists the variables that have a known value or pointer,
+//       so that they can be forgotten without visiting every variable
+// NOTE: 'renumbered' lists the instruction results that have already
+//       been renumbered during compaction
+typedef struct {
+    ir_module_t *module;
+    ir_func_t *func;
+    ir_optimizer_block_t *blocks;
+    ir_optimizer_variable_t *variables;
+    length_t *touched;
+    length_t touched_length;
+    ir_value_result_t **renumbered;
+    length_t renumbered_length;
+    length_t renumbered_capacity;
+    hash_index_t renumbered_index;
+} ir_optimizer_t;
+
+// ---------------- ir_optimize_module ----------------
+// Optimizes every function within an IR module
+// NOTE: Performs constant folding, copy propagation, forwarding of
+//       stack variable loads, dead code elimination, and removal
+//       of unreachable basic blocks
+void ir_optimize_module(ir_module_t *module);
+
+// ---------------- ir_optimize_func ----------------
+// Optimizes a single IR function
+void ir_optimize_func(ir_module_t *module, ir_func_t *func);
+
+// ---------------- ir_optimize_block ----------------
+// Simplifies the instructions of a basic block from start to end
+// NOTE: Replaced instructions are set to NULL
+void ir_optimize_block(ir_optimizer_t *optimizer, length_t block_id);
+
+// ---------------- ir_optimize_resolve ----------------
+// Gets the value that should be used in place of another
+// value, following any replaced instruction results
+ir_value_t *ir_optimize_resolve(ir_optimizer_t *optimizer, ir_value_t *value);
+
+// ---------------- ir_optimize_resolve_operands ----------------
+// Resolves every operand of an instruction in place
+void ir_optimize_resolve_operands(ir_optimizer_t *optimizer, ir_instr_t *instruction);
+
+// ---------------- ir_optimize_result ----------------
+// Gets a value for the result of an instruction
+ir_value_t *ir_optimize_result(ir_optimizer_t *optimizer, length_t block_id, length_t instruction_id);
+
+// ---------------- ir_optimize_variable_of ----------------
+// Returns the stack variable that a pointer value directly
+// points to, or -1 if it isn't the result of a 'varptr'
+maybe_index_t ir_optimize_variable_of(ir_optimizer_t *optimizer, ir_value_t *pointer);
+
+// ---------------- ir_optimize_touch ----------------
+// Records that a stack variable is about to be given
+// a known value or pointer
+void ir_optimize_touch(ir_optimizer_t *optimizer, length_t variable);
+
+// ---------------- ir_optimize_forget ----------------
+// Forgets known stack variable values (and optionally pointers)
+void ir_optimize_forget(ir_optimizer_t *optimizer, bool forget_pointers);
+
+// ---------------- ir_optimize_fold ----------------
+// Computes the result of an instruction at compile time
+// Returns NULL if the result can't be computed
+ir_value_t *ir_optimize_fold(ir_module_t *module, ir_instr_t *instruction);
+
+// ---------------- ir_optimize_literal_bits ----------------
+// Gets the bits of an integer or boolean literal, sign
+// extended if the literal is signed
+// Returns false if the value isn't an integer or boolean literal
+bool ir_optimize_literal_bits(ir_value_t *value, unsigned long long *out_bits);
+
+// ---------------- ir_optimize_normalize ----------------
+// Truncates bits to the width of an integer type kind,
+// and then sign extends them if the type kind is signed
+unsigned long long ir_optimize_normalize(unsigned int type_kind, unsigned long long bits);
+
+// ---------------- ir_optimize_literal ----------------
+// Gets a shared integer or boolean literal value
+// NOTE: 'bits' must already be normalized for the type
+ir_value_t *ir_optimize_literal(ir_module_t *module, ir_type_t *type, unsigned long long bits);
+
+// ---------------- ir_optimize_find_reachable ----------------
+// Marks which basic blocks can be reached from the entry block
+void ir_optimize_find_reachable(ir_optimizer_t *optimizer);
+
+// ---------------- ir_optimize_use ----------------
+// Adds to (or subtracts from) the use counts of the
+// instruction results that a value refers to
+void ir_optimize_use(ir_optimizer_t *optimizer, ir_value_t *value, bool is_use);
+
+// ---------------- ir_optimize_remove_dead ----------------
+// Removes instructions that have no effects and whose
+// results are never used
+void ir_optimize_remove_dead(ir_optimizer_t *optimizer);
+
+// ---------------- ir_optimize_compact ----------------
+// Removes unreachable basic blocks and replaced instructions,
+// and then renumbers the references to what remains
+void ir_optimize_compact(ir_optimizer_t *optimizer);
+
+// ---------------- ir_optimize_renumber ----------------
+// Renumbers the instruction results that a value refers to
+// NOTE: The same result data can be shared between values,
+//       so each one is only renumbered the first time
+void ir_optimize_renumber(ir_optimizer_t *optimizer, ir_value_t *value);
+
+// ---------------- ir_optimize_types_equal ----------------
+// Returns whether a value of one IR type can be used in place
+// of a value of another without changing anything
+// NOTE: Unlike 'ir_types_identical', this compares the details
+//       of function pointer and fixed array types, and only
+//       considers composite types equal to themselves
+bool ir_optimize_types_equal(ir_type_t *a, ir_type_t *b);
+
+// ---------------- ir_instr_is_pure ----------------
+// Returns whether an instruction can be removed
+// when its result isn't used
+bool ir_instr_is_pure(unsigned int id);
+
+// ---------------- ir_instr_preserves_variables ----------------
+// Returns whether an instruction can't change the
+// values held by any stack variables
+bool ir_instr_preserves_variables(unsigned int id);
+
+#endif // IR_OPTIMIZE_H
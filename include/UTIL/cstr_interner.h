@@ -0,0 +1,49 @@
+
+#ifndef CSTR_INTERNER_H
+#define CSTR_INTERNER_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ============================= cstr_interner.h =============================
+    Module for keeping a single shared copy of each distinct c-string
+    ---------------------------------------------------------------------------
+*/
+
+#include "UTIL/hash.h"
+#include "UTIL/ground.h"
+
+// ---------------- cstr_interner_t ----------------
+// Set of c-strings where each distinct string exists only once,
+// so that interned strings are equal if and only if they are
+// the same pointer
+// NOTE: Interned strings are owned by the interner, and
+//       must never be modified or freed by anything else
+typedef struct {
+    strong_cstr_t *cstrs;
+    length_t cstrs_length;
+    length_t cstrs_capacity;
+    hash_index_t index;
+} cstr_interner_t;
+
+// ---------------- cstr_interner_init ----------------
+// Initializes an empty c-string interner
+void cstr_interner_init(cstr_interner_t *interner);
+
+// ---------------- cstr_interner_free ----------------
+// Frees a c-string interner along with its interned strings
+void cstr_interner_free(cstr_interner_t *interner);
+
+// ---------------- cstr_intern ----------------
+// Gets the interned copy of a string of characters,
+// copying it into the interner if it hasn't been seen before
+// NOTE: 'cstr' doesn't have to be null-terminated
+weak_cstr_t cstr_intern(cstr_interner_t *interner, const char *cstr, length_t length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // CSTR_INTERNER_H
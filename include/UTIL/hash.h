@@ -0,0 +1,90 @@
+
+#ifndef HASH_H
+#define HASH_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+    ================================== hash.h ==================================
+    Module for hashing data (64-bit FNV-1a)
+    ----------------------------------------------------------------------------
+*/
+
+#include "UTIL/ground.h"
+
+// ---------------- hash_t ----------------
+// A 64-bit hash value
+typedef unsigned long long hash_t;
+
+// ---------------- HASH_SEED ----------------
+// Hash of no data, used to begin hashing piece by piece
+#define HASH_SEED 0xCBF29CE484222325ULL
+
+// ---------------- hash_data ----------------
+// Hashes a block of data
+hash_t hash_data(const void *data, length_t size);
+
+// ---------------- hash_cstr ----------------
+// Hashes a null-terminated string (not including the null terminator)
+hash_t hash_cstr(const char *cstr);
+
+// ---------------- hash_continue ----------------
+// Continues a hash with more data
+// NOTE: Hashing pieces of data one after another gives the same
+//       result as hashing all of them at once
+hash_t hash_continue(hash_t hash, const void *data, length_t size);
+
+// ---------------- hash_combine ----------------
+// Combines two hash values into one
+hash_t hash_combine(hash_t a, hash_t b);
+
+// ---------------- hash_index_slot_t ----------------
+// A single slot of a 'hash_index_t'
+// NOTE: 'item' is the index of the item plus one (or zero if empty)
+typedef struct {
+    hash_t hash;
+    length_t item;
+} hash_index_slot_t;
+
+// ---------------- hash_index_t ----------------
+// Hash table that maps hashes to the indices of items
+// that are stored elsewhere (in an ordinary array)
+// NOTE: Different items may have the same hash, so callers
+//       must compare each candidate against what they're looking for
+// NOTE: 'capacity' is always zero or a power of two
+typedef struct {
+    hash_index_slot_t *slots;
+    length_t length;
+    length_t capacity;
+} hash_index_t;
+
+// ---------------- hash_index_init ----------------
+// Initializes an empty hash index
+void hash_index_init(hash_index_t *index);
+
+// ---------------- hash_index_free ----------------
+// Frees a hash index
+void hash_index_free(hash_index_t *index);
+
+// ---------------- hash_index_insert ----------------
+// Adds an item index to a hash index
+void hash_index_insert(hash_index_t *index, hash_t hash, length_t item);
+
+// ---------------- hash_index_find ----------------
+// Finds the first candidate item index for a hash
+// Returns -1 if there are no candidates
+// NOTE: 'cursor' is used to continue with 'hash_index_find_next'
+maybe_index_t hash_index_find(hash_index_t *index, hash_t hash, length_t *cursor);
+
+// ---------------- hash_index_find_next ----------------
+// Finds the next candidate item index for a hash
+// Returns -1 if there are no more candidates
+maybe_index_t hash_index_find_next(hash_index_t *index, hash_t hash, length_t *cursor);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // HASH_H
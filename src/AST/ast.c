@@ -9,6 +9,7 @@ void ast_init(ast_t *ast){
     ast->structs = malloc(sizeof(ast_struct_t) * 4);
     ast->structs_length = 0;
     ast->structs_capacity = 4;
+    hash_index_init(&ast->structs_index);
     ast->aliases = malloc(sizeof(ast_alias_t) * 8);
     ast->aliases_length = 0;
     ast->aliases_capacity = 8;
@@ -57,6 +58,7 @@ void ast_free(ast_t *ast){
     ast_free_enums(ast->enums, ast->enums_length);
     ast_free_functions(ast->funcs, ast->funcs_length);
     ast_free_structs(ast->structs, ast->structs_length);
+    hash_index_free(&ast->structs_index);
     ast_free_globals(ast->globals, ast->globals_length);
     ast_free_constants(ast->constants, ast->constants_length);
 
@@ -514,8 +516,10 @@ void ast_enum_init(ast_enum_t *inum,  weak_cstr_t name, weak_cstr_t *kinds, leng
 }
 
 ast_struct_t *ast_struct_find(ast_t *ast, const char *name){
-    // TODO: Maybe sort and do a binary serach or something
-    for(length_t i = 0; i != ast->structs_length; i++){
+    hash_t hash = hash_cstr(name);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&ast->structs_index, hash, &cursor); i != -1; i = hash_index_find_next(&ast->structs_index, hash, &cursor)){
         if(strcmp(ast->structs[i].name, name) == 0){
             return &ast->structs[i];
         }
@@ -605,6 +609,8 @@ void ast_add_enum(ast_t *ast, weak_cstr_t name, weak_cstr_t *kinds, length_t len
 void ast_add_struct(ast_t *ast, strong_cstr_t name, strong_cstr_t *names, ast_type_t *types,
         length_t length, trait_t traits, source_t source){
     expand((void**) &ast->structs, sizeof(ast_struct_t), ast->structs_length, &ast->structs_capacity, 1, 4);
+    hash_index_insert(&ast->structs_index, hash_cstr(name), ast->structs_length);
+
     ast_struct_t *structure = &ast->structs[ast->structs_length++];
     ast_struct_init(structure, name, names, types, length, traits, source);
 }
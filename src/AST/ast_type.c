@@ -1,6 +1,7 @@
 
 #include "AST/ast.h"
 #include "AST/ast_type.h"
+#include "UTIL/util.h"
 #include "UTIL/color.h"
 
 ast_type_t ast_type_clone(const ast_type_t *original){
@@ -317,6 +318,164 @@ strong_cstr_t ast_type_str(const ast_type_t *type){
     return name;
 }
 
+hash_t ast_type_str_hash(const ast_type_t *type, hash_t hash){
+    // NOTE: Must hash the same characters as 'ast_type_str' generates
+
+    for(length_t i = 0; i != type->elements_length; i++){
+        switch(type->elements[i]->id){
+        case AST_ELEM_BASE: {
+                const char *base = ((ast_elem_base_t*) type->elements[i])->base;
+                hash = hash_continue(hash, base, strlen(base));
+            }
+            break;
+        case AST_ELEM_POINTER:
+            hash = hash_continue(hash, "*", 1);
+            break;
+        case AST_ELEM_ARRAY:
+            break;
+        case AST_ELEM_FIXED_ARRAY: {
+                char fixed_array_length_buffer[32];
+                sprintf(fixed_array_length_buffer, "%d ", (int) ((ast_elem_fixed_array_t*) type->elements[i])->length);
+                hash = hash_continue(hash, fixed_array_length_buffer, strlen(fixed_array_length_buffer));
+            }
+            break;
+        case AST_ELEM_GENERIC_INT:
+            hash = hash_continue(hash, "int", 3); // Collapse to 'int'
+            break;
+        case AST_ELEM_GENERIC_FLOAT:
+            hash = hash_continue(hash, "double", 6); // Collapse to 'double'
+            break;
+        case AST_ELEM_FUNC: {
+                ast_elem_func_t *func_elem = (ast_elem_func_t*) type->elements[i];
+                if(func_elem->traits & AST_FUNC_STDCALL) hash = hash_continue(hash, "stdcall ", 8);
+                hash = hash_continue(hash, "func(", 5);
+
+                for(length_t a = 0; a != func_elem->arity; a++){
+                    hash = ast_type_str_hash(&func_elem->arg_types[a], hash);
+
+                    if(a != func_elem->arity - 1){
+                        hash = hash_continue(hash, ", ", 2);
+                    } else if(func_elem->traits & AST_FUNC_VARARG){
+                        hash = hash_continue(hash, ", ...", 5);
+                    }
+                }
+
+                hash = hash_continue(hash, ") ", 2);
+                hash = ast_type_str_hash(func_elem->return_type, hash);
+            }
+            break;
+        }
+    }
+
+    return hash;
+}
+
+const char *ast_type_str_match(const ast_type_t *type, const char *str){
+    // NOTE: Must match the same characters as 'ast_type_str' generates
+
+    #define MATCH_MACRO(piece, piece_length) { \
+        if(strncmp(str, piece, piece_length) != 0) return NULL; \
+        str += piece_length; \
+    }
+
+    for(length_t i = 0; i != type->elements_length; i++){
+        switch(type->elements[i]->id){
+        case AST_ELEM_BASE: {
+                const char *base = ((ast_elem_base_t*) type->elements[i])->base;
+                MATCH_MACRO(base, strlen(base));
+            }
+            break;
+        case AST_ELEM_POINTER:
+            MATCH_MACRO("*", 1);
+            break;
+        case AST_ELEM_ARRAY:
+            break;
+        case AST_ELEM_FIXED_ARRAY: {
+                char fixed_array_length_buffer[32];
+                sprintf(fixed_array_length_buffer, "%d ", (int) ((ast_elem_fixed_array_t*) type->elements[i])->length);
+                MATCH_MACRO(fixed_array_length_buffer, strlen(fixed_array_length_buffer));
+            }
+            break;
+        case AST_ELEM_GENERIC_INT:
+            MATCH_MACRO("int", 3); // Collapse to 'int'
+            break;
+        case AST_ELEM_GENERIC_FLOAT:
+            MATCH_MACRO("double", 6); // Collapse to 'double'
+            break;
+        case AST_ELEM_FUNC: {
+                ast_elem_func_t *func_elem = (ast_elem_func_t*) type->elements[i];
+                if(func_elem->traits & AST_FUNC_STDCALL) MATCH_MACRO("stdcall ", 8);
+                MATCH_MACRO("func(", 5);
+
+                for(length_t a = 0; a != func_elem->arity; a++){
+                    str = ast_type_str_match(&func_elem->arg_types[a], str);
+                    if(str == NULL) return NULL;
+
+                    if(a != func_elem->arity - 1){
+                        MATCH_MACRO(", ", 2);
+                    } else if(func_elem->traits & AST_FUNC_VARARG){
+                        MATCH_MACRO(", ...", 5);
+                    }
+                }
+
+                MATCH_MACRO(") ", 2);
+                str = ast_type_str_match(func_elem->return_type, str);
+                if(str == NULL) return NULL;
+            }
+            break;
+        default:
+            return NULL;
+        }
+    }
+
+    #undef MATCH_MACRO
+    return str;
+}
+
+bool ast_type_str_equals(const ast_type_t *type, const char *str){
+    const char *rest = ast_type_str_match(type, str);
+    return rest != NULL && *rest == '\0';
+}
+
+hash_t ast_type_hash(const ast_type_t *type, hash_t hash){
+    hash = hash_combine(hash, type->elements_length);
+
+    for(length_t i = 0; i != type->elements_length; i++){
+        unsigned int id = type->elements[i]->id;
+        hash = hash_combine(hash, id);
+
+        switch(id){
+        case AST_ELEM_BASE: {
+                const char *base = ((ast_elem_base_t*) type->elements[i])->base;
+
+                // 'ast_types_identical' treats these names as the same
+                if(strcmp(base, "usize") == 0) base = "ulong";
+                else if(strcmp(base, "successful") == 0) base = "bool";
+
+                hash = hash_combine(hash, hash_cstr(base));
+            }
+            break;
+        case AST_ELEM_FIXED_ARRAY:
+            hash = hash_combine(hash, ((ast_elem_fixed_array_t*) type->elements[i])->length);
+            break;
+        case AST_ELEM_FUNC: {
+                ast_elem_func_t *func_elem = (ast_elem_func_t*) type->elements[i];
+                hash = hash_combine(hash, func_elem->traits & (AST_FUNC_VARARG | AST_FUNC_STDCALL));
+                hash = hash_combine(hash, func_elem->arity);
+                hash = ast_type_hash(func_elem->return_type, hash);
+
+                for(length_t a = 0; a != func_elem->arity; a++){
+                    hash = ast_type_hash(&func_elem->arg_types[a], hash);
+                    hash = hash_combine(hash, func_elem->arg_flows[a]);
+                }
+            }
+            break;
+        }
+    }
+
+    return hash;
+}
+
 bool ast_types_identical(const ast_type_t *a, const ast_type_t *b){
     // NOTE: Returns true if the two types are identical
     // NOTE: The two types must be exactly the same to be considered identical (Exception is 'ulong' and 'usize')
@@ -325,29 +484,35 @@ bool ast_types_identical(const ast_type_t *a, const ast_type_t *b){
     // [pointer] [base "ubyte"]    [pointer] [base: "ubyte"]  -> true
 
     if(a->elements_length != b->elements_length) return false;
+    if(a->elements == b->elements) return true;
 
     for(length_t i = 0; i != a->elements_length; i++){
+        if(a->elements[i] == b->elements[i]) continue;
         unsigned int id = a->elements[i]->id;
 
         if(id != b->elements[i]->id) return false;
 
         // Do more specific checking if needed
         switch(id){
-        case AST_ELEM_BASE:
-            if(strcmp(((ast_elem_base_t*) a->elements[i])->base, "usize") == 0 || strcmp(((ast_elem_base_t*) a->elements[i])->base, "ulong") == 0){
+        case AST_ELEM_BASE: {
+                const char *a_base = ((ast_elem_base_t*) a->elements[i])->base;
+                const char *b_base = ((ast_elem_base_t*) b->elements[i])->base;
+
+                // Only compare against the special cases below when the names are different
+                if(a_base == b_base || strcmp(a_base, b_base) == 0) break;
+
                 // Cheap little hack to get 'usize' to be treated the same as 'ulong'
                 // TODO: Create special function func non-identical comparison, or modify the name of this function
-                if(strcmp(((ast_elem_base_t*) b->elements[i])->base, "usize") == 0 || strcmp(((ast_elem_base_t*) b->elements[i])->base, "ulong") == 0)
-                    break;
-            }
-            if(strcmp(((ast_elem_base_t*) a->elements[i])->base, "successful") == 0 || strcmp(((ast_elem_base_t*) a->elements[i])->base, "bool") == 0){
+                if((strcmp(a_base, "usize") == 0 || strcmp(a_base, "ulong") == 0)
+                && (strcmp(b_base, "usize") == 0 || strcmp(b_base, "ulong") == 0)) break;
+
                 // Cheap little hack to get 'successful' to be treated the same as 'bool'
                 // TODO: Create special function func non-identical comparison, or modify the name of this function
-                if(strcmp(((ast_elem_base_t*) b->elements[i])->base, "successful") == 0 || strcmp(((ast_elem_base_t*) b->elements[i])->base, "bool") == 0)
-                    break;
+                if((strcmp(a_base, "successful") == 0 || strcmp(a_base, "bool") == 0)
+                && (strcmp(b_base, "successful") == 0 || strcmp(b_base, "bool") == 0)) break;
+
+                return false;
             }
-            if(strcmp(((ast_elem_base_t*) a->elements[i])->base, ((ast_elem_base_t*) b->elements[i])->base) != 0) return false;
-            break;
         case AST_ELEM_FIXED_ARRAY:
             if(((ast_elem_fixed_array_t*) a->elements[i])->length != ((ast_elem_fixed_array_t*) b->elements[i])->length) return false;
             break;
@@ -371,6 +536,50 @@ bool ast_types_identical(const ast_type_t *a, const ast_type_t *b){
     return true;
 }
 
+void ast_type_interner_init(ast_type_interner_t *interner){
+    interner->types = NULL;
+    interner->types_length = 0;
+    interner->types_capacity = 0;
+    hash_index_init(&interner->index);
+}
+
+void ast_type_interner_free(ast_type_interner_t *interner){
+    for(length_t i = 0; i != interner->types_length; i++){
+        ast_type_free_fully(interner->types[i]);
+    }
+
+    free(interner->types);
+    hash_index_free(&interner->index);
+}
+
+const ast_type_t *ast_type_intern(ast_type_interner_t *interner, const ast_type_t *type){
+    hash_t hash = ast_type_hash(type, HASH_SEED);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&interner->index, hash, &cursor); i != -1; i = hash_index_find_next(&interner->index, hash, &cursor)){
+        if(ast_types_identical(interner->types[i], type)) return interner->types[i];
+    }
+
+    ast_type_t *interned = malloc(sizeof(ast_type_t));
+    *interned = ast_type_clone(type);
+
+    expand((void**) &interner->types, sizeof(ast_type_t*), interner->types_length, &interner->types_capacity, 1, 64);
+    hash_index_insert(&interner->index, hash, interner->types_length);
+    interner->types[interner->types_length++] = interned;
+    return interned;
+}
+
+const ast_type_t *ast_type_intern_find(ast_type_interner_t *interner, const ast_type_t *type){
+    hash_t hash = ast_type_hash(type, HASH_SEED);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&interner->index, hash, &cursor); i != -1; i = hash_index_find_next(&interner->index, hash, &cursor)){
+        if(ast_types_identical(interner->types[i], type)) return interner->types[i];
+    }
+
+    return NULL;
+}
+
 bool ast_type_is_void(const ast_type_t *type){
     if(type->elements_length != 1 || type->elements[0]->id != AST_ELEM_BASE) return false;
     if(strcmp(((ast_elem_base_t*) type->elements[0])->base, "void") != 0) return false;
@@ -1,84 +1,191 @@
 
+#ifndef _WIN32
+#define _DEFAULT_SOURCE // For mkstemps
+#include <spawn.h>
+#include <sys/wait.h>
+#include <errno.h>
+#endif
+
+#include <llvm/Config/llvm-config.h>
 #include <llvm-c/Core.h>
 #include <llvm-c/ExecutionEngine.h>
 #include <llvm-c/Target.h>
 #include <llvm-c/Analysis.h>
 #include <llvm-c/BitWriter.h>
+#include <llvm-c/Support.h>
+#include <llvm-c/TargetMachine.h>
+#include <llvm-c/Transforms/PassManagerBuilder.h>
+#include <llvm-c/Transforms/Vectorize.h>
+#include <pthread.h>
 
 #include "IR/ir.h"
+#include "IR/ir_flat.h"
 #include "UTIL/util.h"
 #include "UTIL/color.h"
 #include "UTIL/filename.h"
 #include "BKEND/ir_to_llvm.h"
+#include "BKEND/ir_to_llvm_debug.h"
+#include "BKEND/ir_to_llvm_shim.h"
 #include "DRVR/object.h"
 
-LLVMTypeRef ir_to_llvm_type(ir_type_t *ir_type){
+LLVMTypeRef ir_to_llvm_type(llvm_context_t *llvm, ir_type_t *ir_type){
     // Converts an ir type to an llvm type
     LLVMTypeRef type_ref_tmp;
 
     switch(ir_type->kind){
-    case TYPE_KIND_POINTER:
-        type_ref_tmp = ir_to_llvm_type((ir_type_t*) ir_type->extra);
-        if(type_ref_tmp == NULL) return NULL;
-        return LLVMPointerType(type_ref_tmp, 0);
-    case TYPE_KIND_S8:      return LLVMInt8Type();
-    case TYPE_KIND_S16:     return LLVMInt16Type();
-    case TYPE_KIND_S32:     return LLVMInt32Type();
-    case TYPE_KIND_S64:     return LLVMInt64Type();
-    case TYPE_KIND_U8:      return LLVMInt8Type();
-    case TYPE_KIND_U16:     return LLVMInt16Type();
-    case TYPE_KIND_U32:     return LLVMInt32Type();
-    case TYPE_KIND_U64:     return LLVMInt64Type();
-    case TYPE_KIND_HALF:    return LLVMHalfType();
-    case TYPE_KIND_FLOAT:   return LLVMFloatType();
-    case TYPE_KIND_DOUBLE:  return LLVMDoubleType();
-    case TYPE_KIND_BOOLEAN: return LLVMInt1Type();
+    case TYPE_KIND_S8:      return LLVMInt8TypeInContext(llvm->context);
+    case TYPE_KIND_S16:     return LLVMInt16TypeInContext(llvm->context);
+    case TYPE_KIND_S32:     return LLVMInt32TypeInContext(llvm->context);
+    case TYPE_KIND_S64:     return LLVMInt64TypeInContext(llvm->context);
+    case TYPE_KIND_U8:      return LLVMInt8TypeInContext(llvm->context);
+    case TYPE_KIND_U16:     return LLVMInt16TypeInContext(llvm->context);
+    case TYPE_KIND_U32:     return LLVMInt32TypeInContext(llvm->context);
+    case TYPE_KIND_U64:     return LLVMInt64TypeInContext(llvm->context);
+    case TYPE_KIND_HALF:    return LLVMHalfTypeInContext(llvm->context);
+    case TYPE_KIND_FLOAT:   return LLVMFloatTypeInContext(llvm->context);
+    case TYPE_KIND_DOUBLE:  return LLVMDoubleTypeInContext(llvm->context);
+    case TYPE_KIND_BOOLEAN: return LLVMInt1TypeInContext(llvm->context);
+    case TYPE_KIND_VOID:    return LLVMVoidTypeInContext(llvm->context);
     case TYPE_KIND_UNION:
         printf("INTERNAL ERROR: TYPE_KIND_UNION not implemented yet inside ir_to_llvm_type\n");
         return NULL;
-    case TYPE_KIND_STRUCTURE: {
-            // TODO: Should probably cache struct types so they don't have to be
-            //           remade into LLVM types every time we use them.
+    }
+
+    // Non-primitive types are only ever created once
+    type_ref_tmp = llvm_type_cache_find(&llvm->type_cache, ir_type);
+    if(type_ref_tmp != NULL) return type_ref_tmp;
 
+    switch(ir_type->kind){
+    case TYPE_KIND_POINTER:
+        type_ref_tmp = ir_to_llvm_type(llvm, (ir_type_t*) ir_type->extra);
+        if(type_ref_tmp == NULL) return NULL;
+        type_ref_tmp = LLVMPointerType(type_ref_tmp, 0);
+        break;
+    case TYPE_KIND_STRUCTURE: {
+            // NOTE: Named structures are created ahead of time by ir_to_llvm_struct_types(),
+            //       so this is only reached for anonymous structures
             ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) ir_type->extra;
             LLVMTypeRef fields[composite->subtypes_length];
 
             for(length_t i = 0; i != composite->subtypes_length; i++){
-                fields[i] = ir_to_llvm_type(composite->subtypes[i]);
+                fields[i] = ir_to_llvm_type(llvm, composite->subtypes[i]);
                 if(fields[i] == NULL) return NULL;
             }
 
-            LLVMTypeRef type_ref_tmp = LLVMStructType(fields, composite->subtypes_length,
+            type_ref_tmp = LLVMStructTypeInContext(llvm->context, fields, composite->subtypes_length,
                 composite->traits & TYPE_KIND_COMPOSITE_PACKED);
-
-            return type_ref_tmp;
         }
-    case TYPE_KIND_VOID: return LLVMVoidType();
+        break;
     case TYPE_KIND_FUNCPTR: {
             ir_type_extra_function_t *function = (ir_type_extra_function_t*) ir_type->extra;
             LLVMTypeRef args[function->arity];
 
             for(length_t i = 0; i != function->arity; i++){
-                args[i] = ir_to_llvm_type(function->arg_types[i]);
+                args[i] = ir_to_llvm_type(llvm, function->arg_types[i]);
                 if(args[i] == NULL) return NULL;
             }
 
-            LLVMTypeRef type_ref_tmp = LLVMFunctionType(ir_to_llvm_type(function->return_type),
+            type_ref_tmp = LLVMFunctionType(ir_to_llvm_type(llvm, function->return_type),
                 args, function->arity, function->traits & TYPE_KIND_FUNC_VARARG);
             type_ref_tmp = LLVMPointerType(type_ref_tmp, 0);
-
-            return type_ref_tmp;
         }
         break;
-    case TYPE_KIND_FIXED_ARRAY:{
+    case TYPE_KIND_FIXED_ARRAY: {
             ir_type_extra_fixed_array_t *fixed_array = (ir_type_extra_fixed_array_t*) ir_type->extra;
-            type_ref_tmp = ir_to_llvm_type(fixed_array->subtype);
+            type_ref_tmp = ir_to_llvm_type(llvm, fixed_array->subtype);
             if(type_ref_tmp == NULL) return NULL;
-            return LLVMArrayType(type_ref_tmp, fixed_array->length);
+            type_ref_tmp = LLVMArrayType(type_ref_tmp, fixed_array->length);
         }
         break;
     default: return NULL; // No suitable llvm type
     }
+
+    llvm_type_cache_insert(&llvm->type_cache, ir_type, type_ref_tmp);
+    return type_ref_tmp;
+}
+
+errorcode_t ir_to_llvm_struct_types(llvm_context_t *llvm, object_t *object){
+    // Creates named llvm struct types for every struct in the type map
+    // NOTE: Bodies are filled in after every struct has been named so that
+    //       structures can reference each other (and themselves) in any order
+
+    ir_type_mapping_t *mappings = object->ir_module.type_map.mappings;
+    length_t mappings_length = object->ir_module.type_map.mappings_length;
+
+    for(length_t i = 0; i != mappings_length; i++){
+        if(mappings[i].type.kind != TYPE_KIND_STRUCTURE) continue;
+
+        LLVMTypeRef named = LLVMStructCreateNamed(llvm->context, mappings[i].name);
+        llvm_type_cache_insert(&llvm->type_cache, &mappings[i].type, named);
+    }
+
+    for(length_t i = 0; i != mappings_length; i++){
+        if(mappings[i].type.kind != TYPE_KIND_STRUCTURE) continue;
+
+        ir_type_extra_composite_t *composite = (ir_type_extra_composite_t*) mappings[i].type.extra;
+        LLVMTypeRef fields[composite->subtypes_length];
+
+        for(length_t f = 0; f != composite->subtypes_length; f++){
+            fields[f] = ir_to_llvm_type(llvm, composite->subtypes[f]);
+            if(fields[f] == NULL) return FAILURE;
+        }
+
+        LLVMStructSetBody(llvm_type_cache_find(&llvm->type_cache, &mappings[i].type), fields,
+            composite->subtypes_length, composite->traits & TYPE_KIND_COMPOSITE_PACKED);
+    }
+
+    return SUCCESS;
+}
+
+void llvm_type_cache_init(llvm_type_cache_t *cache){
+    cache->length = 0;
+    cache->capacity = 256;
+    cache->entries = malloc(sizeof(llvm_type_cache_entry_t) * cache->capacity);
+    memset(cache->entries, 0, sizeof(llvm_type_cache_entry_t) * cache->capacity);
+}
+
+void llvm_type_cache_free(llvm_type_cache_t *cache){
+    free(cache->entries);
+}
+
+length_t llvm_type_cache_slot(llvm_type_cache_entry_t *entries, length_t capacity, ir_type_t *ir_type){
+    // NOTE: Returns the index of the entry for 'ir_type' or the empty slot where it belongs
+    // NOTE: Pool allocations are at least 8 byte granular, so drop the low bits before mixing
+    length_t hash = (length_t) ((size_t) ir_type >> 3) * 0x9E3779B97F4A7C15ULL;
+    length_t index = (hash >> 16) & (capacity - 1);
+
+    while(entries[index].ir_type != NULL && entries[index].ir_type != ir_type){
+        index = (index + 1) & (capacity - 1);
+    }
+    return index;
+}
+
+LLVMTypeRef llvm_type_cache_find(llvm_type_cache_t *cache, ir_type_t *ir_type){
+    length_t index = llvm_type_cache_slot(cache->entries, cache->capacity, ir_type);
+    return cache->entries[index].llvm_type;
+}
+
+void llvm_type_cache_insert(llvm_type_cache_t *cache, ir_type_t *ir_type, LLVMTypeRef llvm_type){
+    if((cache->length + 1) * 2 > cache->capacity){
+        // Keep the load factor at or below one half
+        length_t new_capacity = cache->capacity * 2;
+        llvm_type_cache_entry_t *new_entries = malloc(sizeof(llvm_type_cache_entry_t) * new_capacity);
+        memset(new_entries, 0, sizeof(llvm_type_cache_entry_t) * new_capacity);
+
+        for(length_t i = 0; i != cache->capacity; i++){
+            if(cache->entries[i].ir_type == NULL) continue;
+            new_entries[llvm_type_cache_slot(new_entries, new_capacity, cache->entries[i].ir_type)] = cache->entries[i];
+        }
+
+        free(cache->entries);
+        cache->entries = new_entries;
+        cache->capacity = new_capacity;
+    }
+
+    length_t index = llvm_type_cache_slot(cache->entries, cache->capacity, ir_type);
+    if(cache->entries[index].ir_type == NULL) cache->length++;
+    cache->entries[index].ir_type = ir_type;
+    cache->entries[index].llvm_type = llvm_type;
 }
 
 LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
@@ -92,17 +199,17 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
     switch(value->value_type){
     case VALUE_TYPE_LITERAL: {
             switch(value->type->kind){
-            case TYPE_KIND_S8: return LLVMConstInt(LLVMInt8Type(), *((char*) value->extra), true);
-            case TYPE_KIND_U8: return LLVMConstInt(LLVMInt8Type(), *((unsigned char*) value->extra), false);
-            case TYPE_KIND_S16: return LLVMConstInt(LLVMInt16Type(), *((int*) value->extra), true);
-            case TYPE_KIND_U16: return LLVMConstInt(LLVMInt16Type(), *((unsigned int*) value->extra), false);
-            case TYPE_KIND_S32: return LLVMConstInt(LLVMInt32Type(), *((long long*) value->extra), true);
-            case TYPE_KIND_U32: return LLVMConstInt(LLVMInt32Type(), *((unsigned long long*) value->extra), false);
-            case TYPE_KIND_S64: return LLVMConstInt(LLVMInt64Type(), *((long long*) value->extra), true);
-            case TYPE_KIND_U64: return LLVMConstInt(LLVMInt64Type(), *((unsigned long long*) value->extra), false);
-            case TYPE_KIND_FLOAT: return LLVMConstReal(LLVMFloatType(), *((double*) value->extra));
-            case TYPE_KIND_DOUBLE: return LLVMConstReal(LLVMDoubleType(), *((double*) value->extra));
-            case TYPE_KIND_BOOLEAN: return LLVMConstInt(LLVMInt1Type(), *((bool*) value->extra), false);
+            case TYPE_KIND_S8: return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), *((char*) value->extra), true);
+            case TYPE_KIND_U8: return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), *((unsigned char*) value->extra), false);
+            case TYPE_KIND_S16: return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), *((int*) value->extra), true);
+            case TYPE_KIND_U16: return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), *((unsigned int*) value->extra), false);
+            case TYPE_KIND_S32: return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), *((long long*) value->extra), true);
+            case TYPE_KIND_U32: return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), *((unsigned long long*) value->extra), false);
+            case TYPE_KIND_S64: return LLVMConstInt(LLVMInt64TypeInContext(llvm->context), *((long long*) value->extra), true);
+            case TYPE_KIND_U64: return LLVMConstInt(LLVMInt64TypeInContext(llvm->context), *((unsigned long long*) value->extra), false);
+            case TYPE_KIND_FLOAT: return LLVMConstReal(LLVMFloatTypeInContext(llvm->context), *((double*) value->extra));
+            case TYPE_KIND_DOUBLE: return LLVMConstReal(LLVMDoubleTypeInContext(llvm->context), *((double*) value->extra));
+            case TYPE_KIND_BOOLEAN: return LLVMConstInt(LLVMInt1TypeInContext(llvm->context), *((bool*) value->extra), false);
             default:
                 redprintf("INTERNAL ERROR: Unknown type kind literal in ir_to_llvm_value\n");
                 return NULL;
@@ -113,14 +220,14 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
             return llvm->catalog->blocks[extra->block_id].value_references[extra->instruction_id];
         }
     case VALUE_TYPE_NULLPTR:
-        return LLVMConstNull(LLVMPointerType(LLVMInt8Type(), 0));
+        return LLVMConstNull(LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0));
     case VALUE_TYPE_NULLPTR_OF_TYPE:
-        return LLVMConstNull(ir_to_llvm_type(value->type));
+        return LLVMConstNull(ir_to_llvm_type(llvm, value->type));
     case VALUE_TYPE_ARRAY_LITERAL: {
             ir_value_array_literal_t *array_literal = value->extra;
 
             // Assume that value->type is a pointer to array element type
-            LLVMTypeRef type = ir_to_llvm_type((ir_type_t*) value->type->extra);
+            LLVMTypeRef type = ir_to_llvm_type(llvm, (ir_type_t*) value->type->extra);
             
             LLVMValueRef values[array_literal->length];
 
@@ -136,8 +243,8 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
             LLVMSetInitializer(global_data, static_array);
 
             LLVMValueRef indices[2];
-            indices[0] = LLVMConstInt(LLVMInt32Type(), 0, true);
-            indices[1] = LLVMConstInt(LLVMInt32Type(), 0, true);
+            indices[0] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
+            indices[1] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
 
             return LLVMConstGEP(global_data, indices, 2);
         }
@@ -145,7 +252,7 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
             ir_value_struct_literal_t *struct_literal = value->extra;
 
             // Assume that value->type is a pointer to a struct
-            LLVMTypeRef type = ir_to_llvm_type(value->type);
+            LLVMTypeRef type = ir_to_llvm_type(llvm, value->type);
             
             LLVMValueRef values[struct_literal->length];
 
@@ -162,25 +269,24 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
         }
     case VALUE_TYPE_CSTR_OF_LEN: {
             ir_value_cstr_of_len_t *cstr_of_len = value->extra;
-            LLVMValueRef global_data = LLVMAddGlobal(llvm->module, LLVMArrayType(LLVMInt8Type(), cstr_of_len->length), ".str");
+            LLVMValueRef global_data = LLVMAddGlobal(llvm->module, LLVMArrayType(LLVMInt8TypeInContext(llvm->context), cstr_of_len->length), ".str");
             LLVMSetLinkage(global_data, LLVMInternalLinkage);
             LLVMSetGlobalConstant(global_data, true);
-            LLVMSetInitializer(global_data, LLVMConstString(cstr_of_len->array, cstr_of_len->length, true));
+            LLVMSetInitializer(global_data, LLVMConstStringInContext(llvm->context, cstr_of_len->array, cstr_of_len->length, true));
             LLVMValueRef indices[2];
-            indices[0] = LLVMConstInt(LLVMInt32Type(), 0, true);
-            indices[1] = LLVMConstInt(LLVMInt32Type(), 0, true);
-            LLVMValueRef literal = LLVMBuildGEP(llvm->builder, global_data, indices, 2, "");
-            return literal;
+            indices[0] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
+            indices[1] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
+            return LLVMConstGEP(global_data, indices, 2);
         }
     case VALUE_TYPE_CONST_BITCAST: {
             LLVMValueRef before = ir_to_llvm_value(llvm, value->extra);
-            LLVMTypeRef after = ir_to_llvm_type(value->type);
+            LLVMTypeRef after = ir_to_llvm_type(llvm, value->type);
             return LLVMConstBitCast(before, after);
         }
     case VALUE_TYPE_STRUCT_CONSTRUCTION: {
             ir_value_struct_construction_t *construction = (ir_value_struct_construction_t*) value->extra;
 
-            LLVMValueRef constructed = LLVMGetUndef(ir_to_llvm_type(value->type));
+            LLVMValueRef constructed = LLVMGetUndef(ir_to_llvm_type(llvm, value->type));
 
             for(length_t i = 0; i != construction->length; i++){
                 constructed = LLVMBuildInsertValue(llvm->builder, constructed, ir_to_llvm_value(llvm, construction->values[i]), i, "");
@@ -188,6 +294,11 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
 
             return constructed;
         }
+    case VALUE_TYPE_OFFSETOF: {
+            ir_value_offsetof_t *offsetof_value = (ir_value_offsetof_t*) value->extra;
+            unsigned long long offset = LLVMOffsetOfElement(llvm->data_layout, ir_to_llvm_type(llvm, offsetof_value->type), offsetof_value->index);
+            return LLVMConstInt(LLVMInt64TypeInContext(llvm->context), offset, false);
+        }
     default:
         redprintf("INTERNAL ERROR: Unknown value type %d of value in ir_to_llvm_value\n", value->value_type);
         return NULL;
@@ -196,6 +307,88 @@ LLVMValueRef ir_to_llvm_value(llvm_context_t *llvm, ir_value_t *value){
     return NULL;
 }
 
+LLVMValueRef ir_to_llvm_operand(llvm_context_t *llvm, ir_flat_func_t *flat, ir_flat_operand_t operand){
+    // Retrieves the value of an operand of a flat instruction
+
+    length_t index = IR_FLAT_OPERAND_INDEX(operand);
+
+    switch(IR_FLAT_OPERAND_KIND(operand)){
+    case IR_FLAT_OPERAND_RESULT:
+        return llvm->catalog->value_references[index];
+    case IR_FLAT_OPERAND_LITERAL:
+        return ir_to_llvm_literal(llvm, &flat->literals[index]);
+    case IR_FLAT_OPERAND_VALUE:
+        return ir_to_llvm_value(llvm, flat->values[index]);
+    }
+
+    redprintf("INTERNAL ERROR: ir_to_llvm_operand() got an operand without a value\n");
+    return NULL;
+}
+
+LLVMValueRef ir_to_llvm_literal(llvm_context_t *llvm, ir_flat_literal_t *literal){
+    double float_value;
+
+    switch(literal->type->kind){
+    case TYPE_KIND_S8: return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), literal->bits, true);
+    case TYPE_KIND_U8: return LLVMConstInt(LLVMInt8TypeInContext(llvm->context), literal->bits, false);
+    case TYPE_KIND_S16: return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), literal->bits, true);
+    case TYPE_KIND_U16: return LLVMConstInt(LLVMInt16TypeInContext(llvm->context), literal->bits, false);
+    case TYPE_KIND_S32: return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), literal->bits, true);
+    case TYPE_KIND_U32: return LLVMConstInt(LLVMInt32TypeInContext(llvm->context), literal->bits, false);
+    case TYPE_KIND_S64: return LLVMConstInt(LLVMInt64TypeInContext(llvm->context), literal->bits, true);
+    case TYPE_KIND_U64: return LLVMConstInt(LLVMInt64TypeInContext(llvm->context), literal->bits, false);
+    case TYPE_KIND_FLOAT:
+        memcpy(&float_value, &literal->bits, sizeof(double));
+        return LLVMConstReal(LLVMFloatTypeInContext(llvm->context), float_value);
+    case TYPE_KIND_DOUBLE:
+        memcpy(&float_value, &literal->bits, sizeof(double));
+        return LLVMConstReal(LLVMDoubleTypeInContext(llvm->context), float_value);
+    case TYPE_KIND_BOOLEAN: return LLVMConstInt(LLVMInt1TypeInContext(llvm->context), literal->bits, false);
+    }
+
+    redprintf("INTERNAL ERROR: Unknown type kind literal in ir_to_llvm_literal\n");
+    return NULL;
+}
+
+LLVMValueRef ir_to_llvm_integer_math(llvm_context_t *llvm, ir_flat_func_t *flat, ir_flat_instr_t *instr){
+    LLVMBuilderRef builder = llvm->builder;
+    ir_flat_operand_t *operands = &flat->operands[instr->operands];
+    LLVMValueRef a = ir_to_llvm_operand(llvm, flat, operands[0]);
+    LLVMValueRef b = ir_to_llvm_operand(llvm, flat, operands[1]);
+
+    // With '--assume-no-overflow', signed math is marked 'nsw' and unsigned math is marked 'nuw'
+    bool no_overflow = llvm->compiler->traits & COMPILER_NO_OVERFLOW;
+    bool is_signed = global_type_kind_signs[ir_flat_operand_type(flat, operands[0])->kind];
+
+    switch(instr->id){
+    case INSTRUCTION_ADD:
+        if(!no_overflow) return LLVMBuildAdd(builder, a, b, "");
+        return is_signed ? LLVMBuildNSWAdd(builder, a, b, "") : LLVMBuildNUWAdd(builder, a, b, "");
+    case INSTRUCTION_SUBTRACT:
+        if(!no_overflow) return LLVMBuildSub(builder, a, b, "");
+        return is_signed ? LLVMBuildNSWSub(builder, a, b, "") : LLVMBuildNUWSub(builder, a, b, "");
+    case INSTRUCTION_MULTIPLY:
+        if(!no_overflow) return LLVMBuildMul(builder, a, b, "");
+        return is_signed ? LLVMBuildNSWMul(builder, a, b, "") : LLVMBuildNUWMul(builder, a, b, "");
+    }
+
+    redprintf("INTERNAL ERROR: Unexpected instruction '%d' in ir_to_llvm_integer_math\n", instr->id);
+    return NULL;
+}
+
+void ir_to_llvm_fast_math(llvm_context_t *llvm, LLVMValueRef instr){
+    if(!(llvm->compiler->traits & COMPILER_FAST_MATH)) return;
+
+    // NOTE: Fast-math flags can't be set on individual instructions through
+    // the C API before LLVM 18, so this goes through the C++ API instead
+    ir_to_llvm_shim_fast_math(instr, llvm->compiler->fast_math);
+}
+
+void ir_to_llvm_enum_attribute(llvm_context_t *llvm, LLVMValueRef func, LLVMAttributeIndex index, const char *name){
+    unsigned int kind = LLVMGetEnumAttributeKindForName(name, strlen(name));
+    LLVMAddAttributeAtIndex(func, index, LLVMCreateEnumAttribute(llvm->context, kind, 0));
+}
+
 errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
     // Generates llvm function skeletons from ir function data
 
@@ -208,19 +401,19 @@ errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
         LLVMTypeRef parameters[funcs[f].arity];
 
         for(length_t a = 0; a != funcs[f].arity; a++){
-            parameters[a] = ir_to_llvm_type(funcs[f].argument_types[a]);
+            parameters[a] = ir_to_llvm_type(llvm, funcs[f].argument_types[a]);
             if(parameters[a] == NULL) return FAILURE;
         }
 
-        LLVMTypeRef return_type = ir_to_llvm_type(funcs[f].return_type);
+        LLVMTypeRef return_type = ir_to_llvm_type(llvm, funcs[f].return_type);
         LLVMTypeRef llvm_func_type = LLVMFunctionType(return_type, parameters, funcs[f].arity, funcs[f].traits & IR_FUNC_VARARG);
 
         const char *implementation_name;
+        char adept_implementation_name[256];
 
         if(funcs[f].traits & IR_FUNC_FOREIGN || object->ast.funcs[f].traits & AST_FUNC_MAIN){
             implementation_name = funcs[f].name;
         } else {
-            char adept_implementation_name[256];
             sprintf(adept_implementation_name, "adept_%X", (int) f);
             implementation_name = adept_implementation_name;
         }
@@ -229,6 +422,25 @@ errorcode_t ir_to_llvm_functions(llvm_context_t *llvm, object_t *object){
 
         LLVMCallConv call_conv = funcs[f].traits & IR_FUNC_STDCALL ? LLVMX86StdcallCallConv : LLVMCCallConv;
         LLVMSetFunctionCallConv(func_skeletons[f], call_conv);
+
+        // Record the target CPU on each function, so that it's also respected when JIT compiling
+        if(!(funcs[f].traits & IR_FUNC_FOREIGN)){
+            if(llvm->compiler->target_cpu) LLVMAddTargetDependentFunctionAttr(func_skeletons[f], "target-cpu", llvm->compiler->target_cpu);
+            if(llvm->compiler->target_features) LLVMAddTargetDependentFunctionAttr(func_skeletons[f], "target-features", llvm->compiler->target_features);
+
+            if(llvm->compiler->traits & COMPILER_FAST_MATH){
+                // Only describe the whole function as unsafe when every fast-math flag is allowed
+                trait_t fast_math = llvm->compiler->fast_math;
+                if((fast_math & FAST_MATH_ALL) == FAST_MATH_ALL) LLVMAddTargetDependentFunctionAttr(func_skeletons[f], "unsafe-fp-math", "true");
+                if(fast_math & FAST_MATH_NO_INFS) LLVMAddTargetDependentFunctionAttr(func_skeletons[f], "no-infs-fp-math", "true");
+                if(fast_math & FAST_MATH_NO_NANS) LLVMAddTargetDependentFunctionAttr(func_skeletons[f], "no-nans-fp-math", "true");
+                if(fast_math & FAST_MATH_NO_SIGNED_ZEROS) LLVMAddTargetDependentFunctionAttr(func_skeletons[f], "no-signed-zeros-fp-math", "true");
+                if(fast_math & FAST_MATH_CONTRACT) LLVMAddTargetDependentFunctionAttr(func_skeletons[f], "less-precise-fpmad", "true");
+            }
+
+            // Adept code never unwinds
+            ir_to_llvm_enum_attribute(llvm, func_skeletons[f], LLVMAttributeFunctionIndex, "nounwind");
+        }
     }
 
     return SUCCESS;
@@ -240,18 +452,19 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
 
     LLVMModuleRef llvm_module = llvm->module;
     ir_func_t *funcs = object->ir_module.funcs;
-    length_t funcs_length = object->ir_module.funcs_length;
     LLVMValueRef *func_skeletons = llvm->func_skeletons;
 
-    for(length_t f = 0; f != funcs_length; f++){
-        LLVMBuilderRef builder = LLVMCreateBuilder();
-        ir_basicblock_t *basicblocks = funcs[f].basicblocks;
+    for(length_t f = llvm->partition->funcs_begin; f != llvm->partition->funcs_end; f++){
+        LLVMBuilderRef builder = LLVMCreateBuilderInContext(llvm->context);
+        ir_flat_func_t *flat = &funcs[f].flat;
         length_t basicblocks_length = funcs[f].basicblocks_length;
 
+        // NOTE: The results of each basic block are a slice of the results of the whole function
         value_catalog_t catalog;
+        catalog.value_references = malloc(sizeof(LLVMValueRef) * flat->instructions_length);
         catalog.blocks = malloc(sizeof(value_catalog_block_t) * basicblocks_length);
         catalog.blocks_length = basicblocks_length;
-        for(length_t c = 0; c != basicblocks_length; c++) catalog.blocks[c].value_references = malloc(sizeof(LLVMValueRef) * basicblocks[c].instructions_length);
+        for(length_t c = 0; c != basicblocks_length; c++) catalog.blocks[c].value_references = &catalog.value_references[flat->block_starts[c]];
 
         varstack_t stack;
         stack.values = malloc(sizeof(LLVMValueRef) * funcs[f].variable_count);
@@ -262,66 +475,65 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
         llvm->builder = builder;
         llvm->catalog = &catalog;
         llvm->stack = &stack;
+        ir_to_llvm_debug_function(llvm, func_skeletons[f], &funcs[f]);
 
         LLVMBasicBlockRef *llvm_blocks = malloc(sizeof(LLVMBasicBlockRef) * basicblocks_length);
-        ir_instr_t *instr;
         LLVMValueRef llvm_result;
 
-        for(length_t b = 0; b != basicblocks_length; b++) llvm_blocks[b] = LLVMAppendBasicBlock(func_skeletons[f], "");
+        for(length_t b = 0; b != basicblocks_length; b++) llvm_blocks[b] = LLVMAppendBasicBlockInContext(llvm->context, func_skeletons[f], "");
 
         if(llvm->compiler->checks & COMPILER_NULL_CHECKS && basicblocks_length != 0){
-            llvm->null_check_on_fail_block = LLVMAppendBasicBlock(func_skeletons[f], "");
+            llvm->null_check_on_fail_block = LLVMAppendBasicBlockInContext(llvm->context, func_skeletons[f], "");
             LLVMPositionBuilderAtEnd(builder, llvm->null_check_on_fail_block);
 
             LLVMValueRef printf_fn = LLVMGetNamedFunction(llvm->module, "printf");
             LLVMValueRef exit_fn = LLVMGetNamedFunction(llvm->module, "exit");
 
             if(exit_fn == NULL){
-                LLVMTypeRef int32 = LLVMInt32Type();
+                LLVMTypeRef int32 = LLVMInt32TypeInContext(llvm->context);
                 LLVMTypeRef exit_fn_type = LLVMFunctionType(int32, &int32, 1, false);
                 exit_fn = LLVMAddFunction(llvm->module, "exit", exit_fn_type);
             }
 
             if(printf_fn == NULL){
-                LLVMTypeRef int32 = LLVMInt32Type();
-                LLVMTypeRef charptr = LLVMPointerType(LLVMInt8Type(), 0);
+                LLVMTypeRef int32 = LLVMInt32TypeInContext(llvm->context);
+                LLVMTypeRef charptr = LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0);
                 LLVMTypeRef printf_fn_type = LLVMFunctionType(int32, &charptr, 1, true);
                 printf_fn = LLVMAddFunction(llvm->module, "printf", printf_fn_type);
             }
 
             const char *error_msg = "===== RUNTIME ERROR: DEREFERENCED NULL POINTER IN FUNCTION '%s'! =====\n";
             length_t error_msg_length = strlen(error_msg) + 1;
-            LLVMValueRef global_data = LLVMAddGlobal(llvm->module, LLVMArrayType(LLVMInt8Type(), error_msg_length), ".str");
+            LLVMValueRef global_data = LLVMAddGlobal(llvm->module, LLVMArrayType(LLVMInt8TypeInContext(llvm->context), error_msg_length), ".str");
             LLVMSetLinkage(global_data, LLVMInternalLinkage);
             LLVMSetGlobalConstant(global_data, true);
-            LLVMSetInitializer(global_data, LLVMConstString(error_msg, error_msg_length, true));
+            LLVMSetInitializer(global_data, LLVMConstStringInContext(llvm->context, error_msg, error_msg_length, true));
             LLVMValueRef indices[2];
-            indices[0] = LLVMConstInt(LLVMInt32Type(), 0, true);
-            indices[1] = LLVMConstInt(LLVMInt32Type(), 0, true);
+            indices[0] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
+            indices[1] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
             LLVMValueRef arg = LLVMBuildGEP(llvm->builder, global_data, indices, 2, "");
 
             const char *func_name = funcs[f].name;
             length_t func_name_len = strlen(func_name) + 1;
-            global_data = LLVMAddGlobal(llvm->module, LLVMArrayType(LLVMInt8Type(), func_name_len), ".str");
+            global_data = LLVMAddGlobal(llvm->module, LLVMArrayType(LLVMInt8TypeInContext(llvm->context), func_name_len), ".str");
             LLVMSetLinkage(global_data, LLVMInternalLinkage);
             LLVMSetGlobalConstant(global_data, true);
-            LLVMSetInitializer(global_data, LLVMConstString(func_name, func_name_len, true));
-            indices[0] = LLVMConstInt(LLVMInt32Type(), 0, true);
-            indices[1] = LLVMConstInt(LLVMInt32Type(), 0, true);
+            LLVMSetInitializer(global_data, LLVMConstStringInContext(llvm->context, func_name, func_name_len, true));
+            indices[0] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
+            indices[1] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
             LLVMValueRef func_name_str = LLVMBuildGEP(llvm->builder, global_data, indices, 2, "");
 
             LLVMValueRef args[] = {arg, func_name_str};
 
             LLVMBuildCall(builder, printf_fn, args, 2, "");
 
-            arg = LLVMConstInt(LLVMInt32Type(), 1, true);
+            arg = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 1, true);
             LLVMBuildCall(builder, exit_fn, &arg, 1, "");
             LLVMBuildUnreachable(builder);
         }
 
         for(length_t b = 0; b != basicblocks_length; b++){
             LLVMPositionBuilderAtEnd(builder, llvm_blocks[b]);
-            ir_basicblock_t *basicblock = &basicblocks[b];
 
             if(b == 0){ // Do any function entry instructions needed
                 // Allocate stack variables
@@ -330,7 +542,7 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
 
                     if(var == NULL){
                         redprintf("INTERNAL ERROR: VAR IN EXPORT STAGE COULD NOT BE FOUND (id: %d)\n", (int) s);
-                        for(length_t c = 0; c != catalog.blocks_length; c++) free(catalog.blocks[c].value_references);
+                        free(catalog.value_references);
                         free(catalog.blocks);
                         free(stack.values);
                         free(stack.types);
@@ -339,10 +551,10 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
                         return FAILURE;
                     }
 
-                    LLVMTypeRef alloca_type = ir_to_llvm_type(var->ir_type);
+                    LLVMTypeRef alloca_type = ir_to_llvm_type(llvm, var->ir_type);
 
                     if(alloca_type == NULL){
-                        for(length_t c = 0; c != catalog.blocks_length; c++) free(catalog.blocks[c].value_references);
+                        free(catalog.value_references);
                         free(catalog.blocks);
                         free(stack.values);
                         free(stack.types);
@@ -361,148 +573,149 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
                 }
             }
 
-            for(length_t i = 0; i != basicblock->instructions_length; i++){
-                switch(basicblock->instructions[i]->id){
+            for(length_t i = flat->block_starts[b]; i != flat->block_starts[b + 1]; i++){
+                ir_flat_instr_t *instr = &flat->instructions[i];
+                ir_flat_operand_t *operands = &flat->operands[instr->operands];
+                ir_to_llvm_debug_set_location(llvm, flat->sources[i]);
+
+                switch(instr->id){
                 case INSTRUCTION_RET:
-                    instr = basicblock->instructions[i];
-                    LLVMBuildRet(builder, ((ir_instr_ret_t*) instr)->value == NULL ? NULL : ir_to_llvm_value(llvm, ((ir_instr_ret_t*) instr)->value));
+                    LLVMBuildRet(builder, IR_FLAT_OPERAND_KIND(operands[0]) == IR_FLAT_OPERAND_NONE ? NULL : ir_to_llvm_operand(llvm, flat, operands[0]));
                     break;
                 case INSTRUCTION_ADD:
-                    instr = basicblock->instructions[i];
-
-                    // Do excess instructions for adding pointers to get llvm to shut up
-                    if(((ir_instr_math_t*) instr)->a->type->kind == TYPE_KIND_POINTER){
-                        LLVMValueRef val_a = ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a);
-                        LLVMValueRef val_b = ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b);
-                        val_a = LLVMBuildPtrToInt(builder, val_a, LLVMInt64Type(), "");
-                        val_b = LLVMBuildPtrToInt(builder, val_b, LLVMInt64Type(), "");
-                        llvm_result = LLVMBuildAdd(builder, val_a, val_b, "");
-                        llvm_result = LLVMBuildIntToPtr(builder, llvm_result, ir_to_llvm_type(((ir_instr_math_t*) instr)->a->type), "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+
+                    // Adding two pointers adds the address of the second as a byte offset to the first
+                    if(ir_flat_operand_type(flat, operands[0])->kind == TYPE_KIND_POINTER){
+                        LLVMTypeRef byte_ptr_type = LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0);
+                        LLVMValueRef val_a = ir_to_llvm_operand(llvm, flat, operands[0]);
+                        LLVMValueRef val_b = ir_to_llvm_operand(llvm, flat, operands[1]);
+                        val_a = LLVMBuildBitCast(builder, val_a, byte_ptr_type, "");
+                        val_b = LLVMBuildPtrToInt(builder, val_b, LLVMInt64TypeInContext(llvm->context), "");
+                        llvm_result = LLVMBuildGEP(builder, val_a, &val_b, 1, "");
+                        llvm_result = LLVMBuildBitCast(builder, llvm_result, ir_to_llvm_type(llvm, ir_flat_operand_type(flat, operands[0])), "");
+                        catalog.value_references[i] = llvm_result;
                     } else {
-                        llvm_result = LLVMBuildAdd(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                        catalog.blocks[b].value_references[i] = llvm_result;    
+                        llvm_result = ir_to_llvm_integer_math(llvm, flat, instr);
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_FADD:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFAdd(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFAdd(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    ir_to_llvm_fast_math(llvm, llvm_result);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SUBTRACT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildSub(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = ir_to_llvm_integer_math(llvm, flat, instr);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FSUBTRACT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFSub(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFSub(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    ir_to_llvm_fast_math(llvm, llvm_result);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_MULTIPLY:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildMul(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = ir_to_llvm_integer_math(llvm, flat, instr);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FMULTIPLY:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFMul(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFMul(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    ir_to_llvm_fast_math(llvm, llvm_result);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_UDIVIDE:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildUDiv(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildUDiv(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SDIVIDE:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildSDiv(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildSDiv(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FDIVIDE:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFDiv(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFDiv(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    ir_to_llvm_fast_math(llvm, llvm_result);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_UMODULUS:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildURem(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildURem(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SMODULUS:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildSRem(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildSRem(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FMODULUS:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFRem(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFRem(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    ir_to_llvm_fast_math(llvm, llvm_result);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_CALL: {
-                        instr = basicblocks[b].instructions[i];
-                        LLVMValueRef arguments[((ir_instr_call_t*) instr)->values_length];
+                        LLVMValueRef arguments[instr->operands_length];
 
-                        for(length_t v = 0; v != ((ir_instr_call_t*) instr)->values_length; v++){
-                            arguments[v] = ir_to_llvm_value(llvm, ((ir_instr_call_t*) instr)->values[v]);
+                        for(length_t v = 0; v != instr->operands_length; v++){
+                            arguments[v] = ir_to_llvm_operand(llvm, flat, operands[v]);
                         }
 
                         char *implementation_name;
-                        ast_func_t *target_ast_func = &object->ast.funcs[((ir_instr_call_t*) instr)->func_id];
+                        char adept_implementation_name[256];
+                        ast_func_t *target_ast_func = &object->ast.funcs[instr->details[0]];
 
                         if(target_ast_func->traits & AST_FUNC_FOREIGN || target_ast_func->traits & AST_FUNC_MAIN){
                             implementation_name = target_ast_func->name;
                         } else {
-                            char adept_implementation_name[256];
-                            sprintf(adept_implementation_name, "adept_%X", (int) ((ir_instr_call_t*) instr)->func_id);
+                            sprintf(adept_implementation_name, "adept_%X", (int) instr->details[0]);
                             implementation_name = adept_implementation_name;
                         }
 
                         LLVMValueRef named_func = LLVMGetNamedFunction(llvm_module, implementation_name);
                         assert(named_func != NULL);
 
-                        llvm_result = LLVMBuildCall(builder, named_func, arguments, ((ir_instr_call_t*) instr)->values_length, "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        llvm_result = LLVMBuildCall(builder, named_func, arguments, instr->operands_length, "");
+                        LLVMSetInstructionCallConv(llvm_result, LLVMGetFunctionCallConv(named_func));
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_CALL_ADDRESS: {
-                        instr = basicblocks[b].instructions[i];
-                        LLVMValueRef arguments[((ir_instr_call_address_t*) instr)->values_length];
+                        // (The first operand is the address, and the rest are the arguments)
+                        length_t arguments_length = instr->operands_length - 1;
+                        LLVMValueRef arguments[arguments_length];
 
-                        for(length_t v = 0; v != ((ir_instr_call_address_t*) instr)->values_length; v++){
-                            arguments[v] = ir_to_llvm_value(llvm, ((ir_instr_call_address_t*) instr)->values[v]);
+                        for(length_t v = 0; v != arguments_length; v++){
+                            arguments[v] = ir_to_llvm_operand(llvm, flat, operands[v + 1]);
                         }
 
-                        LLVMValueRef target_func = ir_to_llvm_value(llvm, ((ir_instr_call_address_t*) instr)->address);
+                        LLVMValueRef target_func = ir_to_llvm_operand(llvm, flat, operands[0]);
 
-                        llvm_result = LLVMBuildCall(builder, target_func, arguments, ((ir_instr_call_address_t*) instr)->values_length, "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        llvm_result = LLVMBuildCall(builder, target_func, arguments, arguments_length, "");
+
+                        // Call site calling convention must match the callee's, otherwise the call is undefined
+                        ir_type_extra_function_t *function_type = (ir_type_extra_function_t*) ir_flat_operand_type(flat, operands[0])->extra;
+                        if(function_type->traits & TYPE_KIND_FUNC_STDCALL) LLVMSetInstructionCallConv(llvm_result, LLVMX86StdcallCallConv);
+
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_STORE: {
-                        instr = basicblock->instructions[i];
 
-                        LLVMValueRef destination = ir_to_llvm_value(llvm, ((ir_instr_store_t*) instr)->destination);
+                        LLVMValueRef destination = ir_to_llvm_operand(llvm, flat, operands[1]);
 
                         if(llvm->compiler->checks & COMPILER_NULL_CHECKS){
-                            LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlock(func_skeletons[f], "");
+                            LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlockInContext(llvm->context, func_skeletons[f], "");
 
                             LLVMValueRef if_null = LLVMBuildIsNull(llvm->builder, destination, "");
                             LLVMBuildCondBr(builder, if_null, llvm->null_check_on_fail_block, not_null_block);
                             LLVMPositionBuilderAtEnd(builder, not_null_block);
                         }
 
-                        llvm_result = LLVMBuildStore(builder, ir_to_llvm_value(llvm, ((ir_instr_store_t*) instr)->value), destination);
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        llvm_result = LLVMBuildStore(builder, ir_to_llvm_operand(llvm, flat, operands[0]), destination);
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_LOAD: {
-                        instr = basicblock->instructions[i];
 
-                        LLVMValueRef pointer = ir_to_llvm_value(llvm, ((ir_instr_load_t*) instr)->value);
+                        LLVMValueRef pointer = ir_to_llvm_operand(llvm, flat, operands[0]);
 
                         if(llvm->compiler->checks & COMPILER_NULL_CHECKS){
-                            LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlock(func_skeletons[f], "");
+                            LLVMBasicBlockRef not_null_block = LLVMAppendBasicBlockInContext(llvm->context, func_skeletons[f], "");
 
                             LLVMValueRef if_null = LLVMBuildIsNull(llvm->builder, pointer, "");
                             LLVMBuildCondBr(builder, if_null, llvm->null_check_on_fail_block, not_null_block);
@@ -510,212 +723,180 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
                         }
 
                         llvm_result = LLVMBuildLoad(builder, pointer, "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_VARPTR:
-                    catalog.blocks[b].value_references[i] = llvm->stack->values[((ir_instr_varptr_t*) basicblock->instructions[i])->index];
+                    catalog.value_references[i] = llvm->stack->values[instr->details[0]];
                     break;
                 case INSTRUCTION_GLOBALVARPTR:
-                    catalog.blocks[b].value_references[i] = llvm->global_variables[((ir_instr_varptr_t*) basicblock->instructions[i])->index];
+                    catalog.value_references[i] = llvm->global_variables[instr->details[0]];
                     break;
                 case INSTRUCTION_BREAK:
-                    LLVMBuildBr(builder, llvm_blocks[((ir_instr_break_t*) basicblock->instructions[i])->block_id]);
+                    LLVMBuildBr(builder, llvm_blocks[instr->details[0]]);
                     break;
                 case INSTRUCTION_CONDBREAK:
-                    instr = basicblock->instructions[i];
-                    LLVMBuildCondBr(builder, ir_to_llvm_value(llvm, ((ir_instr_cond_break_t*) instr)->value), llvm_blocks[((ir_instr_cond_break_t*) instr)->true_block_id],
-                    llvm_blocks[((ir_instr_cond_break_t*) instr)->false_block_id]);
+                    LLVMBuildCondBr(builder, ir_to_llvm_operand(llvm, flat, operands[0]), llvm_blocks[instr->details[0]],
+                    llvm_blocks[instr->details[1]]);
                     break;
                 case INSTRUCTION_EQUALS:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntEQ, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntEQ, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FEQUALS:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOEQ, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOEQ, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_NOTEQUALS:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntNE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntNE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FNOTEQUALS:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFCmp(builder, LLVMRealONE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFCmp(builder, LLVMRealONE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_UGREATER:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntUGT, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntUGT, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SGREATER:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntSGT, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntSGT, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FGREATER:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOGT, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOGT, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_ULESSER:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntULT, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntULT, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SLESSER:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntSLT, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntSLT, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FLESSER:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOLT, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOLT, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_UGREATEREQ:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntUGE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntUGE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SGREATEREQ:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntSGE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntSGE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FGREATEREQ:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOGE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOGE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_ULESSEREQ:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntULE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntULE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SLESSEREQ:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildICmp(builder, LLVMIntSLE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildICmp(builder, LLVMIntSLE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FLESSEREQ:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOLE, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFCmp(builder, LLVMRealOLE, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_MEMBER: {
-                        instr = basicblock->instructions[i];
                         LLVMValueRef gep_indices[2];
-                        gep_indices[0] = LLVMConstInt(LLVMInt32Type(), 0, true);
-                        gep_indices[1] = LLVMConstInt(LLVMInt32Type(), ((ir_instr_member_t*) instr)->member, true);
-                        llvm_result = LLVMBuildGEP(builder, ir_to_llvm_value(llvm, ((ir_instr_member_t*) instr)->value), gep_indices, 2, "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        gep_indices[0] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true);
+                        gep_indices[1] = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), instr->details[0], true);
+                        llvm_result = LLVMBuildGEP(builder, ir_to_llvm_operand(llvm, flat, operands[0]), gep_indices, 2, "");
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_ARRAY_ACCESS: {
-                        instr = basicblock->instructions[i];
-                        LLVMValueRef gep_index = ir_to_llvm_value(llvm, ((ir_instr_array_access_t*) instr)->index);
-                        llvm_result = LLVMBuildGEP(builder, ir_to_llvm_value(llvm, ((ir_instr_array_access_t*) instr)->value), &gep_index, 1, "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        LLVMValueRef gep_index = ir_to_llvm_operand(llvm, flat, operands[1]);
+                        llvm_result = LLVMBuildGEP(builder, ir_to_llvm_operand(llvm, flat, operands[0]), &gep_index, 1, "");
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_FUNC_ADDRESS:
-                    instr = basicblock->instructions[i];
 
-                    if(((ir_instr_func_address_t*) instr)->name == NULL){
+                    if(instr->extra == NULL){
                         // Not a foreign function, so resolve via id
                         char implementation_name[256];
-                        sprintf(implementation_name, "adept_%X", (int) ((ir_instr_func_address_t*) instr)->func_id);
+                        sprintf(implementation_name, "adept_%X", (int) instr->details[0]);
                         llvm_result = LLVMGetNamedFunction(llvm_module, implementation_name);
                     } else {
                         // Is a foreign function, so get by name
-                        llvm_result = LLVMGetNamedFunction(llvm_module, ((ir_instr_func_address_t*) instr)->name);
+                        llvm_result = LLVMGetNamedFunction(llvm_module, (const char*) instr->extra);
                     }
 
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_BITCAST:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildBitCast(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildBitCast(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_ZEXT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildZExt(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildZExt(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FEXT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFPExt(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFPExt(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_TRUNC:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildTrunc(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildTrunc(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FTRUNC:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFPTrunc(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFPTrunc(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_INTTOPTR:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildIntToPtr(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildIntToPtr(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_PTRTOINT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildPtrToInt(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildPtrToInt(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FPTOUI:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFPToUI(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFPToUI(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_FPTOSI:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFPToSI(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFPToSI(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_UITOFP:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildUIToFP(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildUIToFP(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SITOFP:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildSIToFP(builder, ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value), ir_to_llvm_type(((ir_instr_cast_t*) instr)->result_type), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildSIToFP(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_type(llvm, instr->result_type), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: {
-                        instr = basicblock->instructions[i];
 
-                        unsigned int type_kind = ((ir_instr_cast_t*) instr)->value->type->kind;
+                        unsigned int type_kind = ir_flat_operand_type(flat, operands[0])->kind;
                         bool type_kind_is_float = (type_kind == TYPE_KIND_FLOAT || type_kind == TYPE_KIND_DOUBLE);
                         LLVMValueRef zero;
 
                         switch(type_kind){
-                        case TYPE_KIND_S8: zero = LLVMConstInt(LLVMInt8Type(), 0, true); break;
-                        case TYPE_KIND_U8: zero = LLVMConstInt(LLVMInt8Type(), 0, false); break;
-                        case TYPE_KIND_S16: zero = LLVMConstInt(LLVMInt16Type(), 0, true); break;
-                        case TYPE_KIND_U16: zero = LLVMConstInt(LLVMInt16Type(), 0, false); break;
-                        case TYPE_KIND_S32: zero = LLVMConstInt(LLVMInt32Type(), 0, true); break;
-                        case TYPE_KIND_U32: zero = LLVMConstInt(LLVMInt32Type(), 0, false); break;
-                        case TYPE_KIND_S64: zero = LLVMConstInt(LLVMInt64Type(), 0, true); break;
-                        case TYPE_KIND_U64: zero = LLVMConstInt(LLVMInt64Type(), 0, false); break;
-                        case TYPE_KIND_FLOAT: zero = LLVMConstReal(LLVMFloatType(), 0); break;
-                        case TYPE_KIND_DOUBLE: zero = LLVMConstReal(LLVMDoubleType(), 0); break;
-                        case TYPE_KIND_BOOLEAN: zero = LLVMConstInt(LLVMInt1Type(), 0, false); break;
-                        case TYPE_KIND_POINTER: zero = LLVMConstNull(ir_to_llvm_type(((ir_instr_cast_t*) instr)->value->type)); break;
+                        case TYPE_KIND_S8: zero = LLVMConstInt(LLVMInt8TypeInContext(llvm->context), 0, true); break;
+                        case TYPE_KIND_U8: zero = LLVMConstInt(LLVMInt8TypeInContext(llvm->context), 0, false); break;
+                        case TYPE_KIND_S16: zero = LLVMConstInt(LLVMInt16TypeInContext(llvm->context), 0, true); break;
+                        case TYPE_KIND_U16: zero = LLVMConstInt(LLVMInt16TypeInContext(llvm->context), 0, false); break;
+                        case TYPE_KIND_S32: zero = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, true); break;
+                        case TYPE_KIND_U32: zero = LLVMConstInt(LLVMInt32TypeInContext(llvm->context), 0, false); break;
+                        case TYPE_KIND_S64: zero = LLVMConstInt(LLVMInt64TypeInContext(llvm->context), 0, true); break;
+                        case TYPE_KIND_U64: zero = LLVMConstInt(LLVMInt64TypeInContext(llvm->context), 0, false); break;
+                        case TYPE_KIND_FLOAT: zero = LLVMConstReal(LLVMFloatTypeInContext(llvm->context), 0); break;
+                        case TYPE_KIND_DOUBLE: zero = LLVMConstReal(LLVMDoubleTypeInContext(llvm->context), 0); break;
+                        case TYPE_KIND_BOOLEAN: zero = LLVMConstInt(LLVMInt1TypeInContext(llvm->context), 0, false); break;
+                        case TYPE_KIND_POINTER: zero = LLVMConstNull(ir_to_llvm_type(llvm, ir_flat_operand_type(flat, operands[0]))); break;
                         default:
                             redprintf("INTERNAL ERROR: INSTRUCTION_ISNTZERO received unknown type kind\n");
-                            for(length_t c = 0; c != catalog.blocks_length; c++) free(catalog.blocks[c].value_references);
+                            free(catalog.value_references);
                             free(catalog.blocks);
                             free(stack.values);
                             free(stack.types);
@@ -724,144 +905,151 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
                             return FAILURE;
                         }
 
-                        bool isz = (basicblock->instructions[i]->id == INSTRUCTION_ISZERO);
-                        llvm_result = ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value);
+                        bool isz = (instr->id == INSTRUCTION_ISZERO);
+                        llvm_result = ir_to_llvm_operand(llvm, flat, operands[0]);
 
                         if(type_kind_is_float){
-                            catalog.blocks[b].value_references[i] = LLVMBuildFCmp(builder, isz ? LLVMRealOEQ : LLVMRealONE, llvm_result, zero, "");
+                            catalog.value_references[i] = LLVMBuildFCmp(builder, isz ? LLVMRealOEQ : LLVMRealONE, llvm_result, zero, "");
                         } else {
-                            catalog.blocks[b].value_references[i] = LLVMBuildICmp(builder, isz ? LLVMIntEQ : LLVMIntNE, llvm_result, zero, "");
+                            catalog.value_references[i] = LLVMBuildICmp(builder, isz ? LLVMIntEQ : LLVMIntNE, llvm_result, zero, "");
                         }
                     }
                     break;
                 case INSTRUCTION_REINTERPRET:
                     // Reinterprets a signed vs unsigned integer in higher level IR
                     // LLVM Can ignore this instruction
-                    instr = basicblock->instructions[i];
-                    catalog.blocks[b].value_references[i] = ir_to_llvm_value(llvm, ((ir_instr_cast_t*) instr)->value);
+                    catalog.value_references[i] = ir_to_llvm_operand(llvm, flat, operands[0]);
                     break;
                 case INSTRUCTION_AND:
                 case INSTRUCTION_BIT_AND:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildAnd(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildAnd(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_OR:
                 case INSTRUCTION_BIT_OR:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildOr(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildOr(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_SIZEOF: {
-                        instr = basicblock->instructions[i];
-                        length_t type_size = LLVMABISizeOfType(llvm->data_layout, ir_to_llvm_type(((ir_instr_sizeof_t*) instr)->type));
-                        catalog.blocks[b].value_references[i] = LLVMConstInt(LLVMInt64Type(), type_size, false);
+                        length_t type_size = LLVMABISizeOfType(llvm->data_layout, ir_to_llvm_type(llvm, (ir_type_t*) instr->extra));
+                        catalog.value_references[i] = LLVMConstInt(LLVMInt64TypeInContext(llvm->context), type_size, false);
                     }
                     break;
                 case INSTRUCTION_OFFSETOF: {
-                    instr = basicblock->instructions[i];
-                    unsigned long long offset = LLVMOffsetOfElement(llvm->data_layout, ir_to_llvm_type(((ir_instr_offsetof_t*) instr)->type), ((ir_instr_offsetof_t*) instr)->index);
-                    catalog.blocks[b].value_references[i] = LLVMConstInt(LLVMInt64Type(), offset, false);;
+                    unsigned long long offset = LLVMOffsetOfElement(llvm->data_layout, ir_to_llvm_type(llvm, (ir_type_t*) instr->extra), instr->details[0]);
+                    catalog.value_references[i] = LLVMConstInt(LLVMInt64TypeInContext(llvm->context), offset, false);;
                     break;
                 }
                 case INSTRUCTION_VARZEROINIT: {
-                        instr = basicblock->instructions[i];
-                        LLVMValueRef var_to_init = llvm->stack->values[((ir_instr_varzeroinit_t*) instr)->index];
-                        LLVMTypeRef var_type = llvm->stack->types[((ir_instr_varzeroinit_t*) instr)->index];
+                        LLVMValueRef var_to_init = llvm->stack->values[instr->details[0]];
+                        LLVMTypeRef var_type = llvm->stack->types[instr->details[0]];
                         LLVMBuildStore(builder, LLVMConstNull(var_type), var_to_init);
                     }
                     break;
                 case INSTRUCTION_MALLOC: {
-                        instr = basicblock->instructions[i];
-                        if( ((ir_instr_malloc_t*) instr)->amount == NULL ){
-                            catalog.blocks[b].value_references[i] = LLVMBuildMalloc(builder, ir_to_llvm_type(((ir_instr_malloc_t*) instr)->type), "");
+                        if(IR_FLAT_OPERAND_KIND(operands[0]) == IR_FLAT_OPERAND_NONE){
+                            catalog.value_references[i] = LLVMBuildMalloc(builder, ir_to_llvm_type(llvm, (ir_type_t*) instr->extra), "");
                         } else {
-                            catalog.blocks[b].value_references[i] = LLVMBuildArrayMalloc(builder,
-                                ir_to_llvm_type(((ir_instr_malloc_t*) instr)->type), ir_to_llvm_value(llvm, ((ir_instr_malloc_t*) instr)->amount), "");
+                            catalog.value_references[i] = LLVMBuildArrayMalloc(builder,
+                                ir_to_llvm_type(llvm, (ir_type_t*) instr->extra), ir_to_llvm_operand(llvm, flat, operands[0]), "");
                         }
                     }
                     break;
                 case INSTRUCTION_FREE: {
-                        instr = basicblock->instructions[i];
-                        catalog.blocks[b].value_references[i] = LLVMBuildFree(builder, ir_to_llvm_value(llvm, ((ir_instr_free_t*) instr)->value));
+                        catalog.value_references[i] = LLVMBuildFree(builder, ir_to_llvm_operand(llvm, flat, operands[0]));
                     }
                     break;
                 case INSTRUCTION_MEMCPY: {
-                        instr = basicblock->instructions[i];
 
                         LLVMValueRef *memcpy_intrinsic = &llvm->memcpy_intrinsic;
 
                         if(*memcpy_intrinsic == NULL){
                             LLVMTypeRef arg_types[4];
-                            arg_types[0] = LLVMPointerType(LLVMInt8Type(), 0);
-                            arg_types[1] = LLVMPointerType(LLVMInt8Type(), 0);
-                            arg_types[2] = LLVMInt64Type();
-                            arg_types[3] = LLVMInt1Type();
+                            arg_types[0] = LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0);
+                            arg_types[1] = LLVMPointerType(LLVMInt8TypeInContext(llvm->context), 0);
+                            arg_types[2] = LLVMInt64TypeInContext(llvm->context);
+                            arg_types[3] = LLVMInt1TypeInContext(llvm->context);
 
-                            LLVMTypeRef memcpy_intrinsic_type = LLVMFunctionType(LLVMVoidType(), arg_types, 4, 0);
+                            LLVMTypeRef memcpy_intrinsic_type = LLVMFunctionType(LLVMVoidTypeInContext(llvm->context), arg_types, 4, 0);
                             *memcpy_intrinsic = LLVMAddFunction(llvm->module, "llvm.memcpy.p0i8.p0i8.i64", memcpy_intrinsic_type);
                         }
 
                         LLVMValueRef args[4];
-                        args[0] = ir_to_llvm_value(llvm, ((ir_instr_memcpy_t*) instr)->destination);
-                        args[1] = ir_to_llvm_value(llvm, ((ir_instr_memcpy_t*) instr)->value);
-                        args[2] = ir_to_llvm_value(llvm, ((ir_instr_memcpy_t*) instr)->bytes);
-                        args[3] = LLVMConstInt(LLVMInt1Type(), ((ir_instr_memcpy_t*) instr)->is_volatile, false);
+                        args[0] = ir_to_llvm_operand(llvm, flat, operands[0]);
+                        args[1] = ir_to_llvm_operand(llvm, flat, operands[1]);
+                        args[2] = ir_to_llvm_operand(llvm, flat, operands[2]);
+                        args[3] = LLVMConstInt(LLVMInt1TypeInContext(llvm->context), instr->details[0], false);
 
                         LLVMBuildCall(builder, *memcpy_intrinsic, args, 4, "");
-                        catalog.blocks[b].value_references[i] = NULL;
+                        catalog.value_references[i] = NULL;
                     }
                     break;
                 case INSTRUCTION_BIT_XOR:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildXor(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildXor(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_BIT_LSHIFT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildShl(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildShl(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_BIT_RSHIFT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildAShr(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildAShr(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_BIT_LGC_RSHIFT:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildLShr(builder, ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->a), ir_to_llvm_value(llvm, ((ir_instr_math_t*) instr)->b), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildLShr(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
                     break;
                 case INSTRUCTION_BIT_COMPLEMENT: {
-                        instr = basicblock->instructions[i];
 
-                        unsigned int type_kind = ((ir_instr_unary_t*) instr)->value->type->kind;
-                        LLVMValueRef base = ir_to_llvm_value(llvm, ((ir_instr_unary_t*) instr)->value);
+                        unsigned int type_kind = ir_flat_operand_type(flat, operands[0])->kind;
+                        LLVMValueRef base = ir_to_llvm_operand(llvm, flat, operands[0]);
                         
                         unsigned int bits = global_type_kind_sizes_64[type_kind];
-                        LLVMValueRef transform = LLVMConstInt(LLVMIntType(bits), ~0, global_type_kind_signs[type_kind]);
+                        LLVMValueRef transform = LLVMConstInt(LLVMIntTypeInContext(llvm->context, bits), ~0, global_type_kind_signs[type_kind]);
 
                         llvm_result = LLVMBuildXor(builder, base, transform, "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
                 case INSTRUCTION_NEGATE: {
-                        instr = basicblock->instructions[i];
-                        LLVMValueRef base = ir_to_llvm_value(llvm, ((ir_instr_unary_t*) instr)->value);
+                        LLVMValueRef base = ir_to_llvm_operand(llvm, flat, operands[0]);
                         LLVMValueRef zero = LLVMConstNull(LLVMTypeOf(base));
-                        instr = basicblock->instructions[i];
                         llvm_result = LLVMBuildSub(builder, zero, base, "");
-                        catalog.blocks[b].value_references[i] = llvm_result;
+                        catalog.value_references[i] = llvm_result;
+                    }
+                    break;
+                case INSTRUCTION_PTR_ADD:
+                case INSTRUCTION_PTR_SUBTRACT: {
+                        ir_type_t *offset_type = ir_flat_operand_type(flat, operands[1]);
+                        LLVMValueRef pointer = ir_to_llvm_operand(llvm, flat, operands[0]);
+                        LLVMValueRef offset = ir_to_llvm_operand(llvm, flat, operands[1]);
+
+                        // GEP indices are always treated as signed, so widen the offset according to its own signedness
+                        if(global_type_kind_sizes_64[offset_type->kind] < 64){
+                            offset = global_type_kind_signs[offset_type->kind]
+                                ? LLVMBuildSExt(builder, offset, LLVMInt64TypeInContext(llvm->context), "")
+                                : LLVMBuildZExt(builder, offset, LLVMInt64TypeInContext(llvm->context), "");
+                        }
+
+                        if(instr->id == INSTRUCTION_PTR_SUBTRACT) offset = LLVMBuildNeg(builder, offset, "");
+
+                        llvm_result = LLVMBuildGEP(builder, pointer, &offset, 1, "");
+                        catalog.value_references[i] = llvm_result;
                     }
                     break;
+                case INSTRUCTION_PTR_DIFFERENCE:
+                    llvm_result = LLVMBuildPtrDiff(builder, ir_to_llvm_operand(llvm, flat, operands[0]), ir_to_llvm_operand(llvm, flat, operands[1]), "");
+                    catalog.value_references[i] = llvm_result;
+                    break;
                 case INSTRUCTION_FNEGATE:
-                    instr = basicblock->instructions[i];
-                    llvm_result = LLVMBuildFNeg(builder, ir_to_llvm_value(llvm, ((ir_instr_unary_t*) instr)->value), "");
-                    catalog.blocks[b].value_references[i] = llvm_result;
+                    llvm_result = LLVMBuildFNeg(builder, ir_to_llvm_operand(llvm, flat, operands[0]), "");
+                    ir_to_llvm_fast_math(llvm, llvm_result);
+                    catalog.value_references[i] = llvm_result;
                     break;
                 default:
-                    redprintf("INTERNAL ERROR: Unexpected instruction '%d' when exporting ir to llvm\n", basicblocks[b].instructions[i]->id);
-                    for(length_t c = 0; c != catalog.blocks_length; c++) free(catalog.blocks[c].value_references);
+                    redprintf("INTERNAL ERROR: Unexpected instruction '%d' when exporting ir to llvm\n", instr->id);
+                    free(catalog.value_references);
                     free(catalog.blocks);
                     free(stack.values);
                     free(stack.types);
@@ -872,7 +1060,7 @@ errorcode_t ir_to_llvm_function_bodies(llvm_context_t *llvm, object_t *object){
             }
         }
 
-        for(length_t c = 0; c != catalog.blocks_length; c++) free(catalog.blocks[c].value_references);
+        free(catalog.value_references);
         free(catalog.blocks);
         free(stack.values);
         free(stack.types);
@@ -892,32 +1080,66 @@ errorcode_t ir_to_llvm_globals(llvm_context_t *llvm, object_t *object){
     LLVMModuleRef module = llvm->module;
     char global_implementation_name[256];
 
+    // NOTE: When split into multiple partitions, every partition refers
+    // to the globals that are defined in the first partition
+    bool is_partitioned = llvm->partition->count > 1;
+    bool defines_globals = llvm->partition->index == 0;
+
     for(length_t i = 0; i != globals_length; i++){
         bool is_external = globals[i].traits & IR_GLOBAL_EXTERNAL;
-        LLVMTypeRef global_llvm_type = ir_to_llvm_type(globals[i].type);
+        LLVMTypeRef global_llvm_type = ir_to_llvm_type(llvm, globals[i].type);
 
-        if(is_external)
+        if(!is_external)
             sprintf(global_implementation_name, "adeptglob_%X", (int) i);
 
         llvm->global_variables[i] = LLVMAddGlobal(module, global_llvm_type, is_external ? globals[i].name : global_implementation_name);
         LLVMSetLinkage(llvm->global_variables[i], LLVMExternalLinkage);
 
-        if(!is_external)
-            LLVMSetInitializer(llvm->global_variables[i], LLVMGetUndef(global_llvm_type));
+        // Globals with initial values known at compile time are never modified
+        // unless they are referenced as mutable values
+        if(!is_external && globals[i].static_initializer != NULL && !(globals[i].traits & IR_GLOBAL_MUTABLE))
+            LLVMSetGlobalConstant(llvm->global_variables[i], true);
     }
 
     for(length_t i = 0; i != anon_globals_length; i++){
-        LLVMTypeRef anon_global_llvm_type = ir_to_llvm_type(anon_globals[i].type);
-        llvm->anon_global_variables[i] = LLVMAddGlobal(module, anon_global_llvm_type, "");
-        LLVMSetLinkage(llvm->anon_global_variables[i], LLVMInternalLinkage);
-        LLVMSetGlobalConstant(llvm->anon_global_variables[i], anon_globals[i].traits & IR_ANON_GLOBAL_CONSTANT);
+        LLVMTypeRef anon_global_llvm_type = ir_to_llvm_type(llvm, anon_globals[i].type);
+        bool is_constant = anon_globals[i].traits & IR_ANON_GLOBAL_CONSTANT;
+
+        if(is_partitioned && !is_constant){
+            // Mutable anonymous globals must be shared between partitions, so give them
+            // names that are hidden from anything outside of the final executable
+            sprintf(global_implementation_name, "adeptanon_%X", (int) i);
+            llvm->anon_global_variables[i] = LLVMAddGlobal(module, anon_global_llvm_type, global_implementation_name);
+            LLVMSetLinkage(llvm->anon_global_variables[i], LLVMExternalLinkage);
+            LLVMSetVisibility(llvm->anon_global_variables[i], LLVMHiddenVisibility);
+        } else {
+            // Constant anonymous globals are instead defined by each partition that uses them
+            llvm->anon_global_variables[i] = LLVMAddGlobal(module, anon_global_llvm_type, "");
+            LLVMSetLinkage(llvm->anon_global_variables[i], LLVMInternalLinkage);
+        }
+
+        LLVMSetGlobalConstant(llvm->anon_global_variables[i], is_constant);
     }
 
     for(length_t i = 0; i != anon_globals_length; i++){
         if(anon_globals[i].initializer == NULL) continue;
+        if(!defines_globals && !(anon_globals[i].traits & IR_ANON_GLOBAL_CONSTANT)) continue;
         LLVMSetInitializer(llvm->anon_global_variables[i], ir_to_llvm_value(llvm, anon_globals[i].initializer));
     }
 
+    // NOTE: Static initializers can refer to anonymous globals, so they are set afterwards
+    for(length_t i = 0; i != globals_length; i++){
+        if(globals[i].traits & IR_GLOBAL_EXTERNAL || !defines_globals) continue;
+
+        // NOTE: Globals are always zero initialized, even when declared as 'undef' (see examples/undef).
+        // An LLVM 'undef' initializer doesn't promise zero, and once the optimization pipeline
+        // runs, LLVM is free to fold loads of such a global into any value it likes
+        ir_value_t *static_initializer = globals[i].static_initializer;
+        LLVMSetInitializer(llvm->global_variables[i], static_initializer
+            ? ir_to_llvm_value(llvm, static_initializer)
+            : LLVMConstNull(ir_to_llvm_type(llvm, globals[i].type)));
+    }
+
     return SUCCESS;
 }
 
@@ -929,12 +1151,6 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     LLVMInitializeAllAsmPrinters();
 
     ir_module_t *module = &object->ir_module;
-    llvm_context_t llvm;
-
-    llvm.module = LLVMModuleCreateWithName(filename_name_const(object->filename));
-    llvm.memcpy_intrinsic = NULL;
-    llvm.compiler = compiler;
-
     bool disposeTriple = false;
 
 	#ifdef _WIN32
@@ -943,7 +1159,6 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
 	char *triple = LLVMGetDefaultTargetTriple();
     disposeTriple = true;
 	#endif
-    LLVMSetTarget(llvm.module, triple);
 
     char *error_message; LLVMTargetRef target;
     if(LLVMGetTargetFromTriple(triple, &target, &error_message)){
@@ -960,47 +1175,148 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
 	// Automatically add proper extension if missing
     filename_auto_ext(&compiler->output_filename, FILENAME_AUTO_EXECUTABLE);
 
-    char* object_filename = filename_ext(compiler->output_filename, "o");
+    // Resolve 'native' to the name and features of the host CPU
+    if(compiler->target_cpu != NULL && strcmp(compiler->target_cpu, "native") == 0){
+        #if LLVM_VERSION_MAJOR < 7
+        // The host CPU can't be queried through the C API before LLVM 7
+        redprintf("--march=native is unsupported when Adept is built with LLVM versions older than 7\n");
+        if(disposeTriple) LLVMDisposeMessage(triple);
+        return FAILURE;
+        #else
+        char *host_cpu = LLVMGetHostCPUName();
+        free(compiler->target_cpu);
+        compiler->target_cpu = strclone(host_cpu);
+        LLVMDisposeMessage(host_cpu);
+
+        if(compiler->target_features == NULL){
+            char *host_features = LLVMGetHostCPUFeatures();
+            compiler->target_features = strclone(host_features);
+            LLVMDisposeMessage(host_features);
+        }
+        #endif
+    }
 
-    char *cpu = "generic";
-    char *features = "";
+    char *cpu = compiler->target_cpu ? compiler->target_cpu : "generic";
+    char *features = compiler->target_features ? compiler->target_features : "";
     LLVMCodeGenOptLevel level = ir_to_llvm_config_optlvl(compiler);
     LLVMRelocMode reloc = LLVMRelocDefault;
     LLVMCodeModel code_model = LLVMCodeModelDefault;
-    LLVMTargetMachineRef target_machine = LLVMCreateTargetMachine(target, triple, cpu, features, level, reloc, code_model);
 
-    LLVMTargetDataRef data_layout = LLVMCreateTargetDataLayout(target_machine);
-    LLVMSetModuleDataLayout(llvm.module, data_layout);
-    llvm.data_layout = data_layout;
+    if(compiler->traits & COMPILER_JIT){
+        // Programs executed in-process are lowered into a single module and never touch the disk
+        llvm_partition_t partition;
+        partition.compiler = compiler;
+        partition.object = object;
+        partition.triple = triple;
+        partition.target_machine = LLVMCreateTargetMachine(target, triple, cpu, features, level, reloc, code_model);
+        partition.index = 0;
+        partition.count = 1;
+        partition.funcs_begin = 0;
+        partition.funcs_end = module->funcs_length;
+        partition.object_filename = NULL;
+        partition.object_fd = -1;
+        partition.result = ir_to_llvm_jit(&partition);
+
+        LLVMDisposeTargetMachine(partition.target_machine);
+        if(disposeTriple) LLVMDisposeMessage(triple);
+        return partition.result;
+    }
 
-    llvm.func_skeletons = malloc(sizeof(LLVMValueRef) * module->funcs_length);
-    llvm.global_variables = malloc(sizeof(LLVMValueRef) * module->globals_length);
-    llvm.anon_global_variables = malloc(sizeof(LLVMValueRef) * module->anon_globals_length);
+    // Never create more partitions than there are functions
+    length_t partitions_count = compiler->jobs;
+    if(partitions_count > module->funcs_length) partitions_count = module->funcs_length;
+    if(partitions_count == 0) partitions_count = 1;
+
+    llvm_partition_t *partitions = malloc(sizeof(llvm_partition_t) * partitions_count);
+    ir_to_llvm_split_partitions(partitions, partitions_count, module);
+
+    for(length_t p = 0; p != partitions_count; p++){
+        llvm_partition_t *partition = &partitions[p];
+        partition->compiler = compiler;
+        partition->object = object;
+        partition->triple = triple;
+        partition->index = p;
+        partition->count = partitions_count;
+        partition->result = FAILURE;
+
+        // Each partition needs its own target machine, since they can't be shared between threads
+        partition->target_machine = LLVMCreateTargetMachine(target, triple, cpu, features, level, reloc, code_model);
+
+        partition->object_fd = -1;
+
+        #ifndef _WIN32
+        // Unless the object files are to be preserved, they only ever
+        // live in temporary files that are handed straight to the linker
+        if(!(compiler->traits & COMPILER_NO_REMOVE_OBJECT)){
+            partition->object_filename = ir_to_llvm_temporary_object(&partition->object_fd);
+            if(partition->object_fd != -1) continue;
+            free(partition->object_filename);
+        }
+        #endif
 
-    if(ir_to_llvm_globals(&llvm, object) || ir_to_llvm_functions(&llvm, object)
-    || ir_to_llvm_function_bodies(&llvm, object)){
-        free(object_filename);
-        free(llvm.func_skeletons);
-        free(llvm.global_variables);
-        free(llvm.anon_global_variables);
-        LLVMDisposeTargetMachine(target_machine);
-        return FAILURE;
+        if(partitions_count == 1){
+            partition->object_filename = filename_ext(compiler->output_filename, "o");
+        } else {
+            char partition_ext[32];
+            sprintf(partition_ext, "%d.o", (int) p);
+            partition->object_filename = filename_ext(compiler->output_filename, partition_ext);
+        }
     }
 
-    #ifdef ENABLE_DEBUG_FEATURES
-    if(compiler->debug_traits & COMPILER_DEBUG_LLVMIR) LLVMDumpModule(llvm.module);
-    #endif // ENABLE_DEBUG_FEATURES
+    #ifdef TRACK_MEMORY_USAGE
+    // The memory usage tracker isn't thread-safe, so lower partitions one after another
+    for(length_t p = 0; p != partitions_count; p++){
+        partitions[p].result = ir_to_llvm_partition(&partitions[p]);
+    }
+    #else
+    if(partitions_count == 1){
+        partitions[0].result = ir_to_llvm_partition(&partitions[0]);
+    } else {
+        pthread_t *threads = malloc(sizeof(pthread_t) * partitions_count);
+        bool *threads_started = malloc(sizeof(bool) * partitions_count);
+
+        for(length_t p = 0; p != partitions_count; p++){
+            threads_started[p] = pthread_create(&threads[p], NULL, ir_to_llvm_partition_thread, &partitions[p]) == 0;
+
+            // Fallback to lowering the partition on this thread if a new thread can't be created
+            if(!threads_started[p]) partitions[p].result = ir_to_llvm_partition(&partitions[p]);
+        }
 
-    // Free reference arrays
-    free(llvm.func_skeletons);
-    free(llvm.global_variables);
-    free(llvm.anon_global_variables);
+        for(length_t p = 0; p != partitions_count; p++){
+            if(threads_started[p]) pthread_join(threads[p], NULL);
+        }
+
+        free(threads);
+        free(threads_started);
+    }
+    #endif // TRACK_MEMORY_USAGE
+
+    errorcode_t codegen_result = SUCCESS;
+
+    for(length_t p = 0; p != partitions_count; p++){
+        LLVMDisposeTargetMachine(partitions[p].target_machine);
+        if(partitions[p].result != SUCCESS) codegen_result = FAILURE;
+    }
+
+    if(disposeTriple) LLVMDisposeMessage(triple);
+
+    if(codegen_result != SUCCESS){
+        for(length_t p = 0; p != partitions_count; p++){
+            if(!(compiler->traits & COMPILER_NO_REMOVE_OBJECT)) remove(partitions[p].object_filename);
+            free(partitions[p].object_filename);
+        }
+        free(partitions);
+        return FAILURE;
+    }
 
+    errorcode_t link_result;
+
+	#ifdef _WIN32
+	// Windows Linkering
     const char *root = compiler->root;
     length_t root_length = strlen(root);
 
-	char *link_command; // Will be determined based on system
-
+	char *link_command;
     char *linker_additional = "";
     length_t linker_additional_length = 0;
     length_t linker_additional_index = 0;
@@ -1026,8 +1342,24 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
         linker_additional[linker_additional_index] = '\0';
     }
 
-	#ifdef _WIN32
-	// Windows Linkering
+    // Object files in partition order, each as ' "filename"'
+    length_t object_filenames_length = 0;
+    length_t object_filenames_index = 0;
+
+    for(length_t p = 0; p != partitions_count; p++)
+        object_filenames_length += strlen(partitions[p].object_filename) + 3;
+
+    char *object_filenames = malloc(object_filenames_length + 1);
+    for(length_t p = 0; p != partitions_count; p++){
+        length_t filename_length = strlen(partitions[p].object_filename);
+        object_filenames[object_filenames_index++] = ' ';
+        object_filenames[object_filenames_index++] = '\"';
+        memcpy(&object_filenames[object_filenames_index], partitions[p].object_filename, filename_length);
+        object_filenames_index += filename_length;
+        object_filenames[object_filenames_index++] = '\"';
+    }
+    object_filenames[object_filenames_index] = '\0';
+
     // TODO: SECURITY: Stop using system(3) call to invoke linker
     const char *linker = "ld.exe"; // May need to change depending on system etc.
     length_t linker_length = strlen(linker);
@@ -1036,72 +1368,344 @@ errorcode_t ir_to_llvm(compiler_t *compiler, object_t *object){
     length_t linker_options_length = strlen(linker_options);
 
     // linker + " \"" + object_filename + "\" -o " + compiler->output_filename + "\""
-    link_command = malloc(linker_length + root_length * 18 + 14 + linker_options_length + linker_additional_length + 2 + strlen(object_filename) + 59 + strlen(compiler->output_filename) + 2);
-    sprintf(link_command, "\"\"%s%s\" -static \"%scrt2.o\" \"%scrtbegin.o\" %s%s \"%s\" \"%slibdep.a\" C:/Windows/System32/msvcrt.dll -o \"%s\"\"", root, linker, root, root, linker_options, linker_additional, object_filename, root, compiler->output_filename);
+    link_command = malloc(linker_length + root_length * 18 + 14 + linker_options_length + linker_additional_length + 2 + object_filenames_length + 59 + strlen(compiler->output_filename) + 2);
+    sprintf(link_command, "\"\"%s%s\" -static \"%scrt2.o\" \"%scrtbegin.o\" %s%s%s \"%slibdep.a\" C:/Windows/System32/msvcrt.dll -o \"%s\"\"", root, linker, root, root, linker_options, linker_additional, object_filenames, root, compiler->output_filename);
+
+    if(linker_additional_length != 0) free(linker_additional);
+    free(object_filenames);
+
+    link_result = system(link_command) == 0 ? SUCCESS : FAILURE;
+
+    if(link_result != SUCCESS){
+        redprintf("EXTERNAL ERROR: link command failed\n%s\n", link_command);
+    } else if(compiler->traits & COMPILER_EXECUTE_RESULT){
+        /* For windows, make sure we change all '/' to '\' before invoking */
+        char *execute_filename = strclone(compiler->output_filename);
+        length_t execute_filename_length = strlen(execute_filename);
+
+        for(length_t i = 0; i != execute_filename_length; i++)
+            if(execute_filename[i] == '/') execute_filename[i] = '\\';
+
+        compiler->execute_result = system(execute_filename);
+        free(execute_filename);
+    }
+
+    free(link_command);
 	#else
 	// UNIX Linkering
-	
+    // linker object_filenames... libraries... -o output_filename
     const char *linker = "gcc"; // May need to change depending on system etc.
-    length_t linker_length = strlen(linker);
-	
-	link_command = malloc(linker_length + root_length * 18 + 14 + 2 + strlen(object_filename) + 59 + strlen(compiler->output_filename) + 2);
+    length_t link_argc = 0;
+    char **link_argv = malloc(sizeof(char*) * (partitions_count + object->ast.libraries_length * 2 + 4));
+
+    link_argv[link_argc++] = (char*) linker;
+
+    for(length_t p = 0; p != partitions_count; p++)
+        link_argv[link_argc++] = partitions[p].object_filename;
 
-    sprintf(link_command, "%s \"%s\"%s -o \"%s\"", linker, object_filename, linker_additional, compiler->output_filename);
+    for(length_t i = 0; i != object->ast.libraries_length; i++){
+        if(object->ast.libraries_are_framework[i]) link_argv[link_argc++] = "-framework";
+        link_argv[link_argc++] = object->ast.libraries[i];
+    }
+
+    link_argv[link_argc++] = "-o";
+    link_argv[link_argc++] = compiler->output_filename;
+    link_argv[link_argc] = NULL;
+
+    link_result = ir_to_llvm_run_program(link_argv);
+
+    if(link_result != SUCCESS){
+        length_t link_command_length = 0;
+        for(length_t i = 0; i != link_argc; i++) link_command_length += strlen(link_argv[i]) + 1;
+
+        char *link_command = malloc(link_command_length + 1);
+        link_command[0] = '\0';
+
+        for(length_t i = 0; i != link_argc; i++){
+            if(i != 0) strcat(link_command, " ");
+            strcat(link_command, link_argv[i]);
+        }
+
+        redprintf("EXTERNAL ERROR: link command failed\n%s\n", link_command);
+        free(link_command);
+    } else if(compiler->traits & COMPILER_EXECUTE_RESULT){
+		char *executable = strclone(compiler->output_filename);
+		filename_prepend_dotslash_if_needed(&executable);
+
+        char *execute_argv[] = {executable, NULL};
+        compiler->execute_result = ir_to_llvm_execute_program(execute_argv);
+		free(executable);
+    }
+
+    free(link_argv);
 	#endif
 
-    if(linker_additional_length != 0) free(linker_additional);
+    for(length_t p = 0; p != partitions_count; p++){
+        if(!(compiler->traits & COMPILER_NO_REMOVE_OBJECT)) remove(partitions[p].object_filename);
+        free(partitions[p].object_filename);
+    }
+
+    free(partitions);
+    return link_result;
+}
+
+errorcode_t ir_to_llvm_lower_partition(llvm_partition_t *partition, LLVMContextRef *out_context, LLVMModuleRef *out_module){
+    compiler_t *compiler = partition->compiler;
+    object_t *object = partition->object;
+    ir_module_t *module = &object->ir_module;
+    llvm_context_t llvm;
+
+    llvm.context = LLVMContextCreate();
+    llvm.module = LLVMModuleCreateWithNameInContext(filename_name_const(object->filename), llvm.context);
+    llvm.memcpy_intrinsic = NULL;
+    llvm.compiler = compiler;
+    llvm.partition = partition;
+    llvm_type_cache_init(&llvm.type_cache);
+
+    LLVMSetTarget(llvm.module, partition->triple);
+
+    LLVMTargetDataRef data_layout = LLVMCreateTargetDataLayout(partition->target_machine);
+    LLVMSetModuleDataLayout(llvm.module, data_layout);
+    llvm.data_layout = data_layout;
+
+    llvm.func_skeletons = malloc(sizeof(LLVMValueRef) * module->funcs_length);
+    llvm.global_variables = malloc(sizeof(LLVMValueRef) * module->globals_length);
+    llvm.anon_global_variables = malloc(sizeof(LLVMValueRef) * module->anon_globals_length);
+    ir_to_llvm_debug_init(&llvm, object);
+
+    errorcode_t result = SUCCESS;
+
+    if(ir_to_llvm_struct_types(&llvm, object) || ir_to_llvm_globals(&llvm, object)
+    || ir_to_llvm_functions(&llvm, object) || ir_to_llvm_function_bodies(&llvm, object)){
+        result = FAILURE;
+    }
+
+    ir_to_llvm_debug_finalize(&llvm);
+
+    // Free reference arrays
+    free(llvm.func_skeletons);
+    free(llvm.global_variables);
+    free(llvm.anon_global_variables);
+    llvm_type_cache_free(&llvm.type_cache);
+    LLVMDisposeTargetData(data_layout);
+
+    if(result != SUCCESS){
+        LLVMDisposeModule(llvm.module);
+        LLVMContextDispose(llvm.context);
+        return FAILURE;
+    }
 
     #ifdef ENABLE_DEBUG_FEATURES
-    if(!(llvm.compiler->debug_traits & COMPILER_DEBUG_NO_VERIFICATION) && LLVMVerifyModule(llvm.module, LLVMPrintMessageAction, NULL) == 1){
+    if(compiler->debug_traits & COMPILER_DEBUG_LLVMIR) LLVMDumpModule(llvm.module);
+
+    if(!(compiler->debug_traits & COMPILER_DEBUG_NO_VERIFICATION) && LLVMVerifyModule(llvm.module, LLVMPrintMessageAction, NULL) == 1){
         yellowprintf("\n========== LLVM Verification Failed! ==========\n");
     }
     #endif
 
-    LLVMPassManagerRef pass_manager = LLVMCreatePassManager();
-    LLVMCodeGenFileType codegen = LLVMObjectFile;
+    // Run IR-level optimizations before any machine code is generated
+    ir_to_llvm_optimize(compiler, llvm.module, partition->target_machine);
 
-    if(LLVMTargetMachineEmitToFile(target_machine, llvm.module, object_filename, codegen, &error_message)){
-        redprintf("INTERNAL ERROR: LLVMTargetMachineEmitToFile failed: %s\n", error_message);
-        LLVMDisposeTargetMachine(target_machine);
+    *out_context = llvm.context;
+    *out_module = llvm.module;
+    return SUCCESS;
+}
+
+errorcode_t ir_to_llvm_partition(llvm_partition_t *partition){
+    LLVMContextRef context;
+    LLVMModuleRef module;
+    errorcode_t result = ir_to_llvm_lower_partition(partition, &context, &module);
+
+    if(result == SUCCESS){
+        char *error_message;
+        LLVMMemoryBufferRef object_buffer;
+
+        if(partition->object_fd == -1){
+            if(LLVMTargetMachineEmitToFile(partition->target_machine, module, partition->object_filename, LLVMObjectFile, &error_message)){
+                redprintf("INTERNAL ERROR: LLVMTargetMachineEmitToFile failed: %s\n", error_message);
+                LLVMDisposeMessage(error_message);
+                result = FAILURE;
+            }
+        } else if(LLVMTargetMachineEmitToMemoryBuffer(partition->target_machine, module, LLVMObjectFile, &error_message, &object_buffer)){
+            redprintf("INTERNAL ERROR: LLVMTargetMachineEmitToMemoryBuffer failed: %s\n", error_message);
+            LLVMDisposeMessage(error_message);
+            result = FAILURE;
+        } else {
+            const char *object_data = LLVMGetBufferStart(object_buffer);
+            size_t object_size = LLVMGetBufferSize(object_buffer);
+
+            while(object_size != 0){
+                ssize_t written = write(partition->object_fd, object_data, object_size);
+
+                if(written <= 0){
+                    redprintf("INTERNAL ERROR: Failed to write object file '%s'\n", partition->object_filename);
+                    result = FAILURE;
+                    break;
+                }
+
+                object_data += written;
+                object_size -= written;
+            }
+
+            LLVMDisposeMemoryBuffer(object_buffer);
+        }
+
+        LLVMDisposeModule(module);
+        LLVMContextDispose(context);
+    }
+
+    if(partition->object_fd != -1){
+        close(partition->object_fd);
+        partition->object_fd = -1;
+    }
+
+    return result;
+}
+
+errorcode_t ir_to_llvm_jit(llvm_partition_t *partition){
+    LLVMContextRef context;
+    LLVMModuleRef module;
+    object_t *object = partition->object;
+
+    if(ir_to_llvm_lower_partition(partition, &context, &module)) return FAILURE;
+
+    LLVMLinkInMCJIT();
+
+    // Foreign symbols are resolved from the compiler process itself (e.g. libc)
+    // and from any foreign libraries that the program links against
+    LLVMLoadLibraryPermanently(NULL);
+
+    for(length_t i = 0; i != object->ast.libraries_length; i++){
+        if(LLVMLoadLibraryPermanently(object->ast.libraries[i])){
+            redprintf("Failed to load foreign library '%s' for JIT execution\n", object->ast.libraries[i]);
+            LLVMDisposeModule(module);
+            LLVMContextDispose(context);
+            return FAILURE;
+        }
+    }
+
+    struct LLVMMCJITCompilerOptions options;
+    LLVMInitializeMCJITCompilerOptions(&options, sizeof(options));
+    options.OptLevel = partition->compiler->optimization;
+
+    char *error_message;
+    LLVMExecutionEngineRef engine;
+
+    // NOTE: The execution engine takes ownership of the module
+    if(LLVMCreateMCJITCompilerForModule(&engine, module, &options, sizeof(options), &error_message)){
+        redprintf("INTERNAL ERROR: LLVMCreateMCJITCompilerForModule failed: %s\n", error_message);
         LLVMDisposeMessage(error_message);
-        free(object_filename);
+        LLVMDisposeModule(module);
+        LLVMContextDispose(context);
+        return FAILURE;
     }
 
-    LLVMRunPassManager(pass_manager, llvm.module);
-    LLVMDisposeTargetMachine(target_machine);
-    LLVMDisposePassManager(pass_manager);
-    if(disposeTriple) LLVMDisposeMessage(triple);
+    LLVMValueRef main_func = LLVMGetNamedFunction(module, "main");
 
-    if(system(link_command) != 0){
-        redprintf("EXTERNAL ERROR: link command failed\n%s\n", link_command);
-        free(object_filename);
-        free(link_command);
+    if(main_func == NULL || LLVMIsDeclaration(main_func)){
+        redprintf("Can't JIT execute program without a 'main' function\n");
+        LLVMDisposeExecutionEngine(engine);
+        LLVMContextDispose(context);
         return FAILURE;
     }
 
-    if(compiler->traits & COMPILER_EXECUTE_RESULT){
-        #ifdef _WIN32
-        /* For windows, make sure we change all '/' to '\' before invoking */
-        char *execute_filename = strclone(compiler->output_filename);
-        length_t execute_filename_length = strlen(execute_filename);
+    // Pretend to be the executable that would've been created
+    char *executable = strclone(partition->compiler->output_filename);
+    filename_prepend_dotslash_if_needed(&executable);
 
-        for(length_t i = 0; i != execute_filename_length; i++)
-            if(execute_filename[i] == '/') execute_filename[i] = '\\';
+    const char *argv[] = {executable, NULL};
+    const char *envp[] = {NULL};
+    partition->compiler->execute_result = LLVMRunFunctionAsMain(engine, main_func, 1, argv, envp);
+    free(executable);
 
-        system(execute_filename);
-        free(execute_filename);
-        #else
-		char *executable = strclone(compiler->output_filename);
-		filename_prepend_dotslash_if_needed(&executable);
-        system(executable);
-		free(executable);
-        #endif
+    LLVMDisposeExecutionEngine(engine);
+    LLVMContextDispose(context);
+    return SUCCESS;
+}
+
+void *ir_to_llvm_partition_thread(void *partition){
+    ((llvm_partition_t*) partition)->result = ir_to_llvm_partition((llvm_partition_t*) partition);
+    return NULL;
+}
+
+#ifndef _WIN32
+char *ir_to_llvm_temporary_object(int *out_fd){
+    const char *directory = getenv("TMPDIR");
+    if(directory == NULL || directory[0] == '\0') directory = "/tmp";
+
+    char *filename = malloc(strlen(directory) + 18);
+    sprintf(filename, "%s/adept-XXXXXX.o", directory);
+
+    *out_fd = mkstemps(filename, 2);
+    return filename;
+}
+
+errorcode_t ir_to_llvm_run_program(char **argv){
+    extern char **environ;
+    pid_t pid;
+    int status;
+
+    if(posix_spawnp(&pid, argv[0], NULL, NULL, argv, environ) != 0) return FAILURE;
+
+    while(waitpid(pid, &status, 0) == -1){
+        if(errno != EINTR) return FAILURE;
     }
 
-    if(!(compiler->traits & COMPILER_NO_REMOVE_OBJECT)) remove(object_filename);
-    free(object_filename);
-    free(link_command);
-    return SUCCESS;
+    return WIFEXITED(status) && WEXITSTATUS(status) == 0 ? SUCCESS : FAILURE;
+}
+
+int ir_to_llvm_execute_program(char **argv){
+    extern char **environ;
+    pid_t pid;
+    int status;
+
+    if(posix_spawnp(&pid, argv[0], NULL, NULL, argv, environ) != 0){
+        redprintf("Failed to execute '%s'\n", argv[0]);
+        return 127;
+    }
+
+    while(waitpid(pid, &status, 0) == -1){
+        if(errno != EINTR){
+            redprintf("Failed to wait for '%s' to finish\n", argv[0]);
+            return 127;
+        }
+    }
+
+    // Report the exit code the same way that shells do
+    if(WIFSIGNALED(status)) return 128 + WTERMSIG(status);
+    return WEXITSTATUS(status);
+}
+#endif
+
+void ir_to_llvm_split_partitions(llvm_partition_t *partitions, length_t count, ir_module_t *module){
+    ir_func_t *funcs = module->funcs;
+    length_t funcs_length = module->funcs_length;
+    length_t total_weight = 0;
+
+    // Weigh each function by its instruction count (plus one for the function itself)
+    for(length_t f = 0; f != funcs_length; f++){
+        total_weight++;
+        total_weight += funcs[f].flat.instructions_length;
+    }
+
+    length_t f = 0;
+    length_t accumulated_weight = 0;
+
+    for(length_t p = 0; p != count; p++){
+        // Cumulative weight that should be reached by the end of this partition
+        length_t target_weight = total_weight * (p + 1) / count;
+
+        partitions[p].funcs_begin = f;
+
+        // Always leave at least one function for each remaining partition
+        while(f != funcs_length && funcs_length - f > count - p - 1 && (accumulated_weight < target_weight || f == partitions[p].funcs_begin)){
+            accumulated_weight++;
+            accumulated_weight += funcs[f].flat.instructions_length;
+            f++;
+        }
+
+        partitions[p].funcs_end = p + 1 == count ? funcs_length : f;
+    }
 }
 
 LLVMCodeGenOptLevel ir_to_llvm_config_optlvl(compiler_t *compiler){
@@ -1113,3 +1717,45 @@ LLVMCodeGenOptLevel ir_to_llvm_config_optlvl(compiler_t *compiler){
     default: return LLVMCodeGenLevelDefault;
     }
 }
+
+void ir_to_llvm_optimize(compiler_t *compiler, LLVMModuleRef module, LLVMTargetMachineRef target_machine){
+    if(compiler->optimization == OPTIMIZATION_NONE) return;
+
+    LLVMPassManagerBuilderRef pass_builder = LLVMPassManagerBuilderCreate();
+    LLVMPassManagerBuilderSetOptLevel(pass_builder, compiler->optimization);
+    LLVMPassManagerBuilderSetSizeLevel(pass_builder, 0);
+
+    // Only inline non-trivial functions for the higher optimization levels
+    switch(compiler->optimization){
+    case OPTIMIZATION_DEFAULT:    LLVMPassManagerBuilderUseInlinerWithThreshold(pass_builder, 225); break;
+    case OPTIMIZATION_AGGRESSIVE: LLVMPassManagerBuilderUseInlinerWithThreshold(pass_builder, 275); break;
+    }
+
+    LLVMPassManagerRef function_passes = LLVMCreateFunctionPassManagerForModule(module);
+    LLVMPassManagerRef module_passes = LLVMCreatePassManager();
+
+    // Give the passes target specific cost information (needed for the vectorizers)
+    LLVMAddAnalysisPasses(target_machine, function_passes);
+    LLVMAddAnalysisPasses(target_machine, module_passes);
+
+    LLVMPassManagerBuilderPopulateFunctionPassManager(pass_builder, function_passes);
+    LLVMPassManagerBuilderPopulateModulePassManager(pass_builder, module_passes);
+
+    if(compiler->optimization == OPTIMIZATION_AGGRESSIVE){
+        LLVMAddSLPVectorizePass(module_passes);
+    }
+
+    // Per-function cleanup first (mem2reg, early simplification, etc.)
+    LLVMInitializeFunctionPassManager(function_passes);
+    for(LLVMValueRef func = LLVMGetFirstFunction(module); func; func = LLVMGetNextFunction(func)){
+        if(!LLVMIsDeclaration(func)) LLVMRunFunctionPassManager(function_passes, func);
+    }
+    LLVMFinalizeFunctionPassManager(function_passes);
+
+    // Then the whole module pipeline (inlining, GVN, loop optimizations, vectorization, etc.)
+    LLVMRunPassManager(module_passes, module);
+
+    LLVMDisposePassManager(function_passes);
+    LLVMDisposePassManager(module_passes);
+    LLVMPassManagerBuilderDispose(pass_builder);
+}
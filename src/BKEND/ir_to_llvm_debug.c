@@ -0,0 +1,190 @@
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm-c/Core.h>
+#if LLVM_VERSION_MAJOR >= 8
+#include <llvm-c/DebugInfo.h>
+#endif
+
+#include <llvm-c/TargetMachine.h>
+
+#include "UTIL/util.h"
+#include "UTIL/color.h"
+#include "UTIL/filename.h"
+#include "BKEND/ir_to_llvm_debug.h"
+
+void ir_to_llvm_debug_init(llvm_context_t *llvm, object_t *object){
+    llvm->debug = NULL;
+    if(!(llvm->compiler->traits & COMPILER_DEBUG_SYMBOLS)) return;
+
+    #if LLVM_VERSION_MAJOR < 8
+    // Subprograms can't be attached to functions through the C API before LLVM 8
+    if(llvm->partition->index == 0) yellowprintf("WARNING: Debugging information requires LLVM 8 or newer\n");
+    #else
+    llvm_debug_t *debug = malloc(sizeof(llvm_debug_t));
+    debug->builder = LLVMCreateDIBuilder(llvm->module);
+    debug->subprogram = NULL;
+    debug->files_length = llvm->compiler->objects_length;
+    debug->files = malloc(sizeof(llvm_debug_file_t*) * debug->files_length);
+    memset(debug->files, 0, sizeof(llvm_debug_file_t*) * debug->files_length);
+    llvm->debug = debug;
+
+    const char *producer = "Adept Compiler";
+    bool is_optimized = llvm->compiler->optimization != OPTIMIZATION_NONE;
+
+    // Adept doesn't have a DWARF language code, so describe it as C99 for the sake of debuggers
+    debug->compile_unit = LLVMDIBuilderCreateCompileUnit(debug->builder, LLVMDWARFSourceLanguageC99,
+        ir_to_llvm_debug_file(llvm, object->index)->file, producer, strlen(producer), is_optimized, "", 0, 0, "", 0,
+        LLVMDWARFEmissionFull, 0, false, false
+        #if LLVM_VERSION_MAJOR >= 11
+        , "", 0, "", 0
+        #endif
+    );
+
+    // Parameter types aren't described, only the functions themselves
+    debug->subroutine_type = LLVMDIBuilderCreateSubroutineType(debug->builder, ir_to_llvm_debug_file(llvm, object->index)->file, NULL, 0, LLVMDIFlagZero);
+
+    // Without a 'Debug Info Version' module flag, LLVM will strip the debugging information
+    LLVMTypeRef int32 = LLVMInt32TypeInContext(llvm->context);
+    LLVMValueRef version_flag[] = {
+        LLVMConstInt(int32, 2, false), // (Warning if modules disagree)
+        LLVMMDStringInContext(llvm->context, "Debug Info Version", 18),
+        LLVMConstInt(int32, LLVMDebugMetadataVersion(), false)
+    };
+    LLVMValueRef dwarf_flag[] = {
+        LLVMConstInt(int32, 2, false), // (Warning if modules disagree)
+        LLVMMDStringInContext(llvm->context, "Dwarf Version", 13),
+        LLVMConstInt(int32, 4, false)
+    };
+    LLVMAddNamedMetadataOperand(llvm->module, "llvm.module.flags", LLVMMDNodeInContext(llvm->context, version_flag, 3));
+    LLVMAddNamedMetadataOperand(llvm->module, "llvm.module.flags", LLVMMDNodeInContext(llvm->context, dwarf_flag, 3));
+    #endif
+}
+
+void ir_to_llvm_debug_finalize(llvm_context_t *llvm){
+    #if LLVM_VERSION_MAJOR >= 8
+    llvm_debug_t *debug = llvm->debug;
+    if(debug == NULL) return;
+
+    LLVMDIBuilderFinalize(debug->builder);
+    LLVMDisposeDIBuilder(debug->builder);
+
+    for(length_t i = 0; i != debug->files_length; i++){
+        if(debug->files[i] == NULL) continue;
+        free(debug->files[i]->line_starts);
+        free(debug->files[i]);
+    }
+
+    free(debug->files);
+    free(debug);
+    #endif
+
+    llvm->debug = NULL;
+}
+
+llvm_debug_file_t *ir_to_llvm_debug_file(llvm_context_t *llvm, length_t object_index){
+    #if LLVM_VERSION_MAJOR >= 8
+    llvm_debug_t *debug = llvm->debug;
+    if(debug->files[object_index] != NULL) return debug->files[object_index];
+
+    object_t *object = llvm->compiler->objects[object_index];
+    llvm_debug_file_t *file = malloc(sizeof(llvm_debug_file_t));
+
+    const char *filename = object->full_filename ? object->full_filename : object->filename;
+    weak_cstr_t name = filename_name_const((weak_cstr_t) filename);
+    strong_cstr_t directory = filename_path(filename);
+    file->file = LLVMDIBuilderCreateFile(debug->builder, name, strlen(name), directory, strlen(directory));
+    free(directory);
+
+    // Record where each line begins, so that locations can be found with a binary search
+    // NOTE: Objects that were loaded from packages don't have their source text
+    length_t capacity = 0;
+    file->line_starts = NULL;
+    file->line_starts_length = 0;
+
+    if(object->buffer != NULL){
+        expand((void**) &file->line_starts, sizeof(length_t), file->line_starts_length, &capacity, 1, 256);
+        file->line_starts[file->line_starts_length++] = 0;
+
+        for(length_t i = 0; object->buffer[i] != '\0'; i++){
+            if(object->buffer[i] != '\n') continue;
+            expand((void**) &file->line_starts, sizeof(length_t), file->line_starts_length, &capacity, 1, 256);
+            file->line_starts[file->line_starts_length++] = i + 1;
+        }
+    }
+
+    debug->files[object_index] = file;
+    return file;
+    #else
+    return NULL;
+    #endif
+}
+
+void ir_to_llvm_debug_location(llvm_debug_file_t *file, length_t index, unsigned int *out_line, unsigned int *out_column){
+    #if LLVM_VERSION_MAJOR >= 8
+    if(file->line_starts_length == 0){
+        *out_line = 0;
+        *out_column = 0;
+        return;
+    }
+
+    // Find the last line that begins at or before 'index'
+    length_t first = 0, last = file->line_starts_length - 1;
+
+    while(first != last){
+        length_t middle = (first + last + 1) / 2;
+
+        if(file->line_starts[middle] <= index){
+            first = middle;
+        } else {
+            last = middle - 1;
+        }
+    }
+
+    *out_line = first + 1;
+    *out_column = index - file->line_starts[first] + 1;
+    #else
+    *out_line = 0;
+    *out_column = 0;
+    #endif
+}
+
+void ir_to_llvm_debug_function(llvm_context_t *llvm, LLVMValueRef func, ir_func_t *ir_func){
+    #if LLVM_VERSION_MAJOR >= 8
+    llvm_debug_t *debug = llvm->debug;
+    if(debug == NULL) return;
+
+    if(ir_func->traits & IR_FUNC_FOREIGN){
+        debug->subprogram = NULL;
+        return;
+    }
+
+    llvm_debug_file_t *file = ir_to_llvm_debug_file(llvm, ir_func->source.object_index);
+    const char *linkage_name = LLVMGetValueName(func);
+    bool is_optimized = llvm->compiler->optimization != OPTIMIZATION_NONE;
+
+    unsigned int line, column;
+    ir_to_llvm_debug_location(file, ir_func->source.index, &line, &column);
+
+    debug->subprogram = LLVMDIBuilderCreateFunction(debug->builder, file->file, ir_func->name, strlen(ir_func->name),
+        linkage_name, strlen(linkage_name), file->file, line, debug->subroutine_type, false, true, line,
+        LLVMDIFlagPrototyped, is_optimized);
+
+    LLVMSetSubprogram(func, debug->subprogram);
+
+    // Anything built before the first instruction belongs to the function declaration
+    ir_to_llvm_debug_set_location(llvm, ir_func->source);
+    #endif
+}
+
+void ir_to_llvm_debug_set_location(llvm_context_t *llvm, source_t source){
+    #if LLVM_VERSION_MAJOR >= 8
+    llvm_debug_t *debug = llvm->debug;
+    if(debug == NULL || debug->subprogram == NULL) return;
+
+    unsigned int line, column;
+    ir_to_llvm_debug_location(ir_to_llvm_debug_file(llvm, source.object_index), source.index, &line, &column);
+
+    LLVMMetadataRef location = LLVMDIBuilderCreateDebugLocation(llvm->context, line, column, debug->subprogram, NULL);
+    LLVMSetCurrentDebugLocation(llvm->builder, LLVMMetadataAsValue(llvm->context, location));
+    #endif
+}
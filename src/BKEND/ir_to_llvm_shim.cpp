@@ -0,0 +1,31 @@
+
+#include <llvm/Config/llvm-config.h>
+#include <llvm/IR/Instruction.h>
+#include <llvm/IR/Operator.h>
+#include <llvm/IR/Value.h>
+
+#include "DRVR/compiler.h"
+#include "BKEND/ir_to_llvm_shim.h"
+
+void ir_to_llvm_shim_fast_math(LLVMValueRef value, trait_t flags){
+    llvm::Instruction *instr = llvm::dyn_cast<llvm::Instruction>(llvm::unwrap(value));
+    if(instr == nullptr || !llvm::isa<llvm::FPMathOperator>(instr)) return;
+
+    llvm::FastMathFlags fast_math_flags;
+
+    #if LLVM_VERSION_MAJOR >= 6
+    if(flags & FAST_MATH_REASSOC) fast_math_flags.setAllowReassoc();
+    if(flags & FAST_MATH_APPROX_FUNC) fast_math_flags.setApproxFunc();
+    #else
+    // Reassociation is only available as part of 'unsafe algebra' before LLVM 6
+    if(flags & (FAST_MATH_REASSOC | FAST_MATH_APPROX_FUNC)) fast_math_flags.setUnsafeAlgebra();
+    #endif
+
+    if(flags & FAST_MATH_CONTRACT) fast_math_flags.setAllowContract(true);
+    if(flags & FAST_MATH_NO_NANS) fast_math_flags.setNoNaNs();
+    if(flags & FAST_MATH_NO_INFS) fast_math_flags.setNoInfs();
+    if(flags & FAST_MATH_NO_SIGNED_ZEROS) fast_math_flags.setNoSignedZeros();
+    if(flags & FAST_MATH_RECIPROCAL) fast_math_flags.setAllowReciprocal();
+
+    instr->setFastMathFlags(fast_math_flags);
+}
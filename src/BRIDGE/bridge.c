@@ -9,6 +9,7 @@ void bridge_var_scope_init(bridge_var_scope_t *out_scope, bridge_var_scope_t *pa
     out_scope->list.variables = NULL;
     out_scope->list.length = 0;
     out_scope->list.capacity = 0;
+    hash_index_init(&out_scope->list.index);
 
     out_scope->children = NULL;
     out_scope->children_length = 0;
@@ -22,15 +23,13 @@ void bridge_var_scope_free(bridge_var_scope_t *scope){
     }
 
     free(scope->list.variables);
+    hash_index_free(&scope->list.index);
     free(scope->children);
 
 }
 bridge_var_t* bridge_var_scope_find_var(bridge_var_scope_t *scope, const char *name){
-    for(length_t i = 0; i != scope->list.length; i++){
-        if(strcmp(scope->list.variables[i].name, name) == 0){
-            return &scope->list.variables[i];
-        }
-    }
+    maybe_index_t index = bridge_var_list_find(&scope->list, name);
+    if(index != -1) return &scope->list.variables[index];
 
     if(scope->parent){
         return bridge_var_scope_find_var(scope->parent, name);
@@ -59,10 +58,7 @@ bridge_var_t* bridge_var_scope_find_var_by_id(bridge_var_scope_t *scope, length_
 }
 
 bool bridge_var_scope_already_in_list(bridge_var_scope_t *scope, const char *name){
-    for(length_t i = 0; i != scope->list.length; i++){
-        if(strcmp(scope->list.variables[i].name, name) == 0) return true;
-    }
-    return false;
+    return bridge_var_list_find(&scope->list, name) != -1;
 }
 
 const char* bridge_var_scope_nearest(bridge_var_scope_t *scope, const char *name){
@@ -97,6 +93,17 @@ void bridge_var_scope_nearest_inner(bridge_var_scope_t *scope, const char *name,
     }
 }
 
+maybe_index_t bridge_var_list_find(bridge_var_list_t *list, const char *name){
+    hash_t hash = hash_cstr(name);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&list->index, hash, &cursor); i != -1; i = hash_index_find_next(&list->index, hash, &cursor)){
+        if(strcmp(list->variables[i].name, name) == 0) return i;
+    }
+
+    return -1;
+}
+
 void bridge_var_list_nearest(bridge_var_list_t *list, const char *name, char **out_nearest_name, int *out_distance){
     // NOTE: out_nearest_name must be a valid pointer
     // NOTE: out_distance may be NULL
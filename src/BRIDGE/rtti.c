@@ -1,45 +1,117 @@
 
+#include "UTIL/util.h"
 #include "BRIDGE/rtti.h"
 
 ir_value_t* rtti_for(ir_builder_t *builder, ast_type_t *target, source_t sourceOnFailure){
-    // Kinda hacky way of doing it but whatever
-    strong_cstr_t readable_name = ast_type_str(target);
-    maybe_index_t found_type_index = type_table_find(builder->object->ast.type_table, readable_name);
+    maybe_index_t found_type_index = type_table_find_type(builder->object->ast.type_table, target);
     if(found_type_index == -1){
+        strong_cstr_t readable_name = ast_type_str(target);
         compiler_panicf(builder->compiler, sourceOnFailure, "INTERNAL ERROR: typeinfo failed to find info for type '%s', which should exist", readable_name);
         free(readable_name);
         return NULL;
     }
-    free(readable_name);
-
-    // TODO: Clean up this up
-    // It works, but the global variable lookup could be better
-    bool found_global = false;
-    length_t var_index;
-    
-    for(var_index = 0; var_index != builder->object->ir_module.globals_length; var_index++){
-        if(strcmp("__types__", builder->object->ir_module.globals[var_index].name) == 0){
-            found_global = true; break;
-        }
-    }
-    
-    if(!found_global){
+
+    maybe_index_t var_index = builder->object->ir_module.common.rtti_array_index;
+
+    if(var_index == -1){
         compiler_panic(builder->compiler, sourceOnFailure, "Failed to find __types__ global variable");
         return NULL;
     }
 
     ir_global_t *global = &builder->object->ir_module.globals[var_index];
+    // NOTE: The index of the type will change if the type table is pruned,
+    //       so remember where it is in case it needs to be updated
+    // NOTE: Since it may change, the literal can't be a shared constant
+    ir_value_t *index = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, ir_builder_usize(builder), sizeof(unsigned long long));
+    *((unsigned long long*) index->extra) = found_type_index;
 
-    ir_value_t *rtti = build_gvarptr(builder, ir_type_pointer_to(builder->pool, global->type), var_index);
+    ir_module_t *module = &builder->object->ir_module;
+    expand((void**) &module->rtti_relocations, sizeof(ir_rtti_relocation_t), module->rtti_relocations_length, &module->rtti_relocations_capacity, 1, 16);
+    module->rtti_relocations[module->rtti_relocations_length++].index_ref = (unsigned long long*) index->extra;
+
+    ir_value_t *rtti = build_gvarptr(builder, ir_type_pointer_to(&builder->object->ir_module.type_interner, global->type), var_index);
     rtti = build_load(builder, rtti);
-    ir_basicblock_new_instructions(builder->current_block, 1);
-    ir_instr_t *instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_array_access_t));
+    ir_instr_t *instruction = build_instruction(builder, sizeof(ir_instr_array_access_t));
     ((ir_instr_array_access_t*) instruction)->id = INSTRUCTION_ARRAY_ACCESS;
     ((ir_instr_array_access_t*) instruction)->result_type = rtti->type;
     ((ir_instr_array_access_t*) instruction)->value = rtti;
-    ((ir_instr_array_access_t*) instruction)->index = build_literal_usize(builder->pool, found_type_index);
-    builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
+    ((ir_instr_array_access_t*) instruction)->index = index;
     rtti = build_value_from_prev_instruction(builder);
     rtti = build_load(builder, rtti);
     return rtti;
 }
+
+void rtti_table_prune(object_t *object){
+    type_table_t *table = object->ast.type_table;
+    ir_module_t *module = &object->ir_module;
+
+    bool *reachable = malloc(sizeof(bool) * table->length);
+    length_t *worklist = malloc(sizeof(length_t) * table->length);
+    length_t worklist_length = 0;
+    memset(reachable, 0, sizeof(bool) * table->length);
+
+    // Types that are referred to directly are always kept
+    for(length_t r = 0; r != module->rtti_relocations_length; r++){
+        length_t index = *module->rtti_relocations[r].index_ref;
+        if(reachable[index]) continue;
+
+        reachable[index] = true;
+        worklist[worklist_length++] = index;
+    }
+
+    // Keep the types that the runtime type info of those types refers to
+    while(worklist_length != 0){
+        ast_type_t *type = &table->records[worklist[--worklist_length]].ast_type;
+
+        if(type->elements_length > 1 && type->elements[0]->id == AST_ELEM_POINTER){
+            // Pointers refer to the type that they point to
+            // NOTE: 'dereferenced' borrows the elements of 'type'
+            ast_type_t dereferenced = *type;
+            dereferenced.elements = &type->elements[1];
+            dereferenced.elements_length--;
+
+            rtti_table_reach(table, reachable, worklist, &worklist_length, &dereferenced);
+        } else if(type->elements_length == 1 && type->elements[0]->id == AST_ELEM_BASE){
+            // Structures refer to the types of their fields
+            ast_struct_t *structure = ast_struct_find(&object->ast, ((ast_elem_base_t*) type->elements[0])->base);
+            if(structure == NULL) continue;
+
+            for(length_t f = 0; f != structure->field_count; f++){
+                rtti_table_reach(table, reachable, worklist, &worklist_length, &structure->field_types[f]);
+            }
+        }
+    }
+
+    // Remove unreachable records, keeping the rest in sorted order
+    // NOTE: 'worklist' is reused to remember the new index of each kept record
+    length_t *new_indices = worklist;
+    length_t kept = 0;
+
+    for(length_t i = 0; i != table->length; i++){
+        if(reachable[i]){
+            new_indices[i] = kept;
+            table->records[kept++] = table->records[i];
+        } else {
+            type_table_records_free(&table->records[i], 1);
+        }
+    }
+
+    table->length = kept;
+    type_table_index(table);
+
+    for(length_t r = 0; r != module->rtti_relocations_length; r++){
+        unsigned long long *index_ref = module->rtti_relocations[r].index_ref;
+        *index_ref = new_indices[*index_ref];
+    }
+
+    free(reachable);
+    free(worklist);
+}
+
+void rtti_table_reach(type_table_t *table, bool *reachable, length_t *worklist, length_t *worklist_length, const ast_type_t *type){
+    maybe_index_t index = type_table_find_type(table, type);
+    if(index == -1 || reachable[index]) return;
+
+    reachable[index] = true;
+    worklist[(*worklist_length)++] = index;
+}
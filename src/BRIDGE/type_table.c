@@ -7,117 +7,173 @@ void type_table_init(type_table_t *table){
     table->length = 0;
     table->capacity = 0;
     table->reduced = false;
+    table->index = NULL;
+    table->index_capacity = 0;
 }
 
 void type_table_free(type_table_t *table){
     if(table == NULL) return;
     type_table_records_free(table->records, table->length);
     free(table->records);
+    free(table->index);
 }
 
 void type_table_give(type_table_t *table, ast_type_t *type, maybe_null_strong_cstr_t maybe_alias_name){
-    expand((void**) &table->records, sizeof(type_table_record_t), table->length, &table->capacity, 2, 16);
-    
-    strong_cstr_t name = maybe_alias_name ? maybe_alias_name : ast_type_str(type);
-    table->records[table->length].name = name;
-    table->records[table->length].ast_type = ast_type_clone(type);
+    bool is_new;
 
-    #ifndef ADEPT_INSIGHT_BUILD
-    table->records[table->length].ir_type = NULL;
-    #endif
+    if(maybe_alias_name){
+        is_new = type_table_find(table, maybe_alias_name) == -1;
 
-    table->records[table->length++].is_alias = (maybe_alias_name != NULL);
+        if(is_new){
+            type_table_insert(table, maybe_alias_name, ast_type_clone(type), true);
+        } else {
+            free(maybe_alias_name);
+        }
+    } else {
+        is_new = type_table_find_type_with_prefix(table, "", type) == -1;
+        if(is_new) type_table_insert(table, ast_type_str(type), ast_type_clone(type), false);
+    }
 
     // HACK: Add extra entry for pointer to given type
     // since we cannot know whether or not '&' is even used on that type
     // (with the current system)
     // Also, this may turn out to be benificial for formulating types that
     // may not have been directly refered to at compile time
-    if(strcmp(name, "void") != 0){
+    if(!ast_type_str_equals(type, "void") && type_table_find_type_with_prefix(table, "*", type) == -1){
         ast_type_t with_additional_ptr = ast_type_clone(type);
         ast_type_prepend_ptr(&with_additional_ptr);
-        table->records[table->length].name = ast_type_str(&with_additional_ptr);
-        table->records[table->length].ast_type = with_additional_ptr;
-        
-        #ifndef ADEPT_INSIGHT_BUILD
-        table->records[table->length].ir_type = NULL;
-        #endif
-
-        table->records[table->length++].is_alias = false;
+        type_table_insert(table, ast_type_str(&with_additional_ptr), with_additional_ptr, false);
     }
 
     // Mention sub types to the type table
-    if(type->elements_length != 0 && type->elements[0]->id == AST_ELEM_POINTER){
-        ast_type_t subtype = ast_type_clone(type);
-        // Modify ast_type_t to remove a pointer element from the front
-        // DANGEROUS: Manually deleting ast_elem_pointer_t
-        free(subtype.elements[0]);
-        memmove(subtype.elements, &subtype.elements[1], sizeof(ast_elem_t*) * (subtype.elements_length - 1));
-        subtype.elements_length--; // Reduce length accordingly
+    // NOTE: Sub types of types that were already mentioned are already in the table
+    if(is_new && type->elements_length != 0 && type->elements[0]->id == AST_ELEM_POINTER){
+        // NOTE: 'subtype' borrows the elements of 'type'
+        ast_type_t subtype = *type;
+        subtype.elements = &type->elements[1];
+        subtype.elements_length--;
 
         type_table_give(table, &subtype, NULL); // TODO: Maybe determine whether or not subtype is alias??
-        ast_type_free(&subtype);
     }
 }
 
 void type_table_give_base(type_table_t *table, weak_cstr_t base){
-    expand((void**) &table->records, sizeof(type_table_record_t), table->length, &table->capacity, 2, 16);
-
-    table->records[table->length].name = strclone(base);
-    ast_type_make_base(&table->records[table->length].ast_type, strclone(base));
-
-    #ifndef ADEPT_INSIGHT_BUILD
-    table->records[table->length].ir_type = NULL;
-    #endif
-
-    table->records[table->length++].is_alias = false;
+    // NOTE: 'type' borrows 'base' and is only used for lookups
+    ast_elem_base_t elem;
+    elem.id = AST_ELEM_BASE;
+    elem.source = NULL_SOURCE;
+    elem.base = base;
+
+    ast_elem_t *elements[] = {(ast_elem_t*) &elem};
+    ast_type_t type;
+    type.elements = elements;
+    type.elements_length = 1;
+    type.source = NULL_SOURCE;
+
+    if(type_table_find(table, base) == -1){
+        ast_type_t base_type;
+        ast_type_make_base(&base_type, strclone(base));
+        type_table_insert(table, strclone(base), base_type, false);
+    }
 
     // HACK: Add extra entry for pointer to given type
     // since we cannot know whether or not '&' is even used on that type
     // (with the current system)
     // Also, this may turn out to be benificial for formulating types that
     // may not have been directly refered to at compile time
-    if(strcmp(base, "void") != 0){
+    if(strcmp(base, "void") != 0 && type_table_find_type_with_prefix(table, "*", &type) == -1){
         ast_type_t with_additional_ptr;
         ast_type_make_base_ptr(&with_additional_ptr, strclone(base));
-        table->records[table->length].name = ast_type_str(&with_additional_ptr);
-        table->records[table->length].ast_type = with_additional_ptr;
-
-        #ifndef ADEPT_INSIGHT_BUILD
-        table->records[table->length].ir_type = NULL;
-        #endif
-        
-        table->records[table->length++].is_alias = false;
+        type_table_insert(table, ast_type_str(&with_additional_ptr), with_additional_ptr, false);
     }
 }
 
+void type_table_insert(type_table_t *table, strong_cstr_t name, ast_type_t type, bool is_alias){
+    expand((void**) &table->records, sizeof(type_table_record_t), table->length, &table->capacity, 1, 16);
+
+    table->records[table->length].name = name;
+    table->records[table->length].ast_type = type;
+
+    #ifndef ADEPT_INSIGHT_BUILD
+    table->records[table->length].ir_type = NULL;
+    #endif
+
+    table->records[table->length++].is_alias = is_alias;
+
+    // Keep the load factor of the index at or below one half
+    if(table->length * 2 > table->index_capacity){
+        type_table_index(table);
+        return;
+    }
+
+    length_t mask = table->index_capacity - 1;
+    length_t slot = hash_cstr(name) & mask;
+    while(table->index[slot] != 0) slot = (slot + 1) & mask;
+    table->index[slot] = table->length;
+}
+
 void type_table_reduce(type_table_t *table){
+    // NOTE: Duplicate records are never inserted,
+    //       so the only thing left to do is to sort them
     if(table->reduced) return;
 
     qsort(table->records, table->length, sizeof(type_table_record_t), type_table_record_cmp);
+    type_table_index(table);
+    table->reduced = true;
+}
 
-    for(length_t i = 0; i != table->length; i++){
-        if(i + 1 != table->length && strcmp(table->records[i].name, table->records[i + 1].name) == 0){
-            // Remove this entry, because next entry is identical
-            type_table_records_free(&table->records[i], 1);
+void type_table_index(type_table_t *table){
+    // Keep the load factor at or below one half
+    length_t capacity = 16;
+    while(capacity < table->length * 2) capacity *= 2;
 
-            memcpy(&table->records[i], &table->records[i + 1], (table->length - i - 1) * sizeof(type_table_record_t));
-            table->length--;
-            i--;
-        }
+    free(table->index);
+    table->index = malloc(sizeof(length_t) * capacity);
+    table->index_capacity = capacity;
+    memset(table->index, 0, sizeof(length_t) * capacity);
+
+    for(length_t i = 0; i != table->length; i++){
+        length_t slot = hash_cstr(table->records[i].name) & (capacity - 1);
+        while(table->index[slot] != 0) slot = (slot + 1) & (capacity - 1);
+        table->index[slot] = i + 1;
     }
 }
 
 maybe_index_t type_table_find(type_table_t *table, const char *name){
-    // TODO: Make this fast
+    if(table->index == NULL) return -1;
 
-    for(length_t i = 0; i != table->length; i++){
+    length_t mask = table->index_capacity - 1;
+
+    for(length_t slot = hash_cstr(name) & mask; table->index[slot] != 0; slot = (slot + 1) & mask){
+        length_t i = table->index[slot] - 1;
         if(strcmp(table->records[i].name, name) == 0) return i;
     }
 
     return -1;
 }
 
+maybe_index_t type_table_find_type(type_table_t *table, const ast_type_t *type){
+    return type_table_find_type_with_prefix(table, "", type);
+}
+
+maybe_index_t type_table_find_type_with_prefix(type_table_t *table, const char *prefix, const ast_type_t *type){
+    if(table->index == NULL) return -1;
+
+    length_t prefix_length = strlen(prefix);
+    length_t mask = table->index_capacity - 1;
+    hash_t hash = ast_type_str_hash(type, hash_continue(HASH_SEED, prefix, prefix_length));
+
+    for(length_t slot = hash & mask; table->index[slot] != 0; slot = (slot + 1) & mask){
+        const char *name = table->records[table->index[slot] - 1].name;
+
+        if(strncmp(name, prefix, prefix_length) == 0 && ast_type_str_equals(type, &name[prefix_length])){
+            return table->index[slot] - 1;
+        }
+    }
+
+    return -1;
+}
+
 void type_table_records_free(type_table_record_t *records, length_t length){
     for(length_t i = 0; i != length; i++){
         free(records[i].name);
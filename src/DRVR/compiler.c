@@ -18,17 +18,20 @@
 
 #ifndef ADEPT_INSIGHT_BUILD
 #include "IR/ir.h"
+#include "IR/ir_flat.h"
 #include "DRVR/debug.h"
 #include "INFER/infer.h"
 #include "IRGEN/ir_gen.h"
 #include "IRGEN/ir_gen_find.h"
+#include "IRGEN/ir_optimize.h"
 #include "BKEND/backend.h"
 #endif
 
 errorcode_t compiler_run(compiler_t *compiler, int argc, char **argv){
     // A wrapper function around 'compiler_execute'
     compiler_invoke(compiler, argc, argv);
-    return !(compiler->result_flags & COMPILER_RESULT_SUCCESS);
+    if(!(compiler->result_flags & COMPILER_RESULT_SUCCESS)) return FAILURE;
+    return compiler->execute_result;
 }
 
 void compiler_invoke(compiler_t *compiler, int argc, char **argv){
@@ -102,6 +105,8 @@ void compiler_invoke(compiler_t *compiler, int argc, char **argv){
     debug_signal(compiler, DEBUG_SIGNAL_AT_ASSEMBLY, NULL);
 
     if(ir_gen(compiler, object)) return;
+    if(!(compiler->traits & COMPILER_NO_IR_OPT)) ir_optimize_module(&object->ir_module);
+    ir_flatten_module(&object->ir_module);
 
     debug_signal(compiler, DEBUG_SIGNAL_AT_IR_MODULE_DUMP, &object->ir_module);
     debug_signal(compiler, DEBUG_SIGNAL_AT_EXPORT, NULL);
@@ -117,10 +122,17 @@ void compiler_init(compiler_t *compiler){
     compiler->objects = malloc(sizeof(object_t*) * 4);
     compiler->objects_length = 0;
     compiler->objects_capacity = 4;
+    cstr_interner_init(&compiler->identifiers);
     compiler->traits = TRAIT_NONE;
     compiler->output_filename = NULL;
     compiler->optimization = OPTIMIZATION_NONE;
     compiler->checks = TRAIT_NONE;
+    compiler->fast_math = FAST_MATH_DEFAULT;
+    compiler->jobs = 1;
+    compiler->execute_result = 0;
+    compiler->ir_pool_size = IR_POOL_DEFAULT_FRAGMENT_SIZE;
+    compiler->target_cpu = NULL;
+    compiler->target_features = NULL;
 
     #ifdef ENABLE_DEBUG_FEATURES
     compiler->debug_traits = TRAIT_NONE;
@@ -135,6 +147,8 @@ void compiler_free(compiler_t *compiler){
     free(compiler->location);
     free(compiler->root);
     free(compiler->output_filename);
+    free(compiler->target_cpu);
+    free(compiler->target_features);
 
     for(length_t i = 0; i != compiler->objects_length; i++){
         object_t *object = compiler->objects[i];
@@ -178,6 +192,7 @@ void compiler_free(compiler_t *compiler){
     }
 
     free(compiler->objects);
+    cstr_interner_free(&compiler->identifiers);
 }
 
 object_t* compiler_new_object(compiler_t *compiler){
@@ -233,10 +248,24 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->traits |= COMPILER_DEBUG_SYMBOLS;
             } else if(strcmp(argv[arg_index], "-e") == 0){
                 compiler->traits |= COMPILER_EXECUTE_RESULT;
+            } else if(strcmp(argv[arg_index], "--jit") == 0){
+                compiler->traits |= COMPILER_EXECUTE_RESULT | COMPILER_JIT;
             } else if(strcmp(argv[arg_index], "-w") == 0){
                 compiler->traits |= COMPILER_NO_WARN;
             } else if(strcmp(argv[arg_index], "-j") == 0){
                 compiler->traits |= COMPILER_NO_REMOVE_OBJECT;
+            } else if(strncmp(argv[arg_index], "--jobs=", 7) == 0){
+                length_t jobs;
+                if(parse_argument_count(argv[arg_index], &argv[arg_index][7], &jobs)) return FAILURE;
+
+                if(jobs == 0){
+                    redprintf("Number of jobs for '--jobs' must be at least 1\n");
+                    return FAILURE;
+                }
+
+                compiler->jobs = jobs;
+            } else if(strncmp(argv[arg_index], "--ir-pool-size=", 15) == 0){
+                if(parse_argument_count(argv[arg_index], &argv[arg_index][15], &compiler->ir_pool_size)) return FAILURE;
             } else if(strcmp(argv[arg_index], "-O0") == 0){
                 compiler->optimization = OPTIMIZATION_NONE;
             } else if(strcmp(argv[arg_index], "-O1") == 0){
@@ -245,10 +274,33 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->optimization = OPTIMIZATION_DEFAULT;
             } else if(strcmp(argv[arg_index], "-O3") == 0){
                 compiler->optimization = OPTIMIZATION_AGGRESSIVE;
+            } else if(strncmp(argv[arg_index], "--march=", 8) == 0){
+                // NOTE: '--march=CPU' selects a CPU with only its default features
+                free(compiler->target_cpu);
+                free(compiler->target_features);
+                compiler->target_cpu = strclone(&argv[arg_index][8]);
+                compiler->target_features = NULL;
+            } else if(strncmp(argv[arg_index], "--mcpu=", 7) == 0){
+                free(compiler->target_cpu);
+                compiler->target_cpu = strclone(&argv[arg_index][7]);
+            } else if(strncmp(argv[arg_index], "--mattr=", 8) == 0){
+                free(compiler->target_features);
+                compiler->target_features = strclone(&argv[arg_index][8]);
             } else if(strcmp(argv[arg_index], "--no-undef") == 0){
                 compiler->traits |= COMPILER_NO_UNDEF;
             } else if(strcmp(argv[arg_index], "--no-type-info") == 0){
                 compiler->traits |= COMPILER_NO_TYPE_INFO;
+            } else if(strcmp(argv[arg_index], "--prune-type-info") == 0){
+                compiler->traits |= COMPILER_PRUNE_TYPE_INFO;
+            } else if(strcmp(argv[arg_index], "--assume-no-overflow") == 0){
+                compiler->traits |= COMPILER_NO_OVERFLOW;
+            } else if(strcmp(argv[arg_index], "--fast-math") == 0){
+                compiler->traits |= COMPILER_FAST_MATH;
+            } else if(strncmp(argv[arg_index], "--fast-math=", 12) == 0){
+                if(parse_fast_math_flags(&argv[arg_index][12], &compiler->fast_math)) return FAILURE;
+                compiler->traits |= COMPILER_FAST_MATH;
+            } else if(strcmp(argv[arg_index], "--no-ir-opt") == 0){
+                compiler->traits |= COMPILER_NO_IR_OPT;
             } else if(strcmp(argv[arg_index], "--null-checks") == 0){
                 compiler->checks |= COMPILER_NULL_CHECKS;
             }
@@ -265,6 +317,8 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
                 compiler->debug_traits |= COMPILER_DEBUG_LLVMIR;
             } else if(strcmp(argv[arg_index], "--no-verification") == 0){
                 compiler->debug_traits |= COMPILER_DEBUG_NO_VERIFICATION;
+            } else if(strcmp(argv[arg_index], "--pool-stats") == 0){
+                compiler->debug_traits |= COMPILER_DEBUG_POOL_STATS;
             }
             #endif // ENABLE_DEBUG_FEATURES ///////////////////////////////
 
@@ -335,6 +389,56 @@ errorcode_t parse_arguments(compiler_t *compiler, object_t *object, int argc, ch
     return SUCCESS;
 }
 
+errorcode_t parse_argument_count(const char *argument, const char *digits, length_t *out_count){
+    length_t count = 0;
+
+    if(*digits == '\0'){
+        redprintf("Invalid argument: %s\n", argument);
+        return FAILURE;
+    }
+
+    for(const char *c = digits; *c != '\0'; c++){
+        if(*c < '0' || *c > '9'){
+            redprintf("Invalid argument: %s\n", argument);
+            return FAILURE;
+        }
+        count = count * 10 + (*c - '0');
+    }
+
+    *out_count = count;
+    return SUCCESS;
+}
+
+errorcode_t parse_fast_math_flags(const char *list, trait_t *out_flags){
+    const char *names[] = {"reassoc", "contract", "nnan", "ninf", "nsz", "arcp", "afn", "fast"};
+    const trait_t flags[] = {FAST_MATH_REASSOC, FAST_MATH_CONTRACT, FAST_MATH_NO_NANS, FAST_MATH_NO_INFS,
+        FAST_MATH_NO_SIGNED_ZEROS, FAST_MATH_RECIPROCAL, FAST_MATH_APPROX_FUNC, FAST_MATH_ALL};
+    const length_t names_length = sizeof(names) / sizeof(const char*);
+
+    trait_t result = TRAIT_NONE;
+
+    while(true){
+        const char *end = strchr(list, ',');
+        length_t length = end ? (length_t) (end - list) : strlen(list);
+        length_t i = 0;
+
+        while(i != names_length && !(strlen(names[i]) == length && strncmp(names[i], list, length) == 0)) i++;
+
+        if(i == names_length){
+            redprintf("Unknown fast-math flag '%.*s'\n", (int) length, list);
+            printf("Possible flags are: reassoc, contract, nnan, ninf, nsz, arcp, afn, fast\n");
+            return FAILURE;
+        }
+
+        result |= flags[i];
+        if(end == NULL) break;
+        list = end + 1;
+    }
+
+    *out_flags = result;
+    return SUCCESS;
+}
+
 void break_into_arguments(const char *s, int *out_argc, char ***out_argv){
     // Breaks a string into arguments (quote and backslashes allowed)
     // TODO: Clean up this function because it's all over the place
@@ -416,16 +520,29 @@ void show_help(){
     printf("    -n FILENAME       Write output to FILENAME (relative to file)\n");
     printf("    -o FILENAME       Write output to FILENAME (relative to working directory)\n");
     printf("    -e                Execute resulting executable\n");
+    printf("    --jit             Execute in-process without linking\n");
     printf("    -p, --package     Output a package\n");
     printf("    -d                Include debugging symbols\n");
     printf("    -w                Disable all compiler warnings\n");
     printf("    -j                Preserve generated object file\n");
     printf("    -O                Set optimization level\n");
+    printf("    --jobs=N          Split code generation across N threads\n");
+    printf("    --ir-pool-size=N  Give the IR memory pool an N byte first fragment\n");
+    printf("    --march=native    Generate code for the host CPU\n");
+    printf("    --mcpu=CPU        Generate code for CPU\n");
+    printf("    --mattr=FEATURES  Enable/disable CPU features (e.g. +avx2,-fma)\n");
 
     printf("\nLanguage Options:\n");
     printf("    --no-undef        Force initialize for 'undef'\n");
     printf("    --no-type-info    Disable runtime type information\n");
+    printf("    --prune-type-info Only include runtime type information for types\n");
+    printf("                      that are used by 'typeinfo' and 'Any'\n");
     printf("    --null-checks     Enable runtime null-checks\n");
+    printf("    --assume-no-overflow\n");
+    printf("                      Assume integer math never overflows\n");
+    printf("    --fast-math       Allow unsafe floating-point optimizations\n");
+    printf("    --fast-math=FLAGS Only allow some (e.g. reassoc,contract,nnan,ninf)\n");
+    printf("    --no-ir-opt       Don't optimize Adept IR before lowering\n");
 
     #ifdef ENABLE_DEBUG_FEATURES
     printf("--------------------------------------------------\n");
@@ -435,6 +552,7 @@ void show_help(){
     printf("    --dump            Dump AST, IAST, & IR to files\n");
     printf("    --llvmir          Show generated LLVM representation\n");
     printf("    --no-verification Don't verify backend output\n");
+    printf("    --pool-stats      Show IR memory pool statistics\n");
     #endif // ENABLE_DEBUG_FEATURES
 }
 
@@ -581,7 +699,7 @@ void compiler_warnf(compiler_t *compiler, source_t source, const char *format, .
 void compiler_undeclared_function(compiler_t *compiler, ir_module_t *ir_module, source_t source,
         const char *name, ast_type_t *types, length_t arity){
 
-    maybe_index_t original_index = find_beginning_of_func_group(ir_module->func_mappings, ir_module->funcs_length, name);
+    maybe_index_t original_index = ir_gen_find_func_group(ir_module, name);
     
     if(original_index == -1){
         // No other function with that name exists
@@ -600,11 +718,7 @@ void compiler_undeclared_function(compiler_t *compiler, ir_module_t *ir_module,
 
     do {
         ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
-
-        if(mapping->is_beginning_of_group == -1){
-            mapping->is_beginning_of_group = (strcmp(mapping->name, ir_module->func_mappings[index - 1].name) != 0);
-        }
-        if(mapping->is_beginning_of_group == 1 && index != original_index) return;
+        if(mapping->is_beginning_of_group && index != original_index) return;
 
         char *return_type_string = ast_type_str(&mapping->ast_func->return_type);
         char *args_string = make_args_string(mapping->ast_func->arg_types, mapping->ast_func->arity);
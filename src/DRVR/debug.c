@@ -30,6 +30,7 @@ void handle_debug_signal(compiler_t *compiler, unsigned int sig, void *data){
         break;
     case DEBUG_SIGNAL_AT_IR_MODULE_DUMP:
         if(compiler->debug_traits & COMPILER_DEBUG_DUMP) ir_module_dump((ir_module_t*) data, "ir.txt");
+        if(compiler->debug_traits & COMPILER_DEBUG_POOL_STATS) ir_pool_print_stats(&((ir_module_t*) data)->pool);
         break;
     default:
         printf("Unknown debug signal %08X\n", (int) sig);
@@ -52,6 +52,10 @@ errorcode_t infer(compiler_t *compiler, object_t *object){
 
     if(infer_in_funcs(&ctx, ast->funcs, ast->funcs_length)) return FAILURE;
 
+    // Nothing else is added to the type table after this point,
+    // so it can be finished now and searched quickly during IR generation
+    type_table_reduce(ctx.type_table);
+
     ast->type_table = ctx.type_table;
     return SUCCESS;
 }
@@ -1,5 +1,7 @@
 
 #include "IR/ir.h"
+#include "IR/ir_flat.h"
+#include "UTIL/util.h"
 #include "UTIL/color.h"
 
 strong_cstr_t ir_value_str(ir_value_t *value){
@@ -194,6 +196,16 @@ strong_cstr_t ir_value_str(ir_value_t *value){
             return value_str;
         }
         break;
+    case VALUE_TYPE_OFFSETOF: {
+            ir_value_offsetof_t *offsetof_value = (ir_value_offsetof_t*) value->extra;
+            strong_cstr_t of = ir_type_str(offsetof_value->type);
+            value_str = malloc(40 + strlen(of));
+            sprintf(value_str, "offsetof %s %d", of, (int) offsetof_value->index);
+            free(typename);
+            free(of);
+            return value_str;
+        }
+        break;
     default:
         redprintf("INTERNAL ERROR: Unexpected value type of value in ir_value_str function\n");
         return NULL;
@@ -202,28 +214,136 @@ strong_cstr_t ir_value_str(ir_value_t *value){
     return NULL; // Should never get here
 }
 
-successful_t ir_type_map_find(ir_type_map_t *type_map, char *name, ir_type_t **type_ptr){
-    // Does a binary search on the type map to find the requested type by name
+bool ir_value_is_constant(ir_value_t *value){
+    switch(value->value_type){
+    case VALUE_TYPE_LITERAL:
+    case VALUE_TYPE_NULLPTR:
+    case VALUE_TYPE_NULLPTR_OF_TYPE:
+    case VALUE_TYPE_ANON_GLOBAL:
+    case VALUE_TYPE_CONST_ANON_GLOBAL:
+    case VALUE_TYPE_CSTR_OF_LEN:
+    case VALUE_TYPE_OFFSETOF:
+        return true;
+    case VALUE_TYPE_ARRAY_LITERAL: {
+            ir_value_array_literal_t *array_literal = (ir_value_array_literal_t*) value->extra;
+
+            for(length_t i = 0; i != array_literal->length; i++){
+                if(!ir_value_is_constant(array_literal->values[i])) return false;
+            }
+            return true;
+        }
+    case VALUE_TYPE_STRUCT_LITERAL: {
+            ir_value_struct_literal_t *struct_literal = (ir_value_struct_literal_t*) value->extra;
+
+            for(length_t i = 0; i != struct_literal->length; i++){
+                if(!ir_value_is_constant(struct_literal->values[i])) return false;
+            }
+            return true;
+        }
+    case VALUE_TYPE_CONST_BITCAST:
+        return ir_value_is_constant((ir_value_t*) value->extra);
+    }
 
-    ir_type_mapping_t *mappings = type_map->mappings;
-    length_t mappings_length = type_map->mappings_length;
-    int first = 0, middle, last = mappings_length - 1, comparison;
+    // Results and struct constructions are only known at runtime
+    return false;
+}
 
-    while(first <= last){
-        middle = (first + last) / 2;
-        comparison = strcmp(mappings[middle].name, name);
+successful_t ir_type_map_find(ir_type_map_t *type_map, char *name, ir_type_t **type_ptr){
+    hash_t hash = hash_cstr(name);
+    length_t cursor;
 
-        if(comparison == 0){
-            *type_ptr = &mappings[middle].type;
+    for(maybe_index_t i = hash_index_find(&type_map->index, hash, &cursor); i != -1; i = hash_index_find_next(&type_map->index, hash, &cursor)){
+        if(strcmp(type_map->mappings[i].name, name) == 0){
+            *type_ptr = &type_map->mappings[i].type;
             return true;
         }
-        else if(comparison > 0) last = middle - 1;
-        else first = middle + 1;
     }
 
     return false;
 }
 
+ir_value_t** ir_module_constant(ir_module_t *module, unsigned int value_type, ir_type_t *type, unsigned long long bits){
+    hash_t hash = hash_data(&value_type, sizeof(unsigned int));
+    hash = hash_continue(hash, &type, sizeof(ir_type_t*));
+    hash = hash_continue(hash, &bits, sizeof(unsigned long long));
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&module->constants_index, hash, &cursor); i != -1; i = hash_index_find_next(&module->constants_index, hash, &cursor)){
+        ir_constant_t *constant = &module->constants[i];
+        if(constant->value_type == value_type && constant->type == type && constant->bits == bits) return &constant->value;
+    }
+
+    expand((void**) &module->constants, sizeof(ir_constant_t), module->constants_length, &module->constants_capacity, 1, 64);
+    hash_index_insert(&module->constants_index, hash, module->constants_length);
+
+    ir_constant_t *constant = &module->constants[module->constants_length++];
+    constant->value_type = value_type;
+    constant->type = type;
+    constant->bits = bits;
+    constant->value = NULL;
+    return &constant->value;
+}
+
+ir_value_t **ir_instr_operand(ir_instr_t *instruction, length_t index){
+    switch(instruction->id){
+    case INSTRUCTION_ADD: case INSTRUCTION_FADD: case INSTRUCTION_SUBTRACT: case INSTRUCTION_FSUBTRACT:
+    case INSTRUCTION_MULTIPLY: case INSTRUCTION_FMULTIPLY: case INSTRUCTION_UDIVIDE: case INSTRUCTION_SDIVIDE:
+    case INSTRUCTION_FDIVIDE: case INSTRUCTION_UMODULUS: case INSTRUCTION_SMODULUS: case INSTRUCTION_FMODULUS:
+    case INSTRUCTION_EQUALS: case INSTRUCTION_FEQUALS: case INSTRUCTION_NOTEQUALS: case INSTRUCTION_FNOTEQUALS:
+    case INSTRUCTION_UGREATER: case INSTRUCTION_SGREATER: case INSTRUCTION_FGREATER:
+    case INSTRUCTION_ULESSER: case INSTRUCTION_SLESSER: case INSTRUCTION_FLESSER:
+    case INSTRUCTION_UGREATEREQ: case INSTRUCTION_SGREATEREQ: case INSTRUCTION_FGREATEREQ:
+    case INSTRUCTION_ULESSEREQ: case INSTRUCTION_SLESSEREQ: case INSTRUCTION_FLESSEREQ:
+    case INSTRUCTION_AND: case INSTRUCTION_OR: case INSTRUCTION_BIT_AND: case INSTRUCTION_BIT_OR: case INSTRUCTION_BIT_XOR:
+    case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT:
+    case INSTRUCTION_PTR_ADD: case INSTRUCTION_PTR_SUBTRACT: case INSTRUCTION_PTR_DIFFERENCE:
+        if(index == 0) return &((ir_instr_math_t*) instruction)->a;
+        if(index == 1) return &((ir_instr_math_t*) instruction)->b;
+        return NULL;
+    case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: case INSTRUCTION_BIT_COMPLEMENT:
+    case INSTRUCTION_NEGATE: case INSTRUCTION_FNEGATE:
+        return index == 0 ? &((ir_instr_unary_t*) instruction)->value : NULL;
+    case INSTRUCTION_BITCAST: case INSTRUCTION_ZEXT: case INSTRUCTION_TRUNC: case INSTRUCTION_FEXT:
+    case INSTRUCTION_FTRUNC: case INSTRUCTION_INTTOPTR: case INSTRUCTION_PTRTOINT: case INSTRUCTION_FPTOUI:
+    case INSTRUCTION_FPTOSI: case INSTRUCTION_UITOFP: case INSTRUCTION_SITOFP: case INSTRUCTION_REINTERPRET:
+        return index == 0 ? &((ir_instr_cast_t*) instruction)->value : NULL;
+    case INSTRUCTION_RET:
+        return index == 0 ? &((ir_instr_ret_t*) instruction)->value : NULL;
+    case INSTRUCTION_CALL:
+        return index < ((ir_instr_call_t*) instruction)->values_length ? &((ir_instr_call_t*) instruction)->values[index] : NULL;
+    case INSTRUCTION_CALL_ADDRESS:
+        if(index == 0) return &((ir_instr_call_address_t*) instruction)->address;
+        return index - 1 < ((ir_instr_call_address_t*) instruction)->values_length ? &((ir_instr_call_address_t*) instruction)->values[index - 1] : NULL;
+    case INSTRUCTION_MALLOC:
+        return index == 0 ? &((ir_instr_malloc_t*) instruction)->amount : NULL;
+    case INSTRUCTION_FREE:
+        return index == 0 ? &((ir_instr_free_t*) instruction)->value : NULL;
+    case INSTRUCTION_STORE:
+        if(index == 0) return &((ir_instr_store_t*) instruction)->value;
+        if(index == 1) return &((ir_instr_store_t*) instruction)->destination;
+        return NULL;
+    case INSTRUCTION_LOAD:
+        return index == 0 ? &((ir_instr_load_t*) instruction)->value : NULL;
+    case INSTRUCTION_CONDBREAK:
+        return index == 0 ? &((ir_instr_cond_break_t*) instruction)->value : NULL;
+    case INSTRUCTION_MEMBER:
+        return index == 0 ? &((ir_instr_member_t*) instruction)->value : NULL;
+    case INSTRUCTION_ARRAY_ACCESS:
+        if(index == 0) return &((ir_instr_array_access_t*) instruction)->value;
+        if(index == 1) return &((ir_instr_array_access_t*) instruction)->index;
+        return NULL;
+    case INSTRUCTION_MEMCPY:
+        if(index == 0) return &((ir_instr_memcpy_t*) instruction)->destination;
+        if(index == 1) return &((ir_instr_memcpy_t*) instruction)->value;
+        if(index == 2) return &((ir_instr_memcpy_t*) instruction)->bytes;
+        return NULL;
+    }
+
+    // (INSTRUCTION_VARPTR, INSTRUCTION_GLOBALVARPTR, INSTRUCTION_BREAK, INSTRUCTION_FUNC_ADDRESS,
+    //  INSTRUCTION_SIZEOF, INSTRUCTION_OFFSETOF, and INSTRUCTION_VARZEROINIT don't have any operands)
+    return NULL;
+}
+
 void ir_basicblock_new_instructions(ir_basicblock_t *block, length_t amount){
     // NOTE: Ensures that there is enough room for 'amount' more instructions
     // NOTE: If there isn't, more memory will be allocated so they can be generated
@@ -256,13 +376,11 @@ void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_leng
         char *ret_type_str = ir_type_str(functions[f].return_type);
         fprintf(file, "fn %s -> %s\n", functions[f].name, ret_type_str);
 
-        // Count the total number of instructions
-        length_t total_instructions = 0;
-        for(length_t b = 0; b != functions[f].basicblocks_length; b++) total_instructions += functions[f].basicblocks[b].instructions_length;
+        ir_flat_func_t *flat = &functions[f].flat;
 
         // Print functions statistics
         if(!(functions[f].traits & IR_FUNC_FOREIGN))
-            fprintf(file, "    {%d BBs, %d INSTRs, %d VARs}\n", (int) functions[f].basicblocks_length, (int) total_instructions, (int) functions[f].variable_count);
+            fprintf(file, "    {%d BBs, %d INSTRs, %d VARs}\n", (int) functions[f].basicblocks_length, (int) flat->instructions_length, (int) functions[f].variable_count);
 
         ir_dump_var_scope_layout(file, functions[f].var_scope);
 
@@ -270,12 +388,16 @@ void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_leng
 
         for(length_t b = 0; b != functions[f].basicblocks_length; b++){
             fprintf(file, "  BASICBLOCK |%d|\n", (int) b);
-            for(length_t i = 0; i != functions[f].basicblocks[b].instructions_length; i++){
-                switch(functions[f].basicblocks[b].instructions[i]->id){
+            length_t block_start = flat->block_starts[b];
+
+            for(length_t i = 0; i != flat->block_starts[b + 1] - block_start; i++){
+                ir_flat_instr_t *instr = &flat->instructions[block_start + i];
+                ir_flat_operand_t *operands = &flat->operands[instr->operands];
+
+                switch(instr->id){
                 case INSTRUCTION_RET: {
-                        ir_value_t *val = ((ir_instr_ret_t*) functions[f].basicblocks[b].instructions[i])->value;
-                        if(val != NULL){
-                            val_str = ir_value_str(val);
+                        if(IR_FLAT_OPERAND_KIND(operands[0]) != IR_FLAT_OPERAND_NONE){
+                            val_str = ir_flat_operand_str(flat, operands[0]);
                             fprintf(file, "    0x%08X ret %s\n", (int) i, val_str);
                             free(val_str);
                         } else {
@@ -284,54 +406,53 @@ void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_leng
                         break;
                     }
                 case INSTRUCTION_ADD:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "add");
+                    ir_dump_math_instruction(file, flat, instr, i, "add");
                     break;
                 case INSTRUCTION_FADD:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fadd");
+                    ir_dump_math_instruction(file, flat, instr, i, "fadd");
                     break;
                 case INSTRUCTION_SUBTRACT:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "sub");
+                    ir_dump_math_instruction(file, flat, instr, i, "sub");
                     break;
                 case INSTRUCTION_FSUBTRACT:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fsub");
+                    ir_dump_math_instruction(file, flat, instr, i, "fsub");
                     break;
                 case INSTRUCTION_MULTIPLY:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "mul");
+                    ir_dump_math_instruction(file, flat, instr, i, "mul");
                     break;
                 case INSTRUCTION_FMULTIPLY:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fmul");
+                    ir_dump_math_instruction(file, flat, instr, i, "fmul");
                     break;
                 case INSTRUCTION_UDIVIDE:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "udiv");
+                    ir_dump_math_instruction(file, flat, instr, i, "udiv");
                     break;
                 case INSTRUCTION_SDIVIDE:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "sdiv");
+                    ir_dump_math_instruction(file, flat, instr, i, "sdiv");
                     break;
                 case INSTRUCTION_FDIVIDE:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fdiv");
+                    ir_dump_math_instruction(file, flat, instr, i, "fdiv");
                     break;
                 case INSTRUCTION_UMODULUS:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "urem");
+                    ir_dump_math_instruction(file, flat, instr, i, "urem");
                     break;
                 case INSTRUCTION_SMODULUS:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "srem");
+                    ir_dump_math_instruction(file, flat, instr, i, "srem");
                     break;
                 case INSTRUCTION_FMODULUS:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "frem");
+                    ir_dump_math_instruction(file, flat, instr, i, "frem");
                     break;
                 case INSTRUCTION_CALL:
-                    ir_dump_call_instruction(file, (ir_instr_call_t*) functions[f].basicblocks[b].instructions[i], i);
+                    ir_dump_call_instruction(file, flat, instr, i);
                     break;
                 case INSTRUCTION_CALL_ADDRESS:
-                    ir_dump_call_address_instruction(file, (ir_instr_call_address_t*) functions[f].basicblocks[b].instructions[i], i);
+                    ir_dump_call_address_instruction(file, flat, instr, i);
                     break;
                 case INSTRUCTION_MALLOC: {
-                        ir_instr_malloc_t *malloc_instr = (ir_instr_malloc_t*) functions[f].basicblocks[b].instructions[i];
-                        char *typename = ir_type_str(malloc_instr->type);
-                        if(malloc_instr->amount == NULL){
+                        char *typename = ir_type_str((ir_type_t*) instr->extra);
+                        if(IR_FLAT_OPERAND_KIND(operands[0]) == IR_FLAT_OPERAND_NONE){
                             fprintf(file, "    0x%08X malloc %s\n", (int) i, typename);
                         } else {
-                            char *a = ir_value_str(malloc_instr->amount);
+                            char *a = ir_flat_operand_str(flat, operands[0]);
                             fprintf(file, "    0x%08X malloc %s * %s\n", (int) i, typename, a);
                             free(a);
                         }
@@ -339,109 +460,109 @@ void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_leng
                     }
                     break;
                 case INSTRUCTION_FREE: {
-                        val_str = ir_value_str(((ir_instr_free_t*) functions[f].basicblocks[b].instructions[i])->value);
+                        val_str = ir_flat_operand_str(flat, operands[0]);
                         fprintf(file, "    0x%08X free %s\n", (int) i, val_str);
                         free(val_str);
                     }
                     break;
                 case INSTRUCTION_STORE:
-                    val_str = ir_value_str(((ir_instr_store_t*) functions[f].basicblocks[b].instructions[i])->value);
-                    dest_str = ir_value_str(((ir_instr_store_t*) functions[f].basicblocks[b].instructions[i])->destination);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
+                    dest_str = ir_flat_operand_str(flat, operands[1]);
                     fprintf(file, "    0x%08X store %s, %s\n", (int) i, dest_str, val_str);
                     free(val_str);
                     free(dest_str);
                     break;
                 case INSTRUCTION_LOAD:
-                    val_str = ir_value_str(((ir_instr_load_t*) functions[f].basicblocks[b].instructions[i])->value);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
                     fprintf(file, "    0x%08X load %s\n", (int) i, val_str);
                     free(val_str);
                     break;
                 case INSTRUCTION_VARPTR: {
-                        char *var_type = ir_type_str(functions[f].basicblocks[b].instructions[i]->result_type);
-                        fprintf(file, "    0x%08X var %s 0x%08X\n", (int) i, var_type, (int) ((ir_instr_varptr_t*) functions[f].basicblocks[b].instructions[i])->index);
+                        char *var_type = ir_type_str(instr->result_type);
+                        fprintf(file, "    0x%08X var %s 0x%08X\n", (int) i, var_type, (int) instr->details[0]);
                         free(var_type);
                     }
                     break;
                 case INSTRUCTION_GLOBALVARPTR: {
-                        char *var_type = ir_type_str(functions[f].basicblocks[b].instructions[i]->result_type);
-                        fprintf(file, "    0x%08X gvar %s 0x%08X\n", (int) i, var_type, (int) ((ir_instr_varptr_t*) functions[f].basicblocks[b].instructions[i])->index);
+                        char *var_type = ir_type_str(instr->result_type);
+                        fprintf(file, "    0x%08X gvar %s 0x%08X\n", (int) i, var_type, (int) instr->details[0]);
                         free(var_type);
                     }
                     break;
                 case INSTRUCTION_BREAK:
-                    fprintf(file, "    0x%08X br |%d|\n", (int) i, (int) ((ir_instr_break_t*) functions[f].basicblocks[b].instructions[i])->block_id);
+                    fprintf(file, "    0x%08X br |%d|\n", (int) i, (int) instr->details[0]);
                     break;
                 case INSTRUCTION_CONDBREAK:
-                    val_str = ir_value_str(((ir_instr_cond_break_t*) functions[f].basicblocks[b].instructions[i])->value);
-                    fprintf(file, "    0x%08X cbr %s, |%d|, |%d|\n", (int) i, val_str, (int) ((ir_instr_cond_break_t*) functions[f].basicblocks[b].instructions[i])->true_block_id,
-                        (int) ((ir_instr_cond_break_t*) functions[f].basicblocks[b].instructions[i])->false_block_id);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
+                    fprintf(file, "    0x%08X cbr %s, |%d|, |%d|\n", (int) i, val_str, (int) instr->details[0],
+                        (int) instr->details[1]);
                     free(val_str);
                     break;
                 case INSTRUCTION_EQUALS:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "eq");
+                    ir_dump_math_instruction(file, flat, instr, i, "eq");
                     break;
                 case INSTRUCTION_FEQUALS:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "feq");
+                    ir_dump_math_instruction(file, flat, instr, i, "feq");
                     break;
                 case INSTRUCTION_NOTEQUALS:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "neq");
+                    ir_dump_math_instruction(file, flat, instr, i, "neq");
                     break;
                 case INSTRUCTION_FNOTEQUALS:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fneq");
+                    ir_dump_math_instruction(file, flat, instr, i, "fneq");
                     break;
                 case INSTRUCTION_UGREATER:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "ugt");
+                    ir_dump_math_instruction(file, flat, instr, i, "ugt");
                     break;
                 case INSTRUCTION_SGREATER:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "sgt");
+                    ir_dump_math_instruction(file, flat, instr, i, "sgt");
                     break;
                 case INSTRUCTION_FGREATER:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fgt");
+                    ir_dump_math_instruction(file, flat, instr, i, "fgt");
                     break;
                 case INSTRUCTION_ULESSER:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "ult");
+                    ir_dump_math_instruction(file, flat, instr, i, "ult");
                     break;
                 case INSTRUCTION_SLESSER:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "slt");
+                    ir_dump_math_instruction(file, flat, instr, i, "slt");
                     break;
                 case INSTRUCTION_FLESSER:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "flt");
+                    ir_dump_math_instruction(file, flat, instr, i, "flt");
                     break;
                 case INSTRUCTION_UGREATEREQ:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "uge");
+                    ir_dump_math_instruction(file, flat, instr, i, "uge");
                     break;
                 case INSTRUCTION_SGREATEREQ:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "sge");
+                    ir_dump_math_instruction(file, flat, instr, i, "sge");
                     break;
                 case INSTRUCTION_FGREATEREQ:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fge");
+                    ir_dump_math_instruction(file, flat, instr, i, "fge");
                     break;
                 case INSTRUCTION_ULESSEREQ:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "ule");
+                    ir_dump_math_instruction(file, flat, instr, i, "ule");
                     break;
                 case INSTRUCTION_SLESSEREQ:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "sle");
+                    ir_dump_math_instruction(file, flat, instr, i, "sle");
                     break;
                 case INSTRUCTION_FLESSEREQ:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "fle");
+                    ir_dump_math_instruction(file, flat, instr, i, "fle");
                     break;
                 case INSTRUCTION_MEMBER:
-                    val_str = ir_value_str(((ir_instr_member_t*) functions[f].basicblocks[b].instructions[i])->value);
-                    fprintf(file, "    0x%08X memb %s, %d\n", (unsigned int) i, val_str, (int) ((ir_instr_member_t*) functions[f].basicblocks[b].instructions[i])->member);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
+                    fprintf(file, "    0x%08X memb %s, %d\n", (unsigned int) i, val_str, (int) instr->details[0]);
                     free(val_str);
                     break;
                 case INSTRUCTION_ARRAY_ACCESS:
-                    val_str = ir_value_str(((ir_instr_array_access_t*) functions[f].basicblocks[b].instructions[i])->value);
-                    idx_str = ir_value_str(((ir_instr_array_access_t*) functions[f].basicblocks[b].instructions[i])->index);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
+                    idx_str = ir_flat_operand_str(flat, operands[1]);
                     fprintf(file, "    0x%08X arracc %s, %s\n", (unsigned int) i, val_str, idx_str);
                     free(val_str);
                     free(idx_str);
                     break;
                 case INSTRUCTION_FUNC_ADDRESS:
-                    if(((ir_instr_func_address_t*) functions[f].basicblocks[b].instructions[i])->name == NULL)
-                        fprintf(file, "    0x%08X funcaddr 0x%X\n", (unsigned int) i, (int) ((ir_instr_func_address_t*) functions[f].basicblocks[b].instructions[i])->func_id);
+                    if(instr->extra == NULL)
+                        fprintf(file, "    0x%08X funcaddr 0x%X\n", (unsigned int) i, (int) instr->details[0]);
                     else
-                        fprintf(file, "    0x%08X funcaddr %s\n", (unsigned int) i, ((ir_instr_func_address_t*) functions[f].basicblocks[b].instructions[i])->name);
+                        fprintf(file, "    0x%08X funcaddr %s\n", (unsigned int) i, (const char*) instr->extra);
                     break;
                 case INSTRUCTION_BITCAST: case INSTRUCTION_ZEXT:
                 case INSTRUCTION_FEXT: case INSTRUCTION_TRUNC:
@@ -452,7 +573,7 @@ void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_leng
                 case INSTRUCTION_ISNTZERO: {
                         char *instr_name = "";
 
-                        switch(functions[f].basicblocks[b].instructions[i]->id){
+                        switch(instr->id){
                         case INSTRUCTION_BITCAST:     instr_name = "bc";     break;
                         case INSTRUCTION_ZEXT:        instr_name = "zext";   break;
                         case INSTRUCTION_FEXT:        instr_name = "fext";   break;
@@ -468,51 +589,60 @@ void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_leng
                         case INSTRUCTION_REINTERPRET: instr_name = "reinterp";  break;
                         }
 
-                        char *to_type = ir_type_str(functions[f].basicblocks[b].instructions[i]->result_type);
-                        val_str = ir_value_str(((ir_instr_cast_t*) functions[f].basicblocks[b].instructions[i])->value);
+                        char *to_type = ir_type_str(instr->result_type);
+                        val_str = ir_flat_operand_str(flat, operands[0]);
                         fprintf(file, "    0x%08X %s %s to %s\n", (int) i, instr_name, val_str, to_type);
                         free(to_type);
                         free(val_str);
                     }
                     break;
                 case INSTRUCTION_AND:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "and");
+                    ir_dump_math_instruction(file, flat, instr, i, "and");
                     break;
                 case INSTRUCTION_OR:
-                    ir_dump_math_instruction(file, (ir_instr_math_t*) functions[f].basicblocks[b].instructions[i], i, "or");
+                    ir_dump_math_instruction(file, flat, instr, i, "or");
                     break;
                 case INSTRUCTION_SIZEOF: {
-                        char *typename = ir_type_str(((ir_instr_sizeof_t*) functions[f].basicblocks[b].instructions[i])->type);
+                        char *typename = ir_type_str((ir_type_t*) instr->extra);
                         fprintf(file, "    0x%08X sizeof %s\n", (int) i, typename);
                         free(typename);
                     }
                     break;
                 case INSTRUCTION_OFFSETOF: {
-                        char *typename = ir_type_str(((ir_instr_offsetof_t*) functions[f].basicblocks[b].instructions[i])->type);
+                        char *typename = ir_type_str((ir_type_t*) instr->extra);
                         fprintf(file, "    0x%08X offsetof %s\n", (int) i, typename);
                         free(typename);
                     }
                     break;
                 case INSTRUCTION_VARZEROINIT:
-                    fprintf(file, "    0x%08X varzi 0x%08X\n", (int) i, (int) ((ir_instr_varptr_t*) functions[f].basicblocks[b].instructions[i])->index);
+                    fprintf(file, "    0x%08X varzi 0x%08X\n", (int) i, (int) instr->details[0]);
                     break;
                 case INSTRUCTION_BIT_COMPLEMENT:
-                    val_str = ir_value_str(((ir_instr_load_t*) functions[f].basicblocks[b].instructions[i])->value);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
                     fprintf(file, "    0x%08X compl %s\n", (int) i, val_str);
                     free(val_str);
                     break;
                 case INSTRUCTION_NEGATE:
-                    val_str = ir_value_str(((ir_instr_load_t*) functions[f].basicblocks[b].instructions[i])->value);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
                     fprintf(file, "    0x%08X neg %s\n", (int) i, val_str);
                     free(val_str);
                     break;
+                case INSTRUCTION_PTR_ADD:
+                    ir_dump_math_instruction(file, flat, instr, i, "ptradd");
+                    break;
+                case INSTRUCTION_PTR_SUBTRACT:
+                    ir_dump_math_instruction(file, flat, instr, i, "ptrsub");
+                    break;
+                case INSTRUCTION_PTR_DIFFERENCE:
+                    ir_dump_math_instruction(file, flat, instr, i, "ptrdiff");
+                    break;
                 case INSTRUCTION_FNEGATE:
-                    val_str = ir_value_str(((ir_instr_load_t*) functions[f].basicblocks[b].instructions[i])->value);
+                    val_str = ir_flat_operand_str(flat, operands[0]);
                     fprintf(file, "    0x%08X fneg %s\n", (int) i, val_str);
                     free(val_str);
                     break;
                 default:
-                    printf("Unknown instruction id 0x%08X when dumping ir module\n", (int) functions[f].basicblocks[b].instructions[i]->id);
+                    printf("Unknown instruction id 0x%08X when dumping ir module\n", (int) instr->id);
                     fprintf(file, "    0x%08X <unknown instruction>\n", (int) i);
                 }
             }
@@ -522,25 +652,27 @@ void ir_dump_functions(FILE *file, ir_func_t *functions, length_t functions_leng
     }
 }
 
-void ir_dump_math_instruction(FILE *file, ir_instr_math_t *instruction, int i, const char *instruction_name){
-    char *val_str_1 = ir_value_str(instruction->a);
-    char *val_str_2 = ir_value_str(instruction->b);
+void ir_dump_math_instruction(FILE *file, ir_flat_func_t *flat, ir_flat_instr_t *instruction, int i, const char *instruction_name){
+    char *val_str_1 = ir_flat_operand_str(flat, flat->operands[instruction->operands]);
+    char *val_str_2 = ir_flat_operand_str(flat, flat->operands[instruction->operands + 1]);
     fprintf(file, "    0x%08X %s %s, %s\n", i, instruction_name, val_str_1, val_str_2);
     free(val_str_1);
     free(val_str_2);
 }
 
-void ir_dump_call_instruction(FILE *file, ir_instr_call_t *instruction, int i){
+void ir_dump_call_instruction(FILE *file, ir_flat_func_t *flat, ir_flat_instr_t *instruction, int i){
+    ir_flat_operand_t *values = &flat->operands[instruction->operands];
+    length_t values_length = instruction->operands_length;
     char *call_args = malloc(256);
     length_t call_args_length = 0;
     length_t call_args_capacity = 256;
     char *call_result_type = ir_type_str(instruction->result_type);
     call_args[0] = '\0';
 
-    for(length_t i = 0; i != instruction->values_length; i++){
-        char *arg = ir_value_str(instruction->values[i]);
+    for(length_t i = 0; i != values_length; i++){
+        char *arg = ir_flat_operand_str(flat, values[i]);
         length_t arg_length = strlen(arg);
-        length_t target_length = call_args_length + arg_length + (i + 1 == instruction->values_length ? 1 : 3);
+        length_t target_length = call_args_length + arg_length + (i + 1 == values_length ? 1 : 3);
 
         while(target_length >= call_args_capacity){ // Three is for "\0" + possible ", "
             call_args_capacity *= 2;
@@ -552,27 +684,30 @@ void ir_dump_call_instruction(FILE *file, ir_instr_call_t *instruction, int i){
 
         memcpy(&call_args[call_args_length], arg, arg_length + 1);
         call_args_length += arg_length;
-        if(i + 1 != instruction->values_length) memcpy(&call_args[call_args_length], ", ", 2);
+        if(i + 1 != values_length) memcpy(&call_args[call_args_length], ", ", 2);
         call_args_length += 2;
         free(arg);
     }
 
-    fprintf(file, "    0x%08X call adept_%X(%s) %s\n", i, (int) instruction->func_id, call_args, call_result_type);
+    fprintf(file, "    0x%08X call adept_%X(%s) %s\n", i, (int) instruction->details[0], call_args, call_result_type);
     free(call_args);
     free(call_result_type);
 }
 
-void ir_dump_call_address_instruction(FILE *file, ir_instr_call_address_t *instruction, int i){
+void ir_dump_call_address_instruction(FILE *file, ir_flat_func_t *flat, ir_flat_instr_t *instruction, int i){
+    // (The first operand is the address, and the rest are the arguments)
+    ir_flat_operand_t *values = &flat->operands[instruction->operands + 1];
+    length_t values_length = instruction->operands_length - 1;
     char *call_args = malloc(256);
     length_t call_args_length = 0;
     length_t call_args_capacity = 256;
     char *call_result_type = ir_type_str(instruction->result_type);
     call_args[0] = '\0';
 
-    for(length_t i = 0; i != instruction->values_length; i++){
-        char *arg = ir_value_str(instruction->values[i]);
+    for(length_t i = 0; i != values_length; i++){
+        char *arg = ir_flat_operand_str(flat, values[i]);
         length_t arg_length = strlen(arg);
-        length_t target_length = call_args_length + arg_length + (i + 1 == instruction->values_length ? 1 : 3);
+        length_t target_length = call_args_length + arg_length + (i + 1 == values_length ? 1 : 3);
 
         while(target_length >= call_args_capacity){ // Three is for "\0" + possible ", "
             call_args_capacity *= 2;
@@ -584,12 +719,12 @@ void ir_dump_call_address_instruction(FILE *file, ir_instr_call_address_t *instr
 
         memcpy(&call_args[call_args_length], arg, arg_length + 1);
         call_args_length += arg_length;
-        if(i + 1 != instruction->values_length) memcpy(&call_args[call_args_length], ", ", 2);
+        if(i + 1 != values_length) memcpy(&call_args[call_args_length], ", ", 2);
         call_args_length += 2;
         free(arg);
     }
 
-    char *call_address = ir_value_str(instruction->address);
+    char *call_address = ir_flat_operand_str(flat, flat->operands[instruction->operands]);
     fprintf(file, "    0x%08X calladdr %s(%s) %s\n", i, call_address, call_args, call_result_type);
     free(call_address);
     free(call_args);
@@ -610,8 +745,10 @@ void ir_dump_var_scope_layout(FILE *file, bridge_var_scope_t *scope){
     }
 }
 
-void ir_module_init(ir_module_t *ir_module, length_t funcs_length, length_t globals_length){
-    ir_pool_init(&ir_module->pool);
+void ir_module_init(ir_module_t *ir_module, length_t funcs_length, length_t globals_length, length_t pool_size){
+    ir_pool_init_sized(&ir_module->pool, pool_size);
+    ir_pool_init(&ir_module->shared_pool);
+    ir_type_interner_init(&ir_module->type_interner, &ir_module->shared_pool);
 
     ir_module->funcs = malloc(sizeof(ir_func_t) * funcs_length);
     ir_module->funcs_length = 0;
@@ -619,29 +756,77 @@ void ir_module_init(ir_module_t *ir_module, length_t funcs_length, length_t glob
     ir_module->methods = NULL;
     ir_module->methods_length = 0;
     ir_module->methods_capacity = 0;
+    hash_index_init(&ir_module->func_groups);
+    hash_index_init(&ir_module->func_signatures);
+    hash_index_init(&ir_module->method_groups);
+    hash_index_init(&ir_module->method_signatures);
+    ast_type_interner_init(&ir_module->ast_type_interner);
+    ir_module->managements = NULL;
+    ir_module->managements_length = 0;
+    ir_module->managements_capacity = 0;
+    hash_index_init(&ir_module->managements_index);
+    ir_module->constants = NULL;
+    ir_module->constants_length = 0;
+    ir_module->constants_capacity = 0;
+    hash_index_init(&ir_module->constants_index);
     ir_module->type_map.mappings = NULL;
+    hash_index_init(&ir_module->type_map.index);
     ir_module->globals = malloc(sizeof(ir_global_t) * globals_length);
     ir_module->globals_length = 0;
+    hash_index_init(&ir_module->globals_index);
     ir_module->anon_globals = NULL;
     ir_module->anon_globals_length = 0;
     ir_module->anon_globals_capacity = 0;
+    ir_module->rtti_relocations = NULL;
+    ir_module->rtti_relocations_length = 0;
+    ir_module->rtti_relocations_capacity = 0;
 
     // Initialize common data
     ir_module->common.ir_funcptr = NULL;
+    ir_module->common.ir_int = NULL;
     ir_module->common.ir_usize = NULL;
     ir_module->common.ir_usize_ptr = NULL;
     ir_module->common.ir_bool = NULL;
+    ir_module->common.ir_ptrdiff = NULL;
+    ir_module->common.rtti_array_index = -1;
 }
 
 void ir_module_free(ir_module_t *ir_module){
     ir_module_free_funcs(ir_module->funcs, ir_module->funcs_length);
+
+    for(length_t f = 0; f != ir_module->funcs_length; f++){
+        free(ir_module->func_mappings[f].arg_types);
+    }
+
+    for(length_t m = 0; m != ir_module->methods_length; m++){
+        free(ir_module->methods[m].arg_types);
+    }
+
     free(ir_module->funcs);
     free(ir_module->func_mappings);
     free(ir_module->methods);
+    hash_index_free(&ir_module->func_groups);
+    hash_index_free(&ir_module->func_signatures);
+    hash_index_free(&ir_module->method_groups);
+    hash_index_free(&ir_module->method_signatures);
+    ast_type_interner_free(&ir_module->ast_type_interner);
+
+    for(length_t i = 0; i != ir_module->managements_length; i++){
+        free(ir_module->managements[i].type_name);
+    }
+    free(ir_module->managements);
+    hash_index_free(&ir_module->managements_index);
+    free(ir_module->constants);
+    hash_index_free(&ir_module->constants_index);
     free(ir_module->type_map.mappings);
+    hash_index_free(&ir_module->type_map.index);
+    ir_type_interner_free(&ir_module->type_interner);
     free(ir_module->globals);
+    hash_index_free(&ir_module->globals_index);
     free(ir_module->anon_globals);
+    free(ir_module->rtti_relocations);
     ir_pool_free(&ir_module->pool);
+    ir_pool_free(&ir_module->shared_pool);
 }
 
 void ir_module_free_funcs(ir_func_t *funcs, length_t funcs_length){
@@ -651,6 +836,7 @@ void ir_module_free_funcs(ir_func_t *funcs, length_t funcs_length){
         }
         free(funcs[f].basicblocks);
         free(funcs[f].argument_types);
+        ir_flat_func_free(&funcs[f].flat);
 
         if(funcs[f].var_scope != NULL){
             bridge_var_scope_free(funcs[f].var_scope);
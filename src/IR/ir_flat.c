@@ -0,0 +1,243 @@
+
+#include "IR/ir.h"
+#include "IR/ir_flat.h"
+#include "UTIL/util.h"
+#include "UTIL/color.h"
+
+void ir_flatten_module(ir_module_t *module){
+    for(length_t f = 0; f != module->funcs_length; f++){
+        ir_flatten_func(&module->funcs[f]);
+    }
+}
+
+void ir_flatten_func(ir_func_t *func){
+    ir_flat_func_t *flat = &func->flat;
+    ir_flat_func_free(flat);
+    ir_flat_func_init(flat);
+
+    // Foreign functions don't have any basic blocks
+    if(func->basicblocks_length == 0) return;
+
+    // Find where the instructions of each basic block will start, so
+    // that results can be referred to before they are reached
+    flat->block_starts = malloc(sizeof(length_t) * (func->basicblocks_length + 1));
+    flat->blocks_length = func->basicblocks_length;
+
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        flat->block_starts[b] = flat->instructions_length;
+        flat->instructions_length += func->basicblocks[b].instructions_length;
+    }
+
+    flat->block_starts[func->basicblocks_length] = flat->instructions_length;
+    flat->instructions = malloc(sizeof(ir_flat_instr_t) * flat->instructions_length);
+    flat->sources = malloc(sizeof(source_t) * flat->instructions_length);
+
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        ir_basicblock_t *block = &func->basicblocks[b];
+
+        for(length_t i = 0; i != block->instructions_length; i++){
+            ir_instr_t *instruction = block->instructions[i];
+            length_t position = flat->block_starts[b] + i;
+            ir_flat_instr_t *flat_instr = &flat->instructions[position];
+
+            flat_instr->id = instruction->id;
+            flat_instr->operands = flat->operands_length;
+            flat_instr->details[0] = 0;
+            flat_instr->details[1] = 0;
+            flat_instr->result_type = instruction->result_type;
+            flat_instr->extra = NULL;
+            flat->sources[position] = instruction->source;
+
+            ir_value_t **operand;
+            length_t operands_length = 0;
+
+            while((operand = ir_instr_operand(instruction, operands_length))){
+                ir_flat_operand_t flat_operand = ir_flatten_operand(flat, *operand);
+                expand((void**) &flat->operands, sizeof(ir_flat_operand_t), flat->operands_length, &flat->operands_capacity, 1, 16);
+                flat->operands[flat->operands_length++] = flat_operand;
+                operands_length++;
+            }
+
+            flat_instr->operands_length = operands_length;
+
+            switch(instruction->id){
+            case INSTRUCTION_CALL:
+                flat_instr->details[0] = ((ir_instr_call_t*) instruction)->func_id;
+                break;
+            case INSTRUCTION_FUNC_ADDRESS:
+                flat_instr->details[0] = ((ir_instr_func_address_t*) instruction)->func_id;
+                flat_instr->extra = (void*) ((ir_instr_func_address_t*) instruction)->name;
+                break;
+            case INSTRUCTION_VARPTR: case INSTRUCTION_GLOBALVARPTR:
+                flat_instr->details[0] = ((ir_instr_varptr_t*) instruction)->index;
+                break;
+            case INSTRUCTION_VARZEROINIT:
+                flat_instr->details[0] = ((ir_instr_varzeroinit_t*) instruction)->index;
+                break;
+            case INSTRUCTION_BREAK:
+                flat_instr->details[0] = ((ir_instr_break_t*) instruction)->block_id;
+                break;
+            case INSTRUCTION_CONDBREAK:
+                flat_instr->details[0] = ((ir_instr_cond_break_t*) instruction)->true_block_id;
+                flat_instr->details[1] = ((ir_instr_cond_break_t*) instruction)->false_block_id;
+                break;
+            case INSTRUCTION_MEMBER:
+                flat_instr->details[0] = ((ir_instr_member_t*) instruction)->member;
+                break;
+            case INSTRUCTION_MALLOC:
+                flat_instr->extra = ((ir_instr_malloc_t*) instruction)->type;
+                break;
+            case INSTRUCTION_SIZEOF:
+                flat_instr->extra = ((ir_instr_sizeof_t*) instruction)->type;
+                break;
+            case INSTRUCTION_OFFSETOF:
+                flat_instr->details[0] = ((ir_instr_offsetof_t*) instruction)->index;
+                flat_instr->extra = ((ir_instr_offsetof_t*) instruction)->type;
+                break;
+            case INSTRUCTION_MEMCPY:
+                flat_instr->details[0] = ((ir_instr_memcpy_t*) instruction)->is_volatile;
+                break;
+            }
+        }
+    }
+}
+
+ir_flat_operand_t ir_flatten_operand(ir_flat_func_t *flat, ir_value_t *value){
+    if(value == NULL) return IR_FLAT_OPERAND(IR_FLAT_OPERAND_NONE, 0);
+
+    if(value->value_type == VALUE_TYPE_RESULT){
+        ir_value_result_t *result = (ir_value_result_t*) value->extra;
+        return IR_FLAT_OPERAND(IR_FLAT_OPERAND_RESULT, flat->block_starts[result->block_id] + result->instruction_id);
+    }
+
+    if(value->value_type == VALUE_TYPE_LITERAL){
+        // NOTE: Reads each kind of literal the same way that 'ir_value_str' does
+        unsigned long long bits;
+        bool is_inline = true;
+
+        switch(value->type->kind){
+        case TYPE_KIND_S8:      bits = (unsigned long long) *((char*) value->extra); break;
+        case TYPE_KIND_U8:      bits = *((unsigned char*) value->extra); break;
+        case TYPE_KIND_S16:     bits = (unsigned long long) *((int*) value->extra); break;
+        case TYPE_KIND_U16:     bits = *((unsigned int*) value->extra); break;
+        case TYPE_KIND_S32:     bits = (unsigned long long) *((long long*) value->extra); break;
+        case TYPE_KIND_U32:     bits = *((unsigned long long*) value->extra); break;
+        case TYPE_KIND_S64:     bits = (unsigned long long) *((long long*) value->extra); break;
+        case TYPE_KIND_U64:     bits = *((unsigned long long*) value->extra); break;
+        case TYPE_KIND_BOOLEAN: bits = *((bool*) value->extra); break;
+        case TYPE_KIND_FLOAT: case TYPE_KIND_DOUBLE:
+            memcpy(&bits, value->extra, sizeof(double));
+            break;
+        default:
+            // Other literals (like null-terminated strings) stay as values
+            is_inline = false;
+        }
+
+        if(is_inline){
+            expand((void**) &flat->literals, sizeof(ir_flat_literal_t), flat->literals_length, &flat->literals_capacity, 1, 8);
+            flat->literals[flat->literals_length].type = value->type;
+            flat->literals[flat->literals_length].bits = bits;
+            return IR_FLAT_OPERAND(IR_FLAT_OPERAND_LITERAL, flat->literals_length++);
+        }
+    }
+
+    expand((void**) &flat->values, sizeof(ir_value_t*), flat->values_length, &flat->values_capacity, 1, 8);
+    flat->values[flat->values_length] = value;
+    return IR_FLAT_OPERAND(IR_FLAT_OPERAND_VALUE, flat->values_length++);
+}
+
+ir_type_t *ir_flat_operand_type(ir_flat_func_t *flat, ir_flat_operand_t operand){
+    length_t index = IR_FLAT_OPERAND_INDEX(operand);
+
+    switch(IR_FLAT_OPERAND_KIND(operand)){
+    case IR_FLAT_OPERAND_RESULT:  return flat->instructions[index].result_type;
+    case IR_FLAT_OPERAND_LITERAL: return flat->literals[index].type;
+    case IR_FLAT_OPERAND_VALUE:   return flat->values[index]->type;
+    }
+
+    return NULL;
+}
+
+strong_cstr_t ir_flat_operand_str(ir_flat_func_t *flat, ir_flat_operand_t operand){
+    length_t index = IR_FLAT_OPERAND_INDEX(operand);
+
+    switch(IR_FLAT_OPERAND_KIND(operand)){
+    case IR_FLAT_OPERAND_RESULT: {
+            // NOTE: Results are shown as the basic block and index within it that they come from
+            length_t block_id = ir_flat_block_of(flat, index);
+            char *typename = ir_type_str(flat->instructions[index].result_type);
+            char *value_str = malloc(strlen(typename) + 28);
+            sprintf(value_str, "%s >|%d| 0x%08X<", typename, (int) block_id, (int) (index - flat->block_starts[block_id]));
+            free(typename);
+            return value_str;
+        }
+    case IR_FLAT_OPERAND_LITERAL: {
+            ir_flat_literal_t *literal = &flat->literals[index];
+            char *typename = ir_type_str(literal->type);
+            char *value_str = malloc(strlen(typename) + 21);
+
+            if(literal->type->kind == TYPE_KIND_FLOAT || literal->type->kind == TYPE_KIND_DOUBLE){
+                double float_value;
+                memcpy(&float_value, &literal->bits, sizeof(double));
+                sprintf(value_str, "%s %06.6f", typename, float_value);
+            } else if(literal->type->kind == TYPE_KIND_BOOLEAN){
+                sprintf(value_str, "%s %s", typename, literal->bits ? "true" : "false");
+            } else {
+                sprintf(value_str, "%s %d", typename, (int) literal->bits);
+            }
+
+            free(typename);
+            return value_str;
+        }
+    case IR_FLAT_OPERAND_VALUE:
+        return ir_value_str(flat->values[index]);
+    }
+
+    redprintf("INTERNAL ERROR: ir_flat_operand_str() got an operand without a value\n");
+    return strclone("");
+}
+
+length_t ir_flat_block_of(ir_flat_func_t *flat, length_t instruction){
+    // Binary search for the last basic block that starts at or before the instruction
+    // NOTE: Empty basic blocks start at the same place as the one after them
+    length_t first = 0;
+    length_t last = flat->blocks_length - 1;
+
+    while(first != last){
+        length_t middle = first + (last - first + 1) / 2;
+
+        if(flat->block_starts[middle] <= instruction){
+            first = middle;
+        } else {
+            last = middle - 1;
+        }
+    }
+
+    return first;
+}
+
+void ir_flat_func_init(ir_flat_func_t *flat){
+    flat->instructions = NULL;
+    flat->sources = NULL;
+    flat->instructions_length = 0;
+    flat->block_starts = NULL;
+    flat->blocks_length = 0;
+    flat->operands = NULL;
+    flat->operands_length = 0;
+    flat->operands_capacity = 0;
+    flat->literals = NULL;
+    flat->literals_length = 0;
+    flat->literals_capacity = 0;
+    flat->values = NULL;
+    flat->values_length = 0;
+    flat->values_capacity = 0;
+}
+
+void ir_flat_func_free(ir_flat_func_t *flat){
+    free(flat->instructions);
+    free(flat->sources);
+    free(flat->block_starts);
+    free(flat->operands);
+    free(flat->literals);
+    free(flat->values);
+}
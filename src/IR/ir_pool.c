@@ -1,40 +1,73 @@
 
+#include "UTIL/util.h"
 #include "IR/ir_pool.h"
 
 void ir_pool_init(ir_pool_t *pool){
+    ir_pool_init_sized(pool, IR_POOL_DEFAULT_FRAGMENT_SIZE);
+}
+
+void ir_pool_init_sized(ir_pool_t *pool, length_t initial_size){
+    if(initial_size < IR_POOL_MAX_ALIGNMENT) initial_size = IR_POOL_MAX_ALIGNMENT;
+
     pool->fragments = malloc(sizeof(ir_pool_fragment_t) * 4);
     pool->fragments_length = 1;
     pool->fragments_capacity = 4;
-    pool->fragments[0].memory = malloc(512);
+    pool->fragments[0].memory = malloc(initial_size);
     pool->fragments[0].used = 0;
-    pool->fragments[0].capacity = 512;
+    pool->fragments[0].capacity = initial_size;
+    pool->spare_fragments = NULL;
+    pool->spare_fragments_length = 0;
+    pool->spare_fragments_capacity = 0;
 }
 
 void* ir_pool_alloc(ir_pool_t *pool, length_t bytes){
+    // Use the natural alignment of a type of this size
+    length_t alignment = bytes & (~bytes + 1);
+    if(alignment == 0 || alignment > IR_POOL_MAX_ALIGNMENT) alignment = IR_POOL_MAX_ALIGNMENT;
+
+    return ir_pool_alloc_aligned(pool, bytes, alignment);
+}
+
+void* ir_pool_alloc_aligned(ir_pool_t *pool, length_t bytes, length_t alignment){
     // NOTE: Allocates memory in an ir_pool_t
     ir_pool_fragment_t *recent_fragment = &pool->fragments[pool->fragments_length - 1];
 
-    while(recent_fragment->used + bytes >= recent_fragment->capacity){
-        if(pool->fragments_length == pool->fragments_capacity){
-            pool->fragments_capacity *= 2;
-            ir_pool_fragment_t *new_fragments = malloc(sizeof(ir_pool_fragment_t) * pool->fragments_capacity);
-            memcpy(new_fragments, pool->fragments, sizeof(ir_pool_fragment_t) * pool->fragments_length);
-            free(pool->fragments);
-            pool->fragments = new_fragments;
+    // NOTE: Fragment memory comes from malloc, so it's already aligned for any type
+    length_t offset = (recent_fragment->used + alignment - 1) & ~(alignment - 1);
 
-            // Update recent_fragment pointer to point into new array
-            recent_fragment = &pool->fragments[pool->fragments_length - 1];
-        }
+    if(offset + bytes > recent_fragment->capacity){
+        length_t capacity = recent_fragment->capacity * 2;
+        if(capacity > IR_POOL_MAX_FRAGMENT_SIZE) capacity = IR_POOL_MAX_FRAGMENT_SIZE;
+        if(capacity < bytes) capacity = bytes;
+
+        // NOTE: 'recent_fragment' is invalid once the fragments array is expanded
+        expand((void**) &pool->fragments, sizeof(ir_pool_fragment_t), pool->fragments_length, &pool->fragments_capacity, 1, 4);
 
         ir_pool_fragment_t *new_fragment = &pool->fragments[pool->fragments_length++];
-        new_fragment->capacity = recent_fragment->capacity * 2;
-        new_fragment->memory = malloc(new_fragment->capacity);
+        new_fragment->memory = NULL;
+
+        // Reuse the most recently released fragment if it's big enough
+        if(pool->spare_fragments_length != 0){
+            ir_pool_fragment_t *spare = &pool->spare_fragments[pool->spare_fragments_length - 1];
+
+            if(spare->capacity >= bytes){
+                *new_fragment = *spare;
+                pool->spare_fragments_length--;
+            }
+        }
+
+        if(new_fragment->memory == NULL){
+            new_fragment->memory = malloc(capacity);
+            new_fragment->capacity = capacity;
+        }
+
         new_fragment->used = 0;
         recent_fragment = new_fragment;
+        offset = 0;
     }
 
-    void *memory = (void*) &((char*) recent_fragment->memory)[recent_fragment->used];
-    recent_fragment->used += bytes;
+    void *memory = (void*) &((char*) recent_fragment->memory)[offset];
+    recent_fragment->used = offset + bytes;
     return memory;
 }
 
@@ -43,6 +76,11 @@ void ir_pool_free(ir_pool_t *pool){
         free(pool->fragments[f].memory);
     }
     free(pool->fragments);
+
+    for(length_t f = 0; f != pool->spare_fragments_length; f++){
+        free(pool->spare_fragments[f].memory);
+    }
+    free(pool->spare_fragments);
 }
 
 void ir_pool_snapshot_capture(ir_pool_t *pool, ir_pool_snapshot_t *snapshot){
@@ -51,10 +89,44 @@ void ir_pool_snapshot_capture(ir_pool_t *pool, ir_pool_snapshot_t *snapshot){
 }
 
 void ir_pool_snapshot_restore(ir_pool_t *pool, ir_pool_snapshot_t *snapshot){
-    for(length_t f = pool->fragments_length; f != snapshot->fragments_length; f--){
-        free(pool->fragments[f - 1].memory);
+    // Keep released fragments around, since they'll likely be needed again soon
+    // NOTE: The last released fragment is the first to be reused
+    for(length_t f = snapshot->fragments_length; f != pool->fragments_length; f++){
+        expand((void**) &pool->spare_fragments, sizeof(ir_pool_fragment_t), pool->spare_fragments_length, &pool->spare_fragments_capacity, 1, 4);
+        pool->spare_fragments[pool->spare_fragments_length++] = pool->fragments[f];
     }
 
     pool->fragments_length = snapshot->fragments_length;
     pool->fragments[snapshot->fragments_length - 1].used = snapshot->used;
 }
+
+void ir_pool_stats(ir_pool_t *pool, ir_pool_stats_t *out_stats){
+    out_stats->bytes_used = 0;
+    out_stats->bytes_reserved = 0;
+    out_stats->bytes_wasted = 0;
+    out_stats->fragments = pool->fragments_length;
+    out_stats->spare_fragments = pool->spare_fragments_length;
+
+    for(length_t f = 0; f != pool->fragments_length; f++){
+        out_stats->bytes_used += pool->fragments[f].used;
+        out_stats->bytes_reserved += pool->fragments[f].capacity;
+
+        // Only the last fragment can still be allocated from
+        if(f + 1 != pool->fragments_length){
+            out_stats->bytes_wasted += pool->fragments[f].capacity - pool->fragments[f].used;
+        }
+    }
+
+    for(length_t f = 0; f != pool->spare_fragments_length; f++){
+        out_stats->bytes_reserved += pool->spare_fragments[f].capacity;
+    }
+}
+
+void ir_pool_print_stats(ir_pool_t *pool){
+    ir_pool_stats_t stats;
+    ir_pool_stats(pool, &stats);
+
+    printf("IR Pool: %llu bytes used, %llu bytes reserved, %llu bytes wasted, %llu fragments (%llu spare)\n",
+        (unsigned long long) stats.bytes_used, (unsigned long long) stats.bytes_reserved, (unsigned long long) stats.bytes_wasted,
+        (unsigned long long) stats.fragments, (unsigned long long) stats.spare_fragments);
+}
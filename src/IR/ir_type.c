@@ -1,4 +1,5 @@
 
+#include "UTIL/util.h"
 #include "IR/ir_pool.h"
 #include "IR/ir_type.h"
 
@@ -59,6 +60,7 @@ bool ir_types_identical(ir_type_t *a, ir_type_t *b){
     // [pointer] [pointer] [u8]    [pointer] [pointer] [s32]  -> false
     // [pointer] [u8]              [pointer] [u8]             -> true
 
+    if(a == b) return true;
     if(a->kind != b->kind) return false;
 
     switch(a->kind){
@@ -81,11 +83,121 @@ bool ir_types_identical(ir_type_t *a, ir_type_t *b){
     return true;
 }
 
-ir_type_t* ir_type_pointer_to(ir_pool_t *pool, ir_type_t *base){
-    ir_type_t *ptr_type = ir_pool_alloc(pool, sizeof(ir_type_t));
-    ptr_type->kind = TYPE_KIND_POINTER;
-    ptr_type->extra = base;
-    return ptr_type;
+void ir_type_interner_init(ir_type_interner_t *interner, ir_pool_t *pool){
+    interner->pool = pool;
+    interner->types = NULL;
+    interner->types_length = 0;
+    interner->types_capacity = 0;
+    hash_index_init(&interner->index);
+}
+
+void ir_type_interner_free(ir_type_interner_t *interner){
+    free(interner->types);
+    hash_index_free(&interner->index);
+}
+
+hash_t ir_type_intern_hash(ir_type_t *type){
+    hash_t hash = hash_data(&type->kind, sizeof(unsigned int));
+
+    switch(type->kind){
+    case TYPE_KIND_POINTER:
+        return hash_continue(hash, &type->extra, sizeof(ir_type_t*));
+    case TYPE_KIND_FIXED_ARRAY: {
+            ir_type_extra_fixed_array_t *fixed_array = (ir_type_extra_fixed_array_t*) type->extra;
+            hash = hash_continue(hash, &fixed_array->subtype, sizeof(ir_type_t*));
+            return hash_continue(hash, &fixed_array->length, sizeof(length_t));
+        }
+    case TYPE_KIND_FUNCPTR: {
+            ir_type_extra_function_t *function = (ir_type_extra_function_t*) type->extra;
+            hash = hash_continue(hash, &function->return_type, sizeof(ir_type_t*));
+            hash = hash_continue(hash, &function->traits, sizeof(trait_t));
+            return hash_continue(hash, function->arg_types, sizeof(ir_type_t*) * function->arity);
+        }
+    }
+
+    return hash;
+}
+
+bool ir_type_intern_equals(ir_type_t *a, ir_type_t *b){
+    // NOTE: The types that 'a' and 'b' are made of are compared by identity,
+    //       since they are expected to already be interned
+    if(a->kind != b->kind) return false;
+
+    switch(a->kind){
+    case TYPE_KIND_POINTER:
+        return a->extra == b->extra;
+    case TYPE_KIND_FIXED_ARRAY: {
+            ir_type_extra_fixed_array_t *a_fixed_array = (ir_type_extra_fixed_array_t*) a->extra;
+            ir_type_extra_fixed_array_t *b_fixed_array = (ir_type_extra_fixed_array_t*) b->extra;
+            return a_fixed_array->subtype == b_fixed_array->subtype && a_fixed_array->length == b_fixed_array->length;
+        }
+    case TYPE_KIND_FUNCPTR: {
+            ir_type_extra_function_t *a_function = (ir_type_extra_function_t*) a->extra;
+            ir_type_extra_function_t *b_function = (ir_type_extra_function_t*) b->extra;
+
+            if(a_function->return_type != b_function->return_type || a_function->traits != b_function->traits) return false;
+            if(a_function->arity != b_function->arity) return false;
+            return memcmp(a_function->arg_types, b_function->arg_types, sizeof(ir_type_t*) * a_function->arity) == 0;
+        }
+    }
+
+    return true;
+}
+
+ir_type_t* ir_type_intern(ir_type_interner_t *interner, ir_type_t *type){
+    hash_t hash = ir_type_intern_hash(type);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&interner->index, hash, &cursor); i != -1; i = hash_index_find_next(&interner->index, hash, &cursor)){
+        if(ir_type_intern_equals(interner->types[i], type)) return interner->types[i];
+    }
+
+    ir_type_t *interned = ir_pool_alloc(interner->pool, sizeof(ir_type_t));
+    interned->kind = type->kind;
+    interned->extra = NULL;
+
+    switch(type->kind){
+    case TYPE_KIND_POINTER:
+        interned->extra = type->extra;
+        break;
+    case TYPE_KIND_FIXED_ARRAY: {
+            ir_type_extra_fixed_array_t *fixed_array = ir_pool_alloc(interner->pool, sizeof(ir_type_extra_fixed_array_t));
+            *fixed_array = *((ir_type_extra_fixed_array_t*) type->extra);
+            interned->extra = fixed_array;
+        }
+        break;
+    case TYPE_KIND_FUNCPTR: {
+            ir_type_extra_function_t *function = ir_pool_alloc(interner->pool, sizeof(ir_type_extra_function_t));
+            *function = *((ir_type_extra_function_t*) type->extra);
+            function->arg_types = ir_pool_alloc(interner->pool, sizeof(ir_type_t*) * function->arity);
+            memcpy(function->arg_types, ((ir_type_extra_function_t*) type->extra)->arg_types, sizeof(ir_type_t*) * function->arity);
+            interned->extra = function;
+        }
+        break;
+    }
+
+    expand((void**) &interner->types, sizeof(ir_type_t*), interner->types_length, &interner->types_capacity, 1, 64);
+    hash_index_insert(&interner->index, hash, interner->types_length);
+    interner->types[interner->types_length++] = interned;
+    return interned;
+}
+
+ir_type_t* ir_type_pointer_to(ir_type_interner_t *interner, ir_type_t *base){
+    ir_type_t ptr_type;
+    ptr_type.kind = TYPE_KIND_POINTER;
+    ptr_type.extra = base;
+    return ir_type_intern(interner, &ptr_type);
+}
+
+ir_type_t* ir_type_fixed_array_of(ir_type_interner_t *interner, ir_type_t *subtype, length_t length){
+    ir_type_extra_fixed_array_t fixed_array;
+    fixed_array.subtype = subtype;
+    fixed_array.length = length;
+
+    ir_type_t fixed_array_type;
+    fixed_array_type.kind = TYPE_KIND_FIXED_ARRAY;
+    fixed_array_type.extra = &fixed_array;
+    return ir_type_intern(interner, &fixed_array_type);
 }
 
 ir_type_t* ir_type_dereference(ir_type_t *type){
@@ -93,6 +205,15 @@ ir_type_t* ir_type_dereference(ir_type_t *type){
     return (ir_type_t*) type->extra;
 }
 
+bool ir_type_is_integer(ir_type_t *type){
+    switch(type->kind){
+    case TYPE_KIND_S8: case TYPE_KIND_S16: case TYPE_KIND_S32: case TYPE_KIND_S64:
+    case TYPE_KIND_U8: case TYPE_KIND_U16: case TYPE_KIND_U32: case TYPE_KIND_U64:
+        return true;
+    }
+    return false;
+}
+
 // (For 64 bit systems)
 unsigned int global_type_kind_sizes_64[] = {
      0, // TYPE_KIND_NONE
@@ -36,21 +36,22 @@ void build_using_basicblock(ir_builder_t *builder, length_t basicblock_id){
 ir_instr_t* build_instruction(ir_builder_t *builder, length_t size){
     // NOTE: Generates an instruction of the size 'size'
     ir_basicblock_new_instructions(builder->current_block, 1);
-    builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) ir_pool_alloc(builder->pool, size);
-    return builder->current_block->instructions[builder->current_block->instructions_length - 1];
+    ir_instr_t *instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, size);
+    instruction->source = builder->source;
+    builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
+    return instruction;
 }
 
 ir_value_t *build_value_from_prev_instruction(ir_builder_t *builder){
     // NOTE: Builds an ir_value_t for the result of the last instruction in the current block
 
-    ir_value_result_t *result = ir_pool_alloc(builder->pool, sizeof(ir_value_result_t));
-    result->block_id = builder->current_block_id;
-    result->instruction_id = builder->current_block->instructions_length - 1;
+    length_t instruction_id = builder->current_block->instructions_length - 1;
+    ir_type_t *result_type = builder->current_block->instructions[instruction_id]->result_type;
 
-    ir_value_t *ir_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-    ir_value->value_type = VALUE_TYPE_RESULT;
-    ir_value->type = builder->current_block->instructions[result->instruction_id]->result_type;
-    ir_value->extra = result;
+    ir_value_t *ir_value = build_value_with_extra(builder->pool, VALUE_TYPE_RESULT, result_type, sizeof(ir_value_result_t));
+    ir_value_result_t *result = (ir_value_result_t*) ir_value->extra;
+    result->block_id = builder->current_block_id;
+    result->instruction_id = instruction_id;
 
     // Little test to make sure ir_value->type is valid
     if(ir_value->type == NULL){
@@ -63,23 +64,30 @@ ir_value_t *build_value_from_prev_instruction(ir_builder_t *builder){
     return ir_value;
 }
 
+ir_value_t *build_value_with_extra(ir_pool_t *pool, unsigned int value_type, ir_type_t *type, length_t extra_size){
+    // Round up so that the payload is aligned like any other pool allocation
+    length_t value_size = (sizeof(ir_value_t) + IR_POOL_MAX_ALIGNMENT - 1) & ~((length_t) IR_POOL_MAX_ALIGNMENT - 1);
+
+    ir_value_t *value = ir_pool_alloc_aligned(pool, value_size + extra_size, IR_POOL_MAX_ALIGNMENT);
+    value->value_type = value_type;
+    value->type = type;
+    value->extra = (char*) value + value_size;
+    return value;
+}
+
 ir_value_t* build_varptr(ir_builder_t *builder, ir_type_t *ptr_type, length_t variable_id){
-    ir_basicblock_new_instructions(builder->current_block, 1);
-    ir_instr_varptr_t *instruction = (ir_instr_varptr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_varptr_t));
+    ir_instr_varptr_t *instruction = (ir_instr_varptr_t*) build_instruction(builder, sizeof(ir_instr_varptr_t));
     instruction->id = INSTRUCTION_VARPTR;
     instruction->result_type = ptr_type;
     instruction->index = variable_id;
-    builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
     return build_value_from_prev_instruction(builder);
 }
 
 ir_value_t* build_gvarptr(ir_builder_t *builder, ir_type_t *ptr_type, length_t variable_id){
-    ir_basicblock_new_instructions(builder->current_block, 1);
-    ir_instr_varptr_t *instruction = (ir_instr_varptr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_varptr_t));
+    ir_instr_varptr_t *instruction = (ir_instr_varptr_t*) build_instruction(builder, sizeof(ir_instr_varptr_t));
     instruction->id = INSTRUCTION_GLOBALVARPTR;
     instruction->result_type = ptr_type;
     instruction->index = variable_id;
-    builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
     return build_value_from_prev_instruction(builder);
 }
 
@@ -87,12 +95,10 @@ ir_value_t* build_load(ir_builder_t *builder, ir_value_t *value){
     ir_type_t *dereferenced_type = ir_type_dereference(value->type);
     if(dereferenced_type == NULL) return NULL;
 
-    ir_basicblock_new_instructions(builder->current_block, 1);
-    ir_instr_load_t *instruction = (ir_instr_load_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_load_t));
+    ir_instr_load_t *instruction = (ir_instr_load_t*) build_instruction(builder, sizeof(ir_instr_load_t));
     instruction->id = INSTRUCTION_LOAD;
     instruction->result_type = dereferenced_type;
     instruction->value = value;
-    builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
     return build_value_from_prev_instruction(builder);
 }
 
@@ -142,11 +148,11 @@ ir_value_t *build_struct_construction(ir_pool_t *pool, ir_type_t *type, ir_value
     return value;
 }
 
-ir_value_t *build_static_array(ir_pool_t *pool, ir_type_t *type, ir_value_t **values, length_t length){
-    ir_value_t *value = ir_pool_alloc(pool, sizeof(ir_value_t));
+ir_value_t *build_static_array(ir_module_t *module, ir_type_t *type, ir_value_t **values, length_t length){
+    ir_value_t *value = ir_pool_alloc(&module->pool, sizeof(ir_value_t));
     value->value_type = VALUE_TYPE_ARRAY_LITERAL;
-    value->type = ir_type_pointer_to(pool, type);
-    ir_value_array_literal_t *extra = ir_pool_alloc(pool, sizeof(ir_value_array_literal_t));
+    value->type = ir_type_pointer_to(&module->type_interner, type);
+    ir_value_array_literal_t *extra = ir_pool_alloc(&module->pool, sizeof(ir_value_array_literal_t));
     extra->values = values;
     extra->length = length;
     value->extra = extra;
@@ -163,7 +169,7 @@ ir_value_t *build_anon_global(ir_module_t *module, ir_type_t *type, bool is_cons
 
     ir_value_t *reference = ir_pool_alloc(&module->pool, sizeof(ir_value_t));
     reference->value_type = is_constant ? VALUE_TYPE_CONST_ANON_GLOBAL : VALUE_TYPE_ANON_GLOBAL;
-    reference->type = ir_type_pointer_to(&module->pool, type);
+    reference->type = ir_type_pointer_to(&module->type_interner, type);
 
     reference->extra = ir_pool_alloc(&module->pool, sizeof(ir_value_anon_global_t));
     ((ir_value_anon_global_t*) reference->extra)->anon_global_id = module->anon_globals_length - 1;
@@ -184,9 +190,9 @@ ir_type_t* ir_builder_funcptr(ir_builder_t *builder){
     ir_type_t **shared_type = &builder->object->ir_module.common.ir_funcptr;
 
     if(*shared_type == NULL){
-        (*shared_type) = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
+        (*shared_type) = ir_pool_alloc(&builder->object->ir_module.shared_pool, sizeof(ir_type_t));
         (*shared_type)->kind = TYPE_KIND_FUNCPTR;
-        // 'ir_funcptr_type->extra' not set because never used
+        (*shared_type)->extra = NULL; // (generic function pointer, so it has no details)
     }
     
     return *shared_type;
@@ -196,7 +202,7 @@ ir_type_t* ir_builder_usize(ir_builder_t *builder){
     ir_type_t **shared_type = &builder->object->ir_module.common.ir_usize;
 
     if(*shared_type == NULL){
-        (*shared_type) = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
+        (*shared_type) = ir_pool_alloc(&builder->object->ir_module.shared_pool, sizeof(ir_type_t));
         (*shared_type)->kind = TYPE_KIND_U64;
     }
 
@@ -207,7 +213,7 @@ ir_type_t* ir_builder_usize_ptr(ir_builder_t *builder){
     ir_type_t **shared_type = &builder->object->ir_module.common.ir_usize_ptr;
 
     if(*shared_type == NULL){
-        (*shared_type) = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
+        (*shared_type) = ir_pool_alloc(&builder->object->ir_module.shared_pool, sizeof(ir_type_t));
         (*shared_type)->kind = TYPE_KIND_POINTER;
         (*shared_type)->extra = ir_builder_usize(builder);
     }
@@ -215,40 +221,79 @@ ir_type_t* ir_builder_usize_ptr(ir_builder_t *builder){
     return *shared_type;
 }
 
+ir_type_t* ir_builder_ptrdiff(ir_builder_t *builder){
+    ir_type_t **shared_type = &builder->object->ir_module.common.ir_ptrdiff;
+
+    if(*shared_type == NULL){
+        (*shared_type) = ir_pool_alloc(&builder->object->ir_module.shared_pool, sizeof(ir_type_t));
+        (*shared_type)->kind = TYPE_KIND_S64;
+    }
+
+    return *shared_type;
+}
+
 ir_type_t* ir_builder_bool(ir_builder_t *builder){
     ir_type_t **shared_type = &builder->object->ir_module.common.ir_bool;
 
     if(*shared_type == NULL){
-        (*shared_type) = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-        (*shared_type)->kind = TYPE_KIND_U64;
+        (*shared_type) = ir_pool_alloc(&builder->object->ir_module.shared_pool, sizeof(ir_type_t));
+        (*shared_type)->kind = TYPE_KIND_BOOLEAN;
     }
 
     return *shared_type;
 }
 
-ir_value_t* build_literal_int(ir_pool_t *pool, long long literal_value){
-    ir_value_t *value = ir_pool_alloc(pool, sizeof(ir_value_t));
+ir_type_t* ir_builder_int(ir_builder_t *builder){
+    ir_type_t **shared_type = &builder->object->ir_module.common.ir_int;
 
-    value->value_type = VALUE_TYPE_LITERAL;
-    value->type = ir_pool_alloc(pool, sizeof(ir_type_t));
-    value->type->kind = TYPE_KIND_S32;
-    // neglect ir_value->type->extra
-    
-    value->extra = ir_pool_alloc(pool, sizeof(long long));
-    *((long long*) value->extra) = literal_value;
-    return value;
+    if(*shared_type == NULL){
+        (*shared_type) = ir_pool_alloc(&builder->object->ir_module.shared_pool, sizeof(ir_type_t));
+        (*shared_type)->kind = TYPE_KIND_S32;
+    }
+
+    return *shared_type;
+}
+
+ir_value_t** ir_builder_constant(ir_builder_t *builder, unsigned int value_type, ir_type_t *type, unsigned long long bits){
+    return ir_module_constant(&builder->object->ir_module, value_type, type, bits);
+}
+
+ir_value_t* build_literal_int(ir_builder_t *builder, long long literal_value){
+    ir_type_t *type = ir_builder_int(builder);
+    ir_value_t **constant = ir_builder_constant(builder, VALUE_TYPE_LITERAL, type, (unsigned long long) literal_value);
+
+    if(*constant == NULL){
+        *constant = build_value_with_extra(&builder->object->ir_module.shared_pool, VALUE_TYPE_LITERAL, type, sizeof(long long));
+        *((long long*) (*constant)->extra) = literal_value;
+    }
+
+    return *constant;
+}
+
+ir_value_t* build_literal_usize(ir_builder_t *builder, length_t literal_value){
+    ir_type_t *type = ir_builder_usize(builder);
+    ir_value_t **constant = ir_builder_constant(builder, VALUE_TYPE_LITERAL, type, literal_value);
+
+    if(*constant == NULL){
+        *constant = build_value_with_extra(&builder->object->ir_module.shared_pool, VALUE_TYPE_LITERAL, type, sizeof(unsigned long long));
+        *((unsigned long long*) (*constant)->extra) = literal_value;
+    }
+
+    return *constant;
 }
 
-ir_value_t* build_literal_usize(ir_pool_t *pool, length_t literal_value){
+ir_value_t* build_offsetof_value(ir_pool_t *pool, ir_type_t *type, length_t index){
     ir_value_t *value = ir_pool_alloc(pool, sizeof(ir_value_t));
 
-    value->value_type = VALUE_TYPE_LITERAL;
+    value->value_type = VALUE_TYPE_OFFSETOF;
     value->type = ir_pool_alloc(pool, sizeof(ir_type_t));
     value->type->kind = TYPE_KIND_U64;
     // neglect ir_value->type->extra
-    
-    value->extra = ir_pool_alloc(pool, sizeof(unsigned long long));
-    *((unsigned long long*) value->extra) = literal_value;
+
+    ir_value_offsetof_t *extra = ir_pool_alloc(pool, sizeof(ir_value_offsetof_t));
+    extra->type = type;
+    extra->index = index;
+    value->extra = extra;
     return value;
 }
 
@@ -261,11 +306,11 @@ ir_value_t* build_literal_str(ir_builder_t *builder, char *array, length_t lengt
 
     ir_value_t **values = ir_pool_alloc(builder->pool, sizeof(ir_value_t*) * 4);
     values[0] = build_literal_cstr_of_length(builder, array, length);
-    values[1] = build_literal_usize(builder->pool, length);
-    values[2] = build_literal_usize(builder->pool, length);
+    values[1] = build_literal_usize(builder, length);
+    values[2] = build_literal_usize(builder, length);
 
     // DANGEROUS: This is a hack to initialize String.ownership as a reference
-    values[3] = build_literal_usize(builder->pool, 0);
+    values[3] = build_literal_usize(builder, 0);
     
     ir_value_t *value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
     value->value_type = VALUE_TYPE_STRUCT_LITERAL;
@@ -296,7 +341,11 @@ ir_value_t* build_literal_cstr_of_length(ir_builder_t *builder, char *array, len
     return ir_value;
 }
 
-ir_value_t* build_null_pointer(ir_pool_t *pool){
+ir_value_t* build_null_pointer(ir_builder_t *builder){
+    ir_value_t **constant = ir_builder_constant(builder, VALUE_TYPE_NULLPTR, NULL, 0);
+    if(*constant != NULL) return *constant;
+
+    ir_pool_t *pool = &builder->object->ir_module.shared_pool;
     ir_value_t *value = ir_pool_alloc(pool, sizeof(ir_value_t));
     value->value_type = VALUE_TYPE_NULLPTR;
     // neglect value->extra
@@ -307,14 +356,20 @@ ir_value_t* build_null_pointer(ir_pool_t *pool){
     ((ir_type_t*) value->type->extra)->kind = TYPE_KIND_S8;
     // neglect ((ir_type_t*) value->type->extra)->extra
 
+    *constant = value;
     return value;
 }
 
-ir_value_t* build_null_pointer_of_type(ir_pool_t *pool, ir_type_t *type){
-    ir_value_t *value = ir_pool_alloc(pool, sizeof(ir_value_t));
+ir_value_t* build_null_pointer_of_type(ir_builder_t *builder, ir_type_t *type){
+    ir_value_t **constant = ir_builder_constant(builder, VALUE_TYPE_NULLPTR_OF_TYPE, type, 0);
+    if(*constant != NULL) return *constant;
+
+    ir_value_t *value = ir_pool_alloc(&builder->object->ir_module.shared_pool, sizeof(ir_value_t));
     value->value_type = VALUE_TYPE_NULLPTR_OF_TYPE;
     value->type = type;
     // neglect value->extra
+
+    *constant = value;
     return value;
 }
 
@@ -423,17 +478,36 @@ ir_value_t *build_math(ir_builder_t *builder, unsigned int instr_id, ir_value_t
     return build_value_from_prev_instruction(builder);
 }
 
-ir_value_t *build_bool(ir_pool_t *pool, bool value){
-    ir_value_t *ir_value = ir_pool_alloc(pool, sizeof(ir_value_t));
-    ir_value->value_type = VALUE_TYPE_LITERAL;
+ir_value_t *build_pointer_math(ir_builder_t *builder, unsigned int instr_id, ir_value_t *a, ir_value_t *b){
+    bool a_is_pointer = a->type->kind == TYPE_KIND_POINTER;
+    bool b_is_pointer = b->type->kind == TYPE_KIND_POINTER;
 
-    ir_value->type = ir_pool_alloc(pool, sizeof(ir_type_t));
-    ir_value->type->kind = TYPE_KIND_BOOLEAN;
-    // neglect ir_value->type->extra
+    switch(instr_id){
+    case INSTRUCTION_ADD:
+        if(a_is_pointer && ir_type_is_integer(b->type)) return build_math(builder, INSTRUCTION_PTR_ADD, a, b, a->type);
+        if(b_is_pointer && ir_type_is_integer(a->type)) return build_math(builder, INSTRUCTION_PTR_ADD, b, a, b->type);
+        break;
+    case INSTRUCTION_SUBTRACT:
+        if(a_is_pointer && ir_type_is_integer(b->type)) return build_math(builder, INSTRUCTION_PTR_SUBTRACT, a, b, a->type);
+        if(a_is_pointer && b_is_pointer && ir_types_identical(a->type, b->type)){
+            return build_math(builder, INSTRUCTION_PTR_DIFFERENCE, a, b, ir_builder_ptrdiff(builder));
+        }
+        break;
+    }
 
-    ir_value->extra = ir_pool_alloc(pool, sizeof(bool));
-    *((bool*) ir_value->extra) = value;
-    return ir_value;
+    return NULL;
+}
+
+ir_value_t *build_bool(ir_builder_t *builder, bool value){
+    ir_type_t *type = ir_builder_bool(builder);
+    ir_value_t **constant = ir_builder_constant(builder, VALUE_TYPE_LITERAL, type, value);
+
+    if(*constant == NULL){
+        *constant = build_value_with_extra(&builder->object->ir_module.shared_pool, VALUE_TYPE_LITERAL, type, sizeof(bool));
+        *((bool*) (*constant)->extra) = value;
+    }
+
+    return *constant;
 }
 
 void prepare_for_new_label(ir_builder_t *builder){
@@ -493,6 +567,7 @@ void add_variable(ir_builder_t *builder, weak_cstr_t name, ast_type_t *ast_type,
     list->variables[list->length].ir_type = ir_type;
     list->variables[list->length].id = builder->next_var_id;
     list->variables[list->length].traits = traits;
+    hash_index_insert(&list->index, hash_cstr(name), list->length);
     builder->next_var_id++;
     list->length++;
 }
@@ -511,22 +586,20 @@ void handle_defer_management(ir_builder_t *builder, bridge_var_list_t *list){
 
                 weak_cstr_t struct_name = ((ast_elem_base_t*) ast_type->elements[0])->base;
 
-                maybe_index_t index = find_beginning_of_method_group(builder->object->ir_module.methods, builder->object->ir_module.methods_length, struct_name, "__defer__");
+                maybe_index_t index = ir_gen_find_management(&builder->object->ir_module, struct_name)->defer_method;
                 if(index == -1) continue;
 
                 ir_method_t *method = &builder->object->ir_module.methods[index];
-                ir_value_t *variable_pointer = build_varptr(builder, ir_type_pointer_to(builder->pool, list->variables[i].ir_type), list->variables[i].id);
+                ir_value_t *variable_pointer = build_varptr(builder, ir_type_pointer_to(&builder->object->ir_module.type_interner, list->variables[i].ir_type), list->variables[i].id);
                 ir_value_t **arguments = ir_pool_alloc(builder->pool, sizeof(ir_value_t**));
                 arguments[0] = variable_pointer;
 
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                ir_instr_call_t *instruction = ir_pool_alloc(builder->pool, sizeof(ir_instr_call_t));
+                ir_instr_call_t *instruction = (ir_instr_call_t*) build_instruction(builder, sizeof(ir_instr_call_t));
                 instruction->id = INSTRUCTION_CALL;
                 instruction->result_type = method->module_func->return_type;
                 instruction->values = arguments;
                 instruction->values_length = 1;
                 instruction->func_id = method->func_id;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
             }
         }
     }
@@ -540,22 +613,21 @@ void handle_pass_management(ir_builder_t *builder, ir_value_t **values, ast_type
             ast_type_t *ast_type = &types[i];
 
             if(ast_type->elements_length == 1 && ast_type->elements[0]->id == AST_ELEM_BASE){
-                funcpair_t result;
-                if(ir_gen_find_func(builder->compiler, builder->object, "__pass__", &types[i], 1, &result) == FAILURE){
-                    continue;
-                }
+                weak_cstr_t struct_name = ((ast_elem_base_t*) ast_type->elements[0])->base;
+
+                maybe_index_t index = ir_gen_find_management(&builder->object->ir_module, struct_name)->pass_mapping;
+                if(index == -1) continue;
 
+                ir_func_mapping_t *mapping = &builder->object->ir_module.func_mappings[index];
                 ir_value_t **arguments = ir_pool_alloc(builder->pool, sizeof(ir_value_t*));
                 arguments[0] = values[i];
                 
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                ir_instr_call_t *instruction = ir_pool_alloc(builder->pool, sizeof(ir_instr_call_t));
+                ir_instr_call_t *instruction = (ir_instr_call_t*) build_instruction(builder, sizeof(ir_instr_call_t));
                 instruction->id = INSTRUCTION_CALL;
-                instruction->result_type = result.ir_func->return_type;
+                instruction->result_type = mapping->module_func->return_type;
                 instruction->values = arguments;
                 instruction->values_length = 1;
-                instruction->func_id = result.func_id;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
+                instruction->func_id = mapping->func_id;
                 values[i] = build_value_from_prev_instruction(builder);
             }
         }
@@ -567,17 +639,15 @@ successful_t handle_assign_management(ir_builder_t *builder, ir_value_t *value,
         if(type->elements_length == 1 && type->elements[0]->id == AST_ELEM_BASE){
             weak_cstr_t struct_name = ((ast_elem_base_t*) type->elements[0])->base;
 
-            maybe_index_t index = find_beginning_of_method_group(builder->object->ir_module.methods, builder->object->ir_module.methods_length, struct_name, "__assign__");
+            maybe_index_t index = ir_gen_find_management(&builder->object->ir_module, struct_name)->assign_method;
             if(index == -1) return UNSUCCESSFUL;
 
             if(zero_initialize){
                 // Zero initialize for declaration assignments
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                ir_instr_varzeroinit_t *zero_instr = (ir_instr_varzeroinit_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_varzeroinit_t));
+                ir_instr_varzeroinit_t *zero_instr = (ir_instr_varzeroinit_t*) build_instruction(builder, sizeof(ir_instr_varzeroinit_t));
                 zero_instr->id = INSTRUCTION_VARZEROINIT;
                 zero_instr->result_type = NULL;
                 zero_instr->index = builder->next_var_id - 1;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) zero_instr;
             }
 
             ir_method_t *method = &builder->object->ir_module.methods[index];
@@ -586,14 +656,12 @@ successful_t handle_assign_management(ir_builder_t *builder, ir_value_t *value,
             arguments[0] = destination;
             arguments[1] = value;
             
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            ir_instr_call_t *instruction = ir_pool_alloc(builder->pool, sizeof(ir_instr_call_t));
+            ir_instr_call_t *instruction = (ir_instr_call_t*) build_instruction(builder, sizeof(ir_instr_call_t));
             instruction->id = INSTRUCTION_CALL;
             instruction->result_type = method->module_func->return_type;
             instruction->values = arguments;
             instruction->values_length = 2;
             instruction->func_id = method->func_id;
-            builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
             return SUCCESSFUL;
         }
     }
@@ -618,14 +686,12 @@ ir_value_t* handle_math_management(ir_builder_t *builder, ir_value_t *lhs, ir_va
 
             handle_pass_management(builder, arguments, types, result.ast_func->arg_type_traits, 2);
 
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            ir_instr_call_t *instruction = ir_pool_alloc(builder->pool, sizeof(ir_instr_call_t));
+            ir_instr_call_t *instruction = (ir_instr_call_t*) build_instruction(builder, sizeof(ir_instr_call_t));
             instruction->id = INSTRUCTION_CALL;
             instruction->result_type = result.ir_func->return_type;
             instruction->values = arguments;
             instruction->values_length = 2;
             instruction->func_id = result.func_id;
-            builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
 
             if(out_type != NULL) *out_type = ast_type_clone(&result.ast_func->return_type);
             return build_value_from_prev_instruction(builder);
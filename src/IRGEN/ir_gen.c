@@ -6,8 +6,10 @@
 #include "UTIL/builtin_type.h"
 #include "BRIDGE/any.h"
 #include "BRIDGE/rtti.h"
+#include "IR/ir_flat.h"
 #include "IRGEN/ir_gen.h"
 #include "IRGEN/ir_gen_expr.h"
+#include "IRGEN/ir_gen_find.h"
 #include "IRGEN/ir_gen_stmt.h"
 #include "IRGEN/ir_gen_type.h"
 
@@ -15,13 +17,14 @@ errorcode_t ir_gen(compiler_t *compiler, object_t *object){
     ir_module_t *module = &object->ir_module;
     ast_t *ast = &object->ast;
 
-    ir_module_init(module, ast->funcs_length, ast->globals_length);
+    ir_module_init(module, ast->funcs_length, ast->globals_length, compiler->ir_pool_size);
     object->compilation_stage = COMPILATION_STAGE_IR_MODULE;
 
     if(ir_gen_type_mappings(compiler, object)
     || ir_gen_globals(compiler, object)
     || ir_gen_functions(compiler, object)
-    || ir_gen_functions_body(compiler, object)) return FAILURE;
+    || ir_gen_functions_body(compiler, object)
+    || ir_gen_special_globals(compiler, object)) return FAILURE;
 
     return SUCCESS;
 }
@@ -53,13 +56,15 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
         module_func->arity = 0;
         module_func->basicblocks = NULL; // Will be set after 'basicblocks' contains all of the basicblocks
         module_func->basicblocks_length = 0; // Will be set after 'basicblocks' contains all of the basicblocks
+        ir_flat_func_init(&module_func->flat); // Will be made once 'basicblocks' is final
         module_func->var_scope = NULL;
         module_func->variable_count = 0;
+        module_func->source = ast_func->source;
         module->func_mappings[f].name = ast_func->name;
         module->func_mappings[f].ast_func = ast_func;
         module->func_mappings[f].module_func = module_func;
         module->func_mappings[f].func_id = f;
-        module->func_mappings[f].is_beginning_of_group = -1;
+        module->func_mappings[f].arg_types = NULL;
         (*module_funcs_length)++;
 
         if(ast_func->traits & AST_FUNC_FOREIGN) module_func->traits |= IR_FUNC_FOREIGN;
@@ -111,7 +116,7 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
                 method->ast_func = ast_func;
                 method->module_func = module_func;
                 method->func_id = f;
-                method->is_beginning_of_group = -1;
+                method->arg_types = NULL;
             }
         } else {
             while(module_func->arity != ast_func->arity){
@@ -132,6 +137,7 @@ errorcode_t ir_gen_functions(compiler_t *compiler, object_t *object){
 
     qsort(module->func_mappings, ast->funcs_length, sizeof(ir_func_mapping_t), ir_func_mapping_cmp);
     qsort(module->methods, module->methods_length, sizeof(ir_method_t), ir_method_cmp);
+    ir_gen_find_index(module);
     return SUCCESS;
 }
 
@@ -157,11 +163,17 @@ errorcode_t ir_gen_globals(compiler_t *compiler, object_t *object){
     for(length_t g = 0; g != ast->globals_length; g++){
         module->globals[g].name = ast->globals[g].name;
         module->globals[g].traits = ast->globals[g].traits & AST_GLOBAL_EXTERNAL ? IR_GLOBAL_EXTERNAL : TRAIT_NONE;
+        module->globals[g].static_initializer = NULL;
+
+        if(ast->globals[g].traits & AST_GLOBAL___TYPES__){
+            module->common.rtti_array_index = g;
+        }
 
         if(ir_gen_resolve_type(compiler, object, &ast->globals[g].type, &module->globals[g].type)){
             return FAILURE;
         }
 
+        hash_index_insert(&module->globals_index, hash_cstr(module->globals[g].name), g);
         module->globals_length++;
     }
 
@@ -172,6 +184,10 @@ errorcode_t ir_gen_globals_init(ir_builder_t *builder){
     // Generates instructions for initializing global variables
     ast_global_t *globals = builder->object->ast.globals;
     length_t globals_length = builder->object->ast.globals_length;
+    ir_global_t *ir_globals = builder->object->ir_module.globals;
+
+    // Whether an initializer that runs arbitrary code has been generated yet
+    bool has_dynamic_initializer = false;
 
     for(length_t g = 0; g != globals_length; g++){
         ast_global_t *ast_global = &globals[g];
@@ -179,13 +195,11 @@ errorcode_t ir_gen_globals_init(ir_builder_t *builder){
         ir_value_t *value;
         ast_type_t value_ast_type;
 
-        if(ast_global->initial == NULL){
-            if(!(ast_global->traits & AST_GLOBAL_SPECIAL)) continue;
+        // NOTE: Special global variables are handled by 'ir_gen_special_globals'
+        if(ast_global->initial == NULL) continue;
 
-            // Special global variable
-            if(ir_gen_special_global(builder, ast_global, g)) return 1;
-            continue;
-        }
+        length_t block_id = builder->current_block_id;
+        length_t instructions_length = builder->basicblocks[block_id].instructions_length;
 
         if(ir_gen_expression(builder, ast_global->initial, &value, false, &value_ast_type)) return FAILURE;
 
@@ -201,9 +215,24 @@ errorcode_t ir_gen_globals_init(ir_builder_t *builder){
 
         ast_type_free(&value_ast_type);
 
-        ir_type_t *ptr_to_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-        ptr_to_type->kind = TYPE_KIND_POINTER;
-        ptr_to_type->extra = builder->object->ir_module.globals[g].type;
+        // Initial values that are known at compile time become the global's initializer,
+        // and don't need to be stored when the program starts
+        bool is_static = block_id == builder->current_block_id
+            && builder->basicblocks[block_id].instructions_length == instructions_length
+            && ir_value_is_constant(value);
+
+        if(is_static){
+            ir_globals[g].static_initializer = value;
+
+            // Code run by earlier initializers could've modified the global,
+            // so it must still be assigned in order after them
+            if(!has_dynamic_initializer) continue;
+            ir_globals[g].traits |= IR_GLOBAL_MUTABLE;
+        } else {
+            has_dynamic_initializer = true;
+        }
+
+        ir_type_t *ptr_to_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ir_globals[g].type);
 
         ir_value_t *destination = build_gvarptr(builder, ptr_to_type, g);
         build_store(builder, value, destination);
@@ -211,14 +240,37 @@ errorcode_t ir_gen_globals_init(ir_builder_t *builder){
     return SUCCESS;
 }
 
+errorcode_t ir_gen_special_globals(compiler_t *compiler, object_t *object){
+    ast_global_t *globals = object->ast.globals;
+    length_t globals_length = object->ast.globals_length;
+
+    // NOTE: Special globals don't need any instructions, so only
+    //       the parts of the builder used to create values are set
+    ir_builder_t builder;
+    builder.pool = &object->ir_module.pool;
+    builder.type_map = &object->ir_module.type_map;
+    builder.compiler = compiler;
+    builder.object = object;
+
+    // The runtime type table can't be pruned until every function has said which types it uses
+    if(compiler->traits & COMPILER_PRUNE_TYPE_INFO && !(compiler->traits & COMPILER_NO_TYPE_INFO) && object->ast.type_table != NULL){
+        rtti_table_prune(object);
+    }
+
+    for(length_t g = 0; g != globals_length; g++){
+        if(!(globals[g].traits & AST_GLOBAL_SPECIAL)) continue;
+        if(ir_gen_special_global(&builder, &globals[g], g)) return FAILURE;
+    }
+
+    return SUCCESS;
+}
+
 errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_global, length_t global_variable_id){
     // NOTE: Assumes (ast_global->traits & AST_GLOBAL_SPECIAL)
+    // NOTE: The values of special globals are always known at compile time,
+    //       so they are given to the globals as static initializers
 
-    ir_type_t *ptr_to_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-    ptr_to_type->kind = TYPE_KIND_POINTER;
-    ptr_to_type->extra = &ast_global->type;
-
-    ir_value_t *destination = build_gvarptr(builder, ptr_to_type, global_variable_id);
+    ir_value_t **destination = &builder->object->ir_module.globals[global_variable_id].static_initializer;
 
     if(ast_global->traits & AST_GLOBAL___TYPES__){
         ir_type_t *any_type_type, *any_struct_type_type, *any_ptr_type_type,
@@ -231,8 +283,8 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
                 return FAILURE;
             }
 
-            any_type_ptr_type = ir_type_pointer_to(builder->pool, any_type_type);
-            build_store(builder, build_null_pointer_of_type(builder->pool, ir_type_pointer_to(builder->pool, any_type_ptr_type)), destination);
+            any_type_ptr_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, any_type_type);
+            *destination = build_null_pointer_of_type(builder, ir_type_pointer_to(&builder->object->ir_module.type_interner, any_type_ptr_type));
             return SUCCESS;
         }
 
@@ -248,8 +300,8 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
         }
 
         ir_type_t *usize_type = ir_builder_usize(builder);
-        any_type_ptr_type = ir_type_pointer_to(builder->pool, any_type_type);
-        ubyte_ptr_type = ir_type_pointer_to(builder->pool, ubyte_ptr_type);
+        any_type_ptr_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, any_type_type);
+        ubyte_ptr_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ubyte_ptr_type);
 
         ir_value_array_literal_t *array_literal = ir_pool_alloc(builder->pool, sizeof(ir_value_array_literal_t));
         array_literal->values = NULL; // Will be set to array_values
@@ -257,7 +309,7 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
 
         ir_value_t *array_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
         array_value->value_type = VALUE_TYPE_ARRAY_LITERAL;
-        array_value->type = ir_type_pointer_to(builder->pool, any_type_ptr_type);
+        array_value->type = ir_type_pointer_to(&builder->object->ir_module.type_interner, any_type_ptr_type);
         array_value->extra = array_literal;
         
         ir_value_t **array_values = ir_pool_alloc(builder->pool, sizeof(ir_value_t*) * table->length);
@@ -295,24 +347,19 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
 
                     maybe_index_t subtype_index = -1;
 
-                    // HACK: We really shouldn't be doing this
-                    if(table->records[i].ast_type.elements_length > 1){
-                        ast_type_t dereferenced = ast_type_clone(&table->records[i].ast_type);
+                    ast_type_t *type = &table->records[i].ast_type;
 
-                        // Modify ast_type_t to remove a pointer element from the front
-                        // DANGEROUS: Manually deleting ast_elem_pointer_t
-                        free(dereferenced.elements[0]);
-                        memmove(dereferenced.elements, &dereferenced.elements[1], sizeof(ast_elem_t*) * (dereferenced.elements_length - 1));
-                        dereferenced.elements_length--; // Reduce length accordingly
+                    if(type->elements_length > 1 && type->elements[0]->id == AST_ELEM_POINTER){
+                        // NOTE: 'dereferenced' borrows the elements of 'type'
+                        ast_type_t dereferenced = *type;
+                        dereferenced.elements = &type->elements[1];
+                        dereferenced.elements_length--;
 
-                        char *dereferenced_name = ast_type_str(&dereferenced);
-                        subtype_index = type_table_find(table, dereferenced_name);
-                        ast_type_free(&dereferenced);
-                        free(dereferenced_name);
+                        subtype_index = type_table_find_type(table, &dereferenced);
                     }
 
                     if(subtype_index == -1){
-                        ir_value_t *null_pointer = build_null_pointer_of_type(builder->pool, any_type_ptr_type);
+                        ir_value_t *null_pointer = build_null_pointer_of_type(builder, any_type_ptr_type);
                         initializer_members[3] = null_pointer; // subtype
                     } else {
                         initializer_members[3] = build_const_bitcast(builder->pool, array_values[subtype_index], any_type_ptr_type); // subtype
@@ -346,29 +393,27 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
                     }
 
                     for(length_t s = 0; s != composite->subtypes_length; s++){
-                        char *member_type_name = ast_type_str(&structure->field_types[s]);
-                        maybe_index_t subtype_index = type_table_find(table, member_type_name);
-                        free(member_type_name);
+                        maybe_index_t subtype_index = type_table_find_type(table, &structure->field_types[s]);
 
                         if(subtype_index == -1){
-                            composite_members[s] = build_null_pointer(builder->pool); // members[s]
+                            composite_members[s] = build_null_pointer(builder); // members[s]
                         } else {
                             composite_members[s] = build_const_bitcast(builder->pool, array_values[subtype_index], any_type_ptr_type); // members[s]
                         }
 
-                        composite_offsets[s] = build_literal_usize(builder->pool, 0);
+                        composite_offsets[s] = build_offsetof_value(builder->pool, table->records[i].ir_type, s);
                         composite_member_names[s] = build_literal_cstr(builder, structure->field_names[s]);
                     }
 
-                    ir_value_t *members_array = build_static_array(builder->pool, any_type_ptr_type, composite_members, composite->subtypes_length);
-                    ir_value_t *offsets_array = build_static_array(builder->pool, usize_type, composite_offsets, composite->subtypes_length);
-                    ir_value_t *member_names_array = build_static_array(builder->pool, ubyte_ptr_type, composite_member_names, composite->subtypes_length);
+                    ir_value_t *members_array = build_static_array(&builder->object->ir_module, any_type_ptr_type, composite_members, composite->subtypes_length);
+                    ir_value_t *offsets_array = build_static_array(&builder->object->ir_module, usize_type, composite_offsets, composite->subtypes_length);
+                    ir_value_t *member_names_array = build_static_array(&builder->object->ir_module, ubyte_ptr_type, composite_member_names, composite->subtypes_length);
 
                     initializer_members[3] = members_array;
-                    initializer_members[4] = build_literal_usize(builder->pool, composite->subtypes_length); // length
+                    initializer_members[4] = build_literal_usize(builder, composite->subtypes_length); // length
                     initializer_members[5] = offsets_array;
                     initializer_members[6] = member_names_array;
-                    initializer_members[7] = build_bool(builder->pool, composite->traits & TYPE_KIND_COMPOSITE_PACKED); // is_packed
+                    initializer_members[7] = build_bool(builder, composite->traits & TYPE_KIND_COMPOSITE_PACKED); // is_packed
                     initializer_type = any_struct_type_type;
                 }
                 break;
@@ -401,9 +446,9 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
             // case TYPE_KIND_UNION: ignored
             }
 
-            initializer_members[0] = build_literal_usize(builder->pool, any_type_kind_id); // kind
+            initializer_members[0] = build_literal_usize(builder, any_type_kind_id); // kind
             initializer_members[1] = build_literal_cstr(builder, table->records[i].name); // name
-            initializer_members[2] = build_bool(builder->pool, table->records[i].is_alias); // is_alias
+            initializer_members[2] = build_bool(builder, table->records[i].is_alias); // is_alias
 
             ir_value_t *initializer = build_static_struct(&builder->object->ir_module, initializer_type, initializer_members, initializer_members_length, false);
             build_anon_global_initializer(&builder->object->ir_module, array_values[i], initializer);
@@ -414,13 +459,13 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
         }
 
         array_literal->values = array_values;
-        build_store(builder, array_value, destination);
+        *destination = array_value;
         return SUCCESS;
     }
 
     if(ast_global->traits & AST_GLOBAL___TYPES_LENGTH__){
         if(builder->compiler->traits & COMPILER_NO_TYPE_INFO){
-            build_store(builder, build_literal_usize(builder->pool, 0), destination);
+            *destination = build_literal_usize(builder, 0);
             return SUCCESS;
         }
 
@@ -428,8 +473,8 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
         type_table_t *table = builder->object->ast.type_table;
         type_table_reduce(table);
 
-        ir_value_t *value = build_literal_usize(builder->pool, table->length);
-        build_store(builder, value, destination);
+        ir_value_t *value = build_literal_usize(builder, table->length);
+        *destination = value;
         return SUCCESS;
     }
 
@@ -442,11 +487,11 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
         }
 
         // Construct IR Types we need
-        ubyte_ptr_type = ir_type_pointer_to(builder->pool, ubyte_ptr_type);
-        ubyte_ptr_ptr_type = ir_type_pointer_to(builder->pool, ubyte_ptr_type);
+        ubyte_ptr_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ubyte_ptr_type);
+        ubyte_ptr_ptr_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ubyte_ptr_type);
 
         if(builder->compiler->traits & COMPILER_NO_TYPE_INFO){
-            build_store(builder, build_null_pointer_of_type(builder->pool, ubyte_ptr_ptr_type), destination);
+            *destination = build_null_pointer_of_type(builder, ubyte_ptr_ptr_type);
             return SUCCESS;
         }
 
@@ -456,7 +501,7 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
 
         ir_value_t *kinds_array_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
         kinds_array_value->value_type = VALUE_TYPE_ARRAY_LITERAL;
-        kinds_array_value->type = ir_type_pointer_to(builder->pool, ubyte_ptr_type);
+        kinds_array_value->type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ubyte_ptr_type);
         kinds_array_value->extra = kinds_array_literal;
         
         ir_value_t **array_values = ir_pool_alloc(builder->pool, sizeof(ir_value_t*) * (MAX_ANY_TYPE_KIND + 1));
@@ -466,18 +511,18 @@ errorcode_t ir_gen_special_global(ir_builder_t *builder, ast_global_t *ast_globa
         }
 
         kinds_array_literal->values = array_values;
-        build_store(builder, kinds_array_value, destination);
+        *destination = kinds_array_value;
         return SUCCESS;
     }
 
     if(ast_global->traits & AST_GLOBAL___TYPE_KINDS_LENGTH__){
         if(builder->compiler->traits & COMPILER_NO_TYPE_INFO){
-            build_store(builder, build_literal_usize(builder->pool, 0), destination);
+            *destination = build_literal_usize(builder, 0);
             return SUCCESS;
         }
 
-        ir_value_t *value = build_literal_usize(builder->pool, MAX_ANY_TYPE_KIND + 1);
-        build_store(builder, value, destination);
+        ir_value_t *value = build_literal_usize(builder, MAX_ANY_TYPE_KIND + 1);
+        *destination = value;
         return SUCCESS;
     }
 
@@ -17,6 +17,9 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
 
     ir_instr_t *instruction;
 
+    // Attribute the instructions built from here on to this expression
+    builder->source = expr->source;
+
     #define BUILD_MATH_OP_IvF_MACRO(i, f, o, E) { \
         instruction = ir_gen_math_operands(builder, expr, ir_value, o, out_expr_type); \
         if(instruction == NULL) return FAILURE; \
@@ -45,10 +48,8 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
 
     #define BUILD_LITERAL_IR_VALUE(ast_expr_type, typename, storage_type) { \
         if(out_expr_type != NULL) ast_type_make_base(out_expr_type, strclone(typename)); \
-        *ir_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t)); \
-        (*ir_value)->value_type = VALUE_TYPE_LITERAL; \
+        *ir_value = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, NULL, sizeof(storage_type)); \
         ir_type_map_find(builder->type_map, typename, &((*ir_value)->type)); \
-        (*ir_value)->extra = ir_pool_alloc(builder->pool, sizeof(storage_type)); \
         *((storage_type*) (*ir_value)->extra) = ((ast_expr_type*) expr)->value; \
     }
 
@@ -77,7 +78,7 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
         BUILD_LITERAL_IR_VALUE(ast_expr_boolean_t, "bool", bool); break;
     case EXPR_NULL:
         if(out_expr_type != NULL) ast_type_make_base(out_expr_type, strclone("ptr"));
-        *ir_value = build_null_pointer(builder->pool);
+        *ir_value = build_null_pointer(builder);
         break;
     case EXPR_ADD: 
         if(build_basic_IvF_math_op(builder, (ast_expr_math_t*) expr, ir_value, out_expr_type, INSTRUCTION_ADD, INSTRUCTION_FADD, "add", "__add__", false))
@@ -145,11 +146,10 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
     case EXPR_VARIABLE: {
             char *variable_name = ((ast_expr_variable_t*) expr)->name;
             bridge_var_t *variable = bridge_var_scope_find_var(builder->var_scope, variable_name);
-            length_t var_index;
 
             if(variable){
                 if(out_expr_type != NULL) *out_expr_type = ast_type_clone(variable->ast_type);
-                ir_type_t *ir_ptr_type = ir_type_pointer_to(builder->pool, variable->ir_type);
+                ir_type_t *ir_ptr_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, variable->ir_type);
 
                 // Variable-Pointer instruction to get pointer to stack variable
                 *ir_value = build_varptr(builder, ir_ptr_type, variable->id);
@@ -166,32 +166,22 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
             ir_module_t *ir_module = &builder->object->ir_module;
 
             // Attempt to find global variable
-            bool found_global = false;
-            for(var_index = 0; var_index != ir_module->globals_length; var_index++){
-                if(strcmp(variable_name, ir_module->globals[var_index].name) == 0){
-                    found_global = true; break;
-                }
-            }
+            maybe_index_t var_index = ir_gen_find_global(ir_module, variable_name);
 
-            if(found_global){
-                // Assume it exists in ast's globals
-                if(out_expr_type != NULL) for(length_t g = 0; g != ast->globals_length; g++){
-                    if(strcmp(variable_name, ast->globals[g].name) == 0){
-                        *out_expr_type = ast_type_clone(&ast->globals[g].type);
-                        break;
-                    }
-                }
+            if(var_index != -1){
+                if(out_expr_type != NULL) *out_expr_type = ast_type_clone(&ast->globals[var_index].type);
 
                 ir_global_t *global = &ir_module->globals[var_index];
-                ir_type_t *global_pointer_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-                global_pointer_type->kind = TYPE_KIND_POINTER;
-                global_pointer_type->extra = global->type;
+                ir_type_t *global_pointer_type = ir_type_pointer_to(&ir_module->type_interner, global->type);
 
                 *ir_value = build_gvarptr(builder, global_pointer_type, var_index);
 
                 // If not requested to leave the expression mutable, dereference it
                 if(!leave_mutable){
                     *ir_value = build_load(builder, *ir_value);
+                } else {
+                    // The global may be modified through this value
+                    global->traits |= IR_GLOBAL_MUTABLE;
                 }
                 break;
             }
@@ -227,7 +217,7 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
 
             if(var){
                 ast_var_type = var->ast_type;
-                ir_var_type = ir_type_pointer_to(builder->pool, var->ir_type);
+                ir_var_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, var->ir_type);
 
                 if(ast_var_type->elements[0]->id != AST_ELEM_FUNC){
                     char *s = ast_type_str(ast_var_type);
@@ -318,14 +308,12 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
 
                 handle_pass_management(builder, arg_values, arg_types, NULL, call_expr->arity);
 
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_call_address_t));
+                instruction = build_instruction(builder, sizeof(ir_instr_call_address_t));
                 ((ir_instr_call_address_t*) instruction)->id = INSTRUCTION_CALL_ADDRESS;
                 ((ir_instr_call_address_t*) instruction)->result_type = ir_return_type;
                 ((ir_instr_call_address_t*) instruction)->address = *ir_value;
                 ((ir_instr_call_address_t*) instruction)->values = arg_values;
                 ((ir_instr_call_address_t*) instruction)->values_length = call_expr->arity;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
                 *ir_value = build_value_from_prev_instruction(builder);
 
                 for(length_t t = 0; t != call_expr->arity; t++) ast_type_free(&arg_types[t]);
@@ -351,14 +339,12 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                     handle_pass_management(builder, arg_values, arg_types, pair.ast_func->arg_type_traits, call_expr->arity);
                 }
 
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_call_t));
+                instruction = build_instruction(builder, sizeof(ir_instr_call_t));
                 ((ir_instr_call_t*) instruction)->id = INSTRUCTION_CALL;
                 ((ir_instr_call_t*) instruction)->result_type = pair.ir_func->return_type;
                 ((ir_instr_call_t*) instruction)->values = arg_values;
                 ((ir_instr_call_t*) instruction)->values_length = call_expr->arity;
                 ((ir_instr_call_t*) instruction)->func_id = pair.func_id;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
                 *ir_value = build_value_from_prev_instruction(builder);
 
                 for(length_t t = 0; t != call_expr->arity; t++) ast_type_free(&arg_types[t]);
@@ -431,17 +417,13 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
             ir_type_t *field_type;
             if(ir_gen_resolve_type(builder->compiler, builder->object, &target->field_types[field_index], &field_type)) return FAILURE;
 
-            ir_type_t *field_ptr_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-            field_ptr_type->kind = TYPE_KIND_POINTER;
-            field_ptr_type->extra = field_type;
+            ir_type_t *field_ptr_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, field_type);
 
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_member_t));
+            instruction = build_instruction(builder, sizeof(ir_instr_member_t));
             ((ir_instr_member_t*) instruction)->id = INSTRUCTION_MEMBER;
             ((ir_instr_member_t*) instruction)->result_type = field_ptr_type;
             ((ir_instr_member_t*) instruction)->value = struct_value;
             ((ir_instr_member_t*) instruction)->member = field_index;
-            builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
             *ir_value = build_value_from_prev_instruction(builder);
 
             // If not requested to leave the expression mutable, dereference it
@@ -473,13 +455,11 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
             const char *maybe_name = pair.ast_func->traits & AST_FUNC_FOREIGN ||
                 pair.ast_func->traits & AST_FUNC_MAIN ? func_addr_expr->name : NULL;
 
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_func_address_t));
+            instruction = build_instruction(builder, sizeof(ir_instr_func_address_t));
             ((ir_instr_func_address_t*) instruction)->id = INSTRUCTION_FUNC_ADDRESS;
             ((ir_instr_func_address_t*) instruction)->result_type = ir_funcptr_type;
             ((ir_instr_func_address_t*) instruction)->name = maybe_name;
             ((ir_instr_func_address_t*) instruction)->func_id = pair.func_id;
-            builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
             *ir_value = build_value_from_prev_instruction(builder);
 
             if(out_expr_type != NULL){
@@ -554,7 +534,31 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
             ast_type_t index_type, array_type;
             ir_value_t *index_value, *array_value;
 
+            // Indexing through a pointer stored in a global variable doesn't modify the global,
+            // even though the global is referenced as a mutable value
+            ir_global_t *base_global = NULL;
+            trait_t base_global_traits = TRAIT_NONE;
+
+            if(array_access_expr->value->id == EXPR_VARIABLE){
+                char *base_name = ((ast_expr_variable_t*) array_access_expr->value)->name;
+                ir_module_t *ir_module = &builder->object->ir_module;
+
+                if(bridge_var_scope_find_var(builder->var_scope, base_name) == NULL){
+                    maybe_index_t global_index = ir_gen_find_global(ir_module, base_name);
+
+                    if(global_index != -1){
+                        base_global = &ir_module->globals[global_index];
+                        base_global_traits = base_global->traits;
+                    }
+                }
+            }
+
             if(ir_gen_expression(builder, array_access_expr->value, &array_value, true, &array_type)) return FAILURE;
+
+            if(base_global && array_value->type->kind == TYPE_KIND_POINTER && ((ir_type_t*) array_value->type->extra)->kind != TYPE_KIND_FIXED_ARRAY){
+                base_global->traits = base_global_traits;
+            }
+
             if(ir_gen_expression(builder, array_access_expr->index, &index_value, false, &index_type)){
                 ast_type_free(&array_type);
                 return FAILURE;
@@ -578,9 +582,8 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
 
                 assert(array_type.elements_length != 0);
 
-                ir_type_t *casted_ir_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-                casted_ir_type->kind = TYPE_KIND_POINTER;
-                casted_ir_type->extra = ((ir_type_extra_fixed_array_t*) ((ir_type_t*) array_value->type->extra)->extra)->subtype;
+                ir_type_t *element_ir_type = ((ir_type_extra_fixed_array_t*) ((ir_type_t*) array_value->type->extra)->extra)->subtype;
+                ir_type_t *casted_ir_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, element_ir_type);
                 array_type.elements[0]->id = AST_ELEM_POINTER;
                 array_value = build_bitcast(builder, array_value, casted_ir_type);
             } else if(EXPR_IS_MUTABLE(array_access_expr->value->id)){
@@ -621,13 +624,11 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                 memmove(array_type.elements, &array_type.elements[1], sizeof(ast_elem_t*) * (array_type.elements_length - 1));
                 array_type.elements_length--; // Reduce length accordingly
 
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_array_access_t));
+                instruction = build_instruction(builder, sizeof(ir_instr_array_access_t));
                 ((ir_instr_array_access_t*) instruction)->id = INSTRUCTION_ARRAY_ACCESS;
                 ((ir_instr_array_access_t*) instruction)->result_type = array_value->type;
                 ((ir_instr_array_access_t*) instruction)->value = array_value;
                 ((ir_instr_array_access_t*) instruction)->index = index_value;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
                 *ir_value = build_value_from_prev_instruction(builder);
 
                 // If not requested to leave the expression mutable, dereference it
@@ -635,13 +636,11 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                     *ir_value = build_load(builder, *ir_value);
                 }
             } else /* EXPR_AT */ {
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_array_access_t));
+                instruction = build_instruction(builder, sizeof(ir_instr_array_access_t));
                 ((ir_instr_array_access_t*) instruction)->id = INSTRUCTION_ARRAY_ACCESS;
                 ((ir_instr_array_access_t*) instruction)->result_type = array_value->type;
                 ((ir_instr_array_access_t*) instruction)->value = array_value;
                 ((ir_instr_array_access_t*) instruction)->index = index_value;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
                 *ir_value = build_value_from_prev_instruction(builder);
             }
 
@@ -672,8 +671,7 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
         }
         break;
     case EXPR_SIZEOF: {
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_sizeof_t));
+            instruction = build_instruction(builder, sizeof(ir_instr_sizeof_t));
             ((ir_instr_sizeof_t*) instruction)->id = INSTRUCTION_SIZEOF;
             ((ir_instr_sizeof_t*) instruction)->result_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
             ((ir_instr_sizeof_t*) instruction)->result_type->kind = TYPE_KIND_U64;
@@ -682,7 +680,6 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
             if(ir_gen_resolve_type(builder->compiler, builder->object, &((ast_expr_sizeof_t*) expr)->type,
                     &((ir_instr_sizeof_t*) instruction)->type)) return FAILURE;
 
-            builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
             *ir_value = build_value_from_prev_instruction(builder);
 
             if(out_expr_type != NULL) ast_type_make_base(out_expr_type, strclone("usize"));
@@ -751,14 +748,12 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                 handle_pass_management(builder, arg_values, arg_types, pair.ast_func->arg_type_traits, call_expr->arity + 1);
             }
 
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_call_t));
+            instruction = build_instruction(builder, sizeof(ir_instr_call_t));
             ((ir_instr_call_t*) instruction)->id = INSTRUCTION_CALL;
             ((ir_instr_call_t*) instruction)->result_type = pair.ir_func->return_type;
             ((ir_instr_call_t*) instruction)->values = arg_values;
             ((ir_instr_call_t*) instruction)->values_length = call_expr->arity + 1;
             ((ir_instr_call_t*) instruction)->func_id = pair.func_id;
-            builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
             *ir_value = build_value_from_prev_instruction(builder);
 
             ast_types_free_fully(arg_types, call_expr->arity + 1);
@@ -786,17 +781,14 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
 
             if(expr->id == EXPR_NOT){
                 // Build and append an 'iszero' instruction
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_unary_t));
+                instruction = build_instruction(builder, sizeof(ir_instr_unary_t));
                 ((ir_instr_unary_t*) instruction)->id = INSTRUCTION_ISZERO;
                 ((ir_instr_unary_t*) instruction)->result_type = ir_builder_bool(builder);
                 ((ir_instr_unary_t*) instruction)->value = expr_value;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
                 *ir_value = build_value_from_prev_instruction(builder);
             } else {
                 // Build and append an 'negate' instruction
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_unary_t));
+                instruction = build_instruction(builder, sizeof(ir_instr_unary_t));
                 ((ir_instr_unary_t*) instruction)->result_type = expr_value->type;
                 ((ir_instr_unary_t*) instruction)->value = expr_value;
 
@@ -823,7 +815,6 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                     }
                 }
 
-                builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
                 *ir_value = build_value_from_prev_instruction(builder);
             }
 
@@ -859,16 +850,12 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                 ast_type_free(&multiplier_type);
             }
 
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_malloc_t));
+            instruction = build_instruction(builder, sizeof(ir_instr_malloc_t));
             ((ir_instr_malloc_t*) instruction)->id = INSTRUCTION_MALLOC;
-            ((ir_instr_malloc_t*) instruction)->result_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-            ((ir_instr_malloc_t*) instruction)->result_type->kind = TYPE_KIND_POINTER;
-            ((ir_instr_malloc_t*) instruction)->result_type->extra = ir_type;
+            ((ir_instr_malloc_t*) instruction)->result_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ir_type);
             ((ir_instr_malloc_t*) instruction)->type = ir_type;
             ((ir_instr_malloc_t*) instruction)->amount = amount;
 
-            builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
             *ir_value = build_value_from_prev_instruction(builder);
 
             if(out_expr_type != NULL){
@@ -889,33 +876,26 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
 
             length_t value_length = strlen(new_cstring_expr->value);
 
-            ir_value_t *bytes_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-            bytes_value->value_type = VALUE_TYPE_LITERAL;
-            bytes_value->type = ir_builder_usize(builder);
-            bytes_value->extra = ir_pool_alloc(builder->pool, sizeof(unsigned long long));
+            ir_value_t *bytes_value = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, ir_builder_usize(builder), sizeof(unsigned long long));
             *((unsigned long long*) bytes_value->extra) = value_length + 1;
 
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_malloc_t));
+            instruction = build_instruction(builder, sizeof(ir_instr_malloc_t));
             ((ir_instr_malloc_t*) instruction)->id = INSTRUCTION_MALLOC;
             ((ir_instr_malloc_t*) instruction)->result_type = ubyte_ptr;
             ((ir_instr_malloc_t*) instruction)->type = ubyte;
             ((ir_instr_malloc_t*) instruction)->amount = bytes_value;
 
-            builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
             ir_value_t *heap_memory = build_value_from_prev_instruction(builder);
 
             ir_value_t *cstring_value = build_literal_cstr(builder, new_cstring_expr->value);
 
-            ir_basicblock_new_instructions(builder->current_block, 1);
-            instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_memcpy_t));
+            instruction = build_instruction(builder, sizeof(ir_instr_memcpy_t));
             ((ir_instr_memcpy_t*) instruction)->id = INSTRUCTION_MEMCPY;
             ((ir_instr_memcpy_t*) instruction)->result_type = NULL;
             ((ir_instr_memcpy_t*) instruction)->destination = heap_memory;
             ((ir_instr_memcpy_t*) instruction)->value = cstring_value;
             ((ir_instr_memcpy_t*) instruction)->bytes = bytes_value;
             ((ir_instr_memcpy_t*) instruction)->is_volatile = false;
-            builder->current_block->instructions[builder->current_block->instructions_length++] = instruction;
 
             *ir_value = heap_memory;
             if(out_expr_type != NULL){
@@ -941,10 +921,8 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                 return FAILURE;
             }
 
-            *ir_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-            (*ir_value)->value_type = VALUE_TYPE_LITERAL;
+            *ir_value = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, NULL, sizeof(unsigned long long));
             ir_type_map_find(builder->type_map, enum_value_expr->enum_name, &((*ir_value)->type));
-            (*ir_value)->extra = ir_pool_alloc(builder->pool, sizeof(unsigned long long));
             *((unsigned long long*) (*ir_value)->extra) = enum_kind_id;
 
             if(out_expr_type != NULL) ast_type_make_base(out_expr_type, strclone(enum_value_expr->enum_name));
@@ -1002,7 +980,7 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
                 ast_type_free(&member_type);
             }
 
-            *ir_value = build_static_array(builder->pool, type, values, length);
+            *ir_value = build_static_array(&builder->object->ir_module, type, values, length);
 
             if(out_expr_type != NULL){
                 *out_expr_type = ast_type_clone(&static_array_expr->type);
@@ -1089,7 +1067,7 @@ errorcode_t ir_gen_expression(ir_builder_t *builder, ast_expr_t *expr, ir_value_
             ir_type_t *ir_decl_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
             if(ir_gen_resolve_type(builder->compiler, builder->object, &def->type, &ir_decl_type)) return FAILURE;
 
-            ir_type_t *var_pointer_type = ir_type_pointer_to(builder->pool, ir_decl_type);
+            ir_type_t *var_pointer_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ir_decl_type);
 
             if(def->value != NULL){
                 // Regular inline declare statement initial assign value
@@ -1167,6 +1145,22 @@ errorcode_t build_basic_IvF_math_op(ir_builder_t *builder, ast_expr_math_t *math
         return FAILURE;
     }
 
+    // Pointer arithmetic (pointer +/- integer, integer + pointer, pointer - pointer)
+    if(ints_instr == INSTRUCTION_ADD || ints_instr == INSTRUCTION_SUBTRACT){
+        *ir_value = build_pointer_math(builder, ints_instr, lhs, rhs);
+
+        if(*ir_value != NULL){
+            if(out_expr_type != NULL){
+                if((*ir_value)->type->kind != TYPE_KIND_POINTER) ast_type_make_base(out_expr_type, strclone("long"));
+                else *out_expr_type = ast_type_clone(lhs->type->kind == TYPE_KIND_POINTER ? &ast_type_a : &ast_type_b);
+            }
+
+            ast_type_free(&ast_type_a);
+            ast_type_free(&ast_type_b);
+            return SUCCESS;
+        }
+    }
+
     if(!ast_types_conform(builder, &rhs, &ast_type_b, &ast_type_a, CONFORM_MODE_PRIMITIVES)){
         if(overload_name){
             *ir_value = handle_math_management(builder, lhs, rhs, &ast_type_a, &ast_type_b, out_expr_type, overload_name);
@@ -1194,7 +1188,7 @@ errorcode_t build_basic_IvF_math_op(ir_builder_t *builder, ast_expr_math_t *math
     instruction->a = lhs;
     instruction->b = rhs;
     instruction->id = INSTRUCTION_NONE; // For safety
-    instruction->result_type = lhs->type;
+    instruction->result_type = standard_result_is_boolean ? ir_builder_bool(builder) : lhs->type;
 
     if(i_vs_f_instruction((ir_instr_math_t*) instruction, ints_instr, floats_instr) == FAILURE){
         // Remove math instruction template
@@ -1264,7 +1258,7 @@ errorcode_t build_basic_UvSvF_math_op(ir_builder_t *builder, ast_expr_math_t *ma
     instruction->a = lhs;
     instruction->b = rhs;
     instruction->id = INSTRUCTION_NONE; // For safety
-    instruction->result_type = lhs->type;
+    instruction->result_type = standard_result_is_boolean ? ir_builder_bool(builder) : lhs->type;
 
     if(u_vs_s_vs_float_instruction((ir_instr_math_t*) instruction, unsigned_instr, signed_instr, floats_instr) == FAILURE){
         // Remove math instruction template
@@ -1305,8 +1299,7 @@ ir_instr_t* ir_gen_math_operands(ir_builder_t *builder, ast_expr_t *expr, ir_val
     ir_value_t *a, *b;
     ir_instr_t **instruction;
     ast_type_t ast_type_a, ast_type_b;
-    *ir_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-    (*ir_value)->value_type = VALUE_TYPE_RESULT;
+    *ir_value = build_value_with_extra(builder->pool, VALUE_TYPE_RESULT, NULL, sizeof(ir_value_result_t));
 
     if(ir_gen_expression(builder, ((ast_expr_math_t*) expr)->a, &a, false, &ast_type_a)) return NULL;
     if(ir_gen_expression(builder, ((ast_expr_math_t*) expr)->b, &b, false, &ast_type_b)){
@@ -1362,13 +1355,13 @@ ir_instr_t* ir_gen_math_operands(ir_builder_t *builder, ast_expr_t *expr, ir_val
         return NULL;
     }
 
-    (*ir_value)->extra = ir_pool_alloc(builder->pool, sizeof(ir_value_result_t));
     ((ir_value_result_t*) (*ir_value)->extra)->block_id = builder->current_block_id;
     ((ir_value_result_t*) (*ir_value)->extra)->instruction_id = builder->current_block->instructions_length;
 
     ir_basicblock_new_instructions(builder->current_block, 1);
     instruction = &builder->current_block->instructions[builder->current_block->instructions_length++];
     *instruction = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_math_t));
+    (*instruction)->source = builder->source;
     ((ir_instr_math_t*) *instruction)->a = a;
     ((ir_instr_math_t*) *instruction)->b = b;
     ((ir_instr_math_t*) *instruction)->id = INSTRUCTION_NONE; // For safety
@@ -1,38 +1,162 @@
 
+#include "UTIL/util.h"
 #include "IRGEN/ir_gen_find.h"
 #include "IRGEN/ir_gen_type.h"
 
+void ir_gen_find_index(ir_module_t *module){
+    // NOTE: Assumes the function mappings and methods are already sorted
+
+    for(length_t f = 0; f != module->funcs_length; f++){
+        ir_func_mapping_t *mapping = &module->func_mappings[f];
+        hash_t name_hash = hash_cstr(mapping->name);
+
+        mapping->is_beginning_of_group = f == 0 || strcmp(mapping->name, module->func_mappings[f - 1].name) != 0;
+        if(mapping->is_beginning_of_group) hash_index_insert(&module->func_groups, name_hash, f);
+
+        mapping->arg_types = ir_gen_find_intern_arg_types(module, mapping->ast_func);
+
+        // Variadic functions can match any number of arguments, so they can't be found by signature
+        if(!(mapping->ast_func->traits & AST_FUNC_VARARG)){
+            hash_index_insert(&module->func_signatures, func_signature_hash(name_hash, mapping->arg_types, mapping->ast_func->arity), f);
+        }
+    }
+
+    for(length_t m = 0; m != module->methods_length; m++){
+        ir_method_t *method = &module->methods[m];
+        hash_t name_hash = hash_combine(hash_cstr(method->struct_name), hash_cstr(method->name));
+
+        method->is_beginning_of_group = m == 0 || strcmp(method->name, module->methods[m - 1].name) != 0
+            || strcmp(method->struct_name, module->methods[m - 1].struct_name) != 0;
+        if(method->is_beginning_of_group) hash_index_insert(&module->method_groups, name_hash, m);
+
+        method->arg_types = ir_gen_find_intern_arg_types(module, method->ast_func);
+
+        if(!(method->ast_func->traits & AST_FUNC_VARARG)){
+            hash_index_insert(&module->method_signatures, func_signature_hash(name_hash, method->arg_types, method->ast_func->arity), m);
+        }
+    }
+}
+
+const ast_type_t **ir_gen_find_intern_arg_types(ir_module_t *module, ast_func_t *func){
+    const ast_type_t **interned = malloc(sizeof(ast_type_t*) * func->arity);
+
+    for(length_t a = 0; a != func->arity; a++){
+        interned[a] = ast_type_intern(&module->ast_type_interner, &func->arg_types[a]);
+    }
+
+    return interned;
+}
+
+bool ir_gen_find_interned_types(ir_module_t *module, ast_type_t *types, length_t length, const ast_type_t **out_interned){
+    bool all_interned = true;
+
+    for(length_t i = 0; i != length; i++){
+        out_interned[i] = ast_type_intern_find(&module->ast_type_interner, &types[i]);
+        if(out_interned[i] == NULL) all_interned = false;
+    }
+
+    return all_interned;
+}
+
+hash_t func_signature_hash(hash_t name_hash, const ast_type_t **arg_types, length_t arity){
+    // NOTE: Interned types are the same if and only if they're the same pointer
+    hash_t hash = hash_combine(name_hash, arity);
+    return hash_continue(hash, arg_types, sizeof(ast_type_t*) * arity);
+}
+
+maybe_index_t ir_gen_find_func_group(ir_module_t *ir_module, const char *name){
+    hash_t hash = hash_cstr(name);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&ir_module->func_groups, hash, &cursor); i != -1; i = hash_index_find_next(&ir_module->func_groups, hash, &cursor)){
+        if(strcmp(ir_module->func_mappings[i].name, name) == 0) return i;
+    }
+
+    return -1;
+}
+
+maybe_index_t ir_gen_find_func_exact(ir_module_t *ir_module, const char *name, ast_type_t *arg_types, length_t arg_types_length){
+    // Types that were never interned can't be the argument types of any function
+    const ast_type_t *interned[arg_types_length];
+    if(!ir_gen_find_interned_types(ir_module, arg_types, arg_types_length, interned)) return -1;
+
+    return ir_gen_find_func_interned(ir_module, name, interned, arg_types_length);
+}
+
+maybe_index_t ir_gen_find_func_interned(ir_module_t *ir_module, const char *name, const ast_type_t **arg_types, length_t arg_types_length){
+    hash_t hash = func_signature_hash(hash_cstr(name), arg_types, arg_types_length);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&ir_module->func_signatures, hash, &cursor); i != -1; i = hash_index_find_next(&ir_module->func_signatures, hash, &cursor)){
+        ir_func_mapping_t *mapping = &ir_module->func_mappings[i];
+        if(strcmp(mapping->name, name) == 0 && func_args_match(mapping->ast_func, mapping->arg_types, arg_types, arg_types_length)) return i;
+    }
+
+    return -1;
+}
+
+maybe_index_t ir_gen_find_method_group(ir_module_t *ir_module, const char *struct_name, const char *name){
+    hash_t hash = hash_combine(hash_cstr(struct_name), hash_cstr(name));
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&ir_module->method_groups, hash, &cursor); i != -1; i = hash_index_find_next(&ir_module->method_groups, hash, &cursor)){
+        ir_method_t *method = &ir_module->methods[i];
+        if(strcmp(method->name, name) == 0 && strcmp(method->struct_name, struct_name) == 0) return i;
+    }
+
+    return -1;
+}
+
+maybe_index_t ir_gen_find_method_exact(ir_module_t *ir_module, const char *struct_name, const char *name,
+        ast_type_t *arg_types, length_t arg_types_length){
+    // Types that were never interned can't be the argument types of any method
+    const ast_type_t *interned[arg_types_length];
+    if(!ir_gen_find_interned_types(ir_module, arg_types, arg_types_length, interned)) return -1;
+
+    hash_t hash = func_signature_hash(hash_combine(hash_cstr(struct_name), hash_cstr(name)), interned, arg_types_length);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&ir_module->method_signatures, hash, &cursor); i != -1; i = hash_index_find_next(&ir_module->method_signatures, hash, &cursor)){
+        ir_method_t *method = &ir_module->methods[i];
+        if(strcmp(method->name, name) == 0 && strcmp(method->struct_name, struct_name) == 0
+        && func_args_match(method->ast_func, method->arg_types, interned, arg_types_length)) return i;
+    }
+
+    return -1;
+}
+
 errorcode_t ir_gen_find_func(compiler_t *compiler, object_t *object, const char *name,
         ast_type_t *arg_types, length_t arg_types_length, funcpair_t *result){
     ir_module_t *ir_module = &object->ir_module;
 
-    maybe_index_t index = find_beginning_of_func_group(ir_module->func_mappings, ir_module->funcs_length, name);
-    if(index == -1) return FAILURE;
+    // NOTE: Argument types that were never interned are NULL, which matches nothing
+    const ast_type_t *interned[arg_types_length];
+    bool all_interned = ir_gen_find_interned_types(ir_module, arg_types, arg_types_length, interned);
 
-    ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
+    // Non-variadic functions can be found directly by their signature
+    maybe_index_t index = all_interned ? ir_gen_find_func_interned(ir_module, name, interned, arg_types_length) : -1;
 
-    if(func_args_match(mapping->ast_func, arg_types, arg_types_length)){
+    if(index != -1){
+        ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
         result->ast_func = mapping->ast_func;
         result->ir_func = mapping->module_func;
         result->func_id = mapping->func_id;
         return SUCCESS;
     }
 
-    while(++index != ir_module->funcs_length){
-        mapping = &ir_module->func_mappings[index];
+    index = ir_gen_find_func_group(ir_module, name);
+    if(index == -1) return FAILURE;
 
-        if(mapping->is_beginning_of_group == -1){
-            mapping->is_beginning_of_group = (strcmp(mapping->name, ir_module->func_mappings[index - 1].name) != 0);
-        }
-        if(mapping->is_beginning_of_group == 1) return FAILURE;
+    do {
+        ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
 
-        if(func_args_match(mapping->ast_func, arg_types, arg_types_length)){
+        if((mapping->ast_func->traits & AST_FUNC_VARARG) && func_args_match(mapping->ast_func, mapping->arg_types, interned, arg_types_length)){
             result->ast_func = mapping->ast_func;
             result->ir_func = mapping->module_func;
             result->func_id = mapping->func_id;
             return SUCCESS;
         }
-    }
+    } while(++index != ir_module->funcs_length && !ir_module->func_mappings[index].is_beginning_of_group);
 
     return FAILURE; // No function with that definition found
 }
@@ -41,7 +165,7 @@ errorcode_t ir_gen_find_func_named(compiler_t *compiler, object_t *object,
         const char *name, funcpair_t *result){
     ir_module_t *ir_module = &object->ir_module;
 
-    maybe_index_t index = find_beginning_of_func_group(ir_module->func_mappings, ir_module->funcs_length, name);
+    maybe_index_t index = ir_gen_find_func_group(ir_module, name);
     if(index == -1) return FAILURE;
 
     ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
@@ -55,25 +179,22 @@ errorcode_t ir_gen_find_func_conforming(ir_builder_t *builder, const char *name,
         ast_type_t *arg_types, length_t type_list_length, funcpair_t *result){
     ir_module_t *ir_module = &builder->object->ir_module;
 
-    maybe_index_t index = find_beginning_of_func_group(ir_module->func_mappings, ir_module->funcs_length, name);
-    if(index == -1) return FAILURE;
+    // Prefer a function whose arguments match exactly, since it doesn't require any conversions
+    maybe_index_t index = ir_gen_find_func_exact(ir_module, name, arg_types, type_list_length);
 
-    ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
-
-    if(func_args_conform(builder, mapping->ast_func, arg_values, arg_types, type_list_length)){
+    if(index != -1){
+        ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
         result->ast_func = mapping->ast_func;
         result->ir_func = mapping->module_func;
         result->func_id = mapping->func_id;
         return SUCCESS;
     }
 
-    while(++index != ir_module->funcs_length){
-        mapping = &ir_module->func_mappings[index];
+    index = ir_gen_find_func_group(ir_module, name);
+    if(index == -1) return FAILURE;
 
-        if(mapping->is_beginning_of_group == -1){
-            mapping->is_beginning_of_group = (strcmp(mapping->name, ir_module->func_mappings[index - 1].name) != 0);
-        }
-        if(mapping->is_beginning_of_group == 1) return FAILURE;
+    do {
+        ir_func_mapping_t *mapping = &ir_module->func_mappings[index];
 
         if(func_args_conform(builder, mapping->ast_func, arg_values, arg_types, type_list_length)){
             result->ast_func = mapping->ast_func;
@@ -81,7 +202,7 @@ errorcode_t ir_gen_find_func_conforming(ir_builder_t *builder, const char *name,
             result->func_id = mapping->func_id;
             return SUCCESS;
         }
-    }
+    } while(++index != ir_module->funcs_length && !ir_module->func_mappings[index].is_beginning_of_group);
 
     return FAILURE; // No function with that definition found
 }
@@ -94,25 +215,22 @@ errorcode_t ir_gen_find_method_conforming(ir_builder_t *builder, const char *str
     //           argument for the object being called on
     ir_module_t *ir_module = &builder->object->ir_module;
 
-    maybe_index_t index = find_beginning_of_method_group(ir_module->methods, ir_module->methods_length, struct_name, name);
-    if(index == -1) return FAILURE;
-
-    ir_method_t *method = &ir_module->methods[index];
+    // Prefer a method whose arguments match exactly, since it doesn't require any conversions
+    maybe_index_t index = ir_gen_find_method_exact(ir_module, struct_name, name, arg_types, type_list_length);
 
-    if(func_args_conform(builder, method->ast_func, arg_values, arg_types, type_list_length)){
+    if(index != -1){
+        ir_method_t *method = &ir_module->methods[index];
         result->ast_func = method->ast_func;
         result->ir_func = method->module_func;
         result->func_id = method->func_id;
         return SUCCESS;
     }
 
-    while(++index != ir_module->methods_length){
-        method = &ir_module->methods[index];
+    index = ir_gen_find_method_group(ir_module, struct_name, name);
+    if(index == -1) return FAILURE;
 
-        if(method->is_beginning_of_group == -1){
-            method->is_beginning_of_group = (strcmp(method->name, ir_module->methods[index - 1].name) != 0);
-        }
-        if(method->is_beginning_of_group == 1) return FAILURE;
+    do {
+        ir_method_t *method = &ir_module->methods[index];
 
         if(func_args_conform(builder, method->ast_func, arg_values, arg_types, type_list_length)){
             result->ast_func = method->ast_func;
@@ -120,88 +238,58 @@ errorcode_t ir_gen_find_method_conforming(ir_builder_t *builder, const char *str
             result->func_id = method->func_id;
             return SUCCESS;
         }
-    }
+    } while(++index != ir_module->methods_length && !ir_module->methods[index].is_beginning_of_group);
 
     return FAILURE; // No method with that definition found
 }
 
-maybe_index_t find_beginning_of_func_group(ir_func_mapping_t *mappings, length_t length, const char *name){
-    // Searches for beginning of function group in a list of mappings
-    // If not found returns -1 else returns mapping index
-    // (Where a function group is a group of all the functions with the same name)
+maybe_index_t ir_gen_find_global(ir_module_t *ir_module, const char *name){
+    hash_t hash = hash_cstr(name);
+    length_t cursor;
+    maybe_index_t found = -1;
 
-    maybe_index_t first, middle, last, comparison;
-    first = 0; last = length - 1;
-
-    while(first <= last){
-        middle = (first + last) / 2;
-        comparison = strcmp(mappings[middle].name, name);
-
-        if(comparison == 0){
-            while(true){
-                if(mappings[middle].is_beginning_of_group == -1){
-                    // It is uncalculated, so we must calculate it
-                    bool prev_different_name = middle == 0 ? true : strcmp(mappings[middle - 1].name, name) != 0;
-                    mappings[middle].is_beginning_of_group = prev_different_name;
-                }
-                if(mappings[middle].is_beginning_of_group == 1) return middle;
-                // Not the beginning of the group, check the previous if it is
-                middle--; // DANGEROUS: Potential for negative index
-            }
-
-            return middle;
-        }
-        else if(comparison > 0) last = middle - 1;
-        else first = middle + 1;
+    // NOTE: The first global declared with a name wins, regardless of probe order
+    for(maybe_index_t i = hash_index_find(&ir_module->globals_index, hash, &cursor); i != -1; i = hash_index_find_next(&ir_module->globals_index, hash, &cursor)){
+        if(strcmp(ir_module->globals[i].name, name) == 0 && (found == -1 || i < found)) found = i;
     }
 
-    return -1;
+    return found;
 }
 
-maybe_index_t find_beginning_of_method_group(ir_method_t *methods, length_t length,
-    const char *struct_name, const char *name){
-    // Searches for beginning of method group in a list of methods
-    // If not found returns -1 else returns mapping index
-    // (Where a function group is a group of all the functions with the same name)
-
-    maybe_index_t first, middle, last, comparison;
-    first = 0; last = length - 1;
-
-    while(first <= last){
-        middle = (first + last) / 2;
-        comparison = strcmp(methods[middle].struct_name, struct_name);
-
-        if(comparison == 0){
-            comparison = strcmp(methods[middle].name, name);
-
-            if(comparison == 0){
-                while(true){
-                    if(methods[middle].is_beginning_of_group == -1){
-                        // It is uncalculated, so we must calculate it
-                        bool prev_different_name = middle == 0 ? true : strcmp(methods[middle - 1].name, name) != 0;
-                        methods[middle].is_beginning_of_group = prev_different_name;
-                    }
-                    if(methods[middle].is_beginning_of_group == 1){
-                        return middle;
-                    }
-                    // Not the beginning of the group, check the previous if it is
-                    middle--; // DANGEROUS: Potential for negative index
-                }
-
-                return middle;
-            }
-            else if(comparison > 0) last = middle - 1;
-            else first = middle + 1;
-        }
-        else if(comparison > 0) last = middle - 1;
-        else first = middle + 1;
+ir_management_t *ir_gen_find_management(ir_module_t *ir_module, weak_cstr_t type_name){
+    hash_t hash = hash_cstr(type_name);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&ir_module->managements_index, hash, &cursor); i != -1; i = hash_index_find_next(&ir_module->managements_index, hash, &cursor)){
+        if(strcmp(ir_module->managements[i].type_name, type_name) == 0) return &ir_module->managements[i];
     }
 
-    return -1;
+    expand((void**) &ir_module->managements, sizeof(ir_management_t), ir_module->managements_length, &ir_module->managements_capacity, 1, 16);
+    hash_index_insert(&ir_module->managements_index, hash, ir_module->managements_length);
+
+    ir_management_t *management = &ir_module->managements[ir_module->managements_length++];
+    management->type_name = strclone(type_name);
+    management->defer_method = ir_gen_find_method_group(ir_module, type_name, "__defer__");
+    management->assign_method = ir_gen_find_method_group(ir_module, type_name, "__assign__");
+
+    // NOTE: 'type' borrows 'type_name' and is only used for the lookup
+    ast_elem_base_t elem;
+    elem.id = AST_ELEM_BASE;
+    elem.source = NULL_SOURCE;
+    elem.base = type_name;
+
+    ast_elem_t *elements[] = {(ast_elem_t*) &elem};
+    ast_type_t type;
+    type.elements = elements;
+    type.elements_length = 1;
+    type.source = NULL_SOURCE;
+
+    // NOTE: '__pass__' functions are never variadic, so they're always in the signature index
+    management->pass_mapping = ir_gen_find_func_exact(ir_module, "__pass__", &type, 1);
+    return management;
 }
 
-successful_t func_args_match(ast_func_t *func, ast_type_t *type_list, length_t type_list_length){
-    ast_type_t *arg_types = func->arg_types;
+successful_t func_args_match(ast_func_t *func, const ast_type_t **arg_types, const ast_type_t **type_list, length_t type_list_length){
     length_t args_count = func->arity;
 
     if(func->traits & AST_FUNC_VARARG){
@@ -210,8 +298,9 @@ successful_t func_args_match(ast_func_t *func, ast_type_t *type_list, length_t t
         if(args_count != type_list_length) return false;
     }
 
+    // NOTE: Interned types are identical if and only if they're the same pointer
     for(length_t a = 0; a != args_count; a++){
-        if(!ast_types_identical(&arg_types[a], &type_list[a])) return false;
+        if(arg_types[a] != type_list[a]) return false;
     }
 
     return true;
@@ -33,6 +33,7 @@ errorcode_t ir_gen_func_statements(compiler_t *compiler, object_t *object, ast_f
     builder.module_func = module_func;
     builder.next_var_id = 0;
     builder.has_string_struct = TROOLEAN_UNKNOWN;
+    builder.source = ast_func->source;
 
     ir_basicblock_t *entry_block = &builder.basicblocks[0];
     entry_block->instructions = malloc(sizeof(ir_instr_t*) * 16);
@@ -107,7 +108,7 @@ errorcode_t ir_gen_func_statements(compiler_t *compiler, object_t *object, ast_f
             // Return an int under the hood for 'func main void'
             ir_instr_t *built_instr = build_instruction(&builder, sizeof(ir_instr_ret_t));
             ((ir_instr_ret_t*) built_instr)->id = INSTRUCTION_RET;
-            ((ir_instr_ret_t*) built_instr)->value = build_literal_int(builder.pool, 0);
+            ((ir_instr_ret_t*) built_instr)->value = build_literal_int(&builder, 0);
         } else {
             source_t where = (statements_length != 0) ? statements[statements_length - 1]->source : ast_func->source;
             char *return_typename = ast_type_str(&ast_func->return_type);
@@ -137,10 +138,13 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
     ir_instr_t **instr = NULL;
     ir_value_t *expression_value = NULL;
     ast_type_t temporary_type;
+    source_t parent_source = builder->source;
 
     if(out_is_terminated) *out_is_terminated = false;
 
     for(length_t s = 0; s != statements_length; s++){
+        builder->source = statements[s]->source;
+
         switch(statements[s]->id){
         case EXPR_RETURN:
             /* handle __defer__ calls */ {
@@ -169,7 +173,7 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                 ast_type_free(&temporary_type);
             } else if(builder->ast_func->traits & AST_FUNC_MAIN && ast_type_is_void(&builder->ast_func->return_type)){
                 // Return 0 if in main function and it returns void
-                expression_value = build_literal_int(builder->pool, 0);
+                expression_value = build_literal_int(builder, 0);
             } else {
                 // Return void
                 expression_value = NULL;
@@ -219,7 +223,7 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
 
                 if(var){
                     ast_var_type = var->ast_type;
-                    ir_var_type = ir_type_pointer_to(builder->pool, var->ir_type);
+                    ir_var_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, var->ir_type);
 
                     if(ast_var_type->elements[0]->id != AST_ELEM_FUNC){
                         char *s = ast_type_str(ast_var_type);
@@ -310,14 +314,12 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
 
                     handle_pass_management(builder, arg_values, arg_types, NULL, call_stmt->arity);
 
-                    ir_basicblock_new_instructions(builder->current_block, 1);
-                    built_instr = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_call_address_t));
+                    built_instr = build_instruction(builder, sizeof(ir_instr_call_address_t));
                     ((ir_instr_call_address_t*) built_instr)->id = INSTRUCTION_CALL_ADDRESS;
                     ((ir_instr_call_address_t*) built_instr)->result_type = ir_return_type;
                     ((ir_instr_call_address_t*) built_instr)->address = expression_value;
                     ((ir_instr_call_address_t*) built_instr)->values = arg_values;
                     ((ir_instr_call_address_t*) built_instr)->values_length = call_stmt->arity;
-                    builder->current_block->instructions[builder->current_block->instructions_length++] = built_instr;
 
                     for(length_t t = 0; t != call_stmt->arity; t++) ast_type_free(&arg_types[t]);
                     free(arg_types);
@@ -366,10 +368,8 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                 if(declare_stmt->value != NULL){
                     // Regular declare statement initial assign value
                     ir_value_t *initial;
-                    ir_value_t *destination = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-                    ir_type_t *var_pointer_type = ir_pool_alloc(builder->pool, sizeof(ir_type_t));
-                    var_pointer_type->kind = TYPE_KIND_POINTER;
-                    var_pointer_type->extra = ir_decl_type;
+                    ir_value_t *destination = build_value_with_extra(builder->pool, VALUE_TYPE_RESULT, NULL, sizeof(ir_value_result_t));
+                    ir_type_t *var_pointer_type = ir_type_pointer_to(&builder->object->ir_module.type_interner, ir_decl_type);
 
                     if(ir_gen_expression(builder, declare_stmt->value, &initial, false, &temporary_type)) return FAILURE;
 
@@ -388,13 +388,12 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                     ir_basicblock_new_instructions(builder->current_block, 2);
                     instr = &builder->current_block->instructions[builder->current_block->instructions_length++];
                     *instr = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_varptr_t));
+                    (*instr)->source = builder->source;
                     ((ir_instr_varptr_t*) *instr)->id = INSTRUCTION_VARPTR;
                     ((ir_instr_varptr_t*) *instr)->index = builder->next_var_id;
                     ((ir_instr_varptr_t*) *instr)->result_type = var_pointer_type;
 
-                    destination->value_type = VALUE_TYPE_RESULT;
                     destination->type = var_pointer_type;
-                    destination->extra = ir_pool_alloc(builder->pool, sizeof(ir_value_result_t));
                     ((ir_value_result_t*) (destination)->extra)->block_id = builder->current_block_id;
                     ((ir_value_result_t*) (destination)->extra)->instruction_id = builder->current_block->instructions_length - 1;
 
@@ -414,6 +413,7 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                     ir_basicblock_new_instructions(builder->current_block, 1);
                     instr = &builder->current_block->instructions[builder->current_block->instructions_length++];
                     *instr = (ir_instr_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_varzeroinit_t));
+                    (*instr)->source = builder->source;
                     ((ir_instr_varzeroinit_t*) *instr)->id = INSTRUCTION_VARZEROINIT;
                     ((ir_instr_varzeroinit_t*) *instr)->result_type = NULL;
                     ((ir_instr_varzeroinit_t*) *instr)->index = builder->next_var_id - 1;
@@ -432,6 +432,20 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                     return FAILURE;
                 }
 
+                // Pointer arithmetic assignment (pointer += integer, pointer -= integer)
+                if(assignment_type == EXPR_ADDASSIGN || assignment_type == EXPR_SUBTRACTASSIGN){
+                    ir_type_t *destination_ir_type = ir_type_dereference(destination->type);
+
+                    if(destination_ir_type != NULL && destination_ir_type->kind == TYPE_KIND_POINTER && ir_type_is_integer(expression_value->type)){
+                        unsigned int instr_id = assignment_type == EXPR_ADDASSIGN ? INSTRUCTION_ADD : INSTRUCTION_SUBTRACT;
+                        ir_value_t *pointer = build_load(builder, destination);
+                        build_store(builder, build_pointer_math(builder, instr_id, pointer, expression_value), destination);
+                        ast_type_free(&destination_type);
+                        ast_type_free(&expression_value_type);
+                        break;
+                    }
+                }
+
                 if(!ast_types_conform(builder, &expression_value, &expression_value_type, &destination_type, CONFORM_MODE_PRIMITIVES)){
                     char *a_type_str = ast_type_str(&expression_value_type);
                     char *b_type_str = ast_type_str(&destination_type);
@@ -867,14 +881,12 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                     handle_pass_management(builder, arg_values, arg_types, pair.ast_func->arg_type_traits, call_stmt->arity + 1);
                 }
 
-                ir_basicblock_new_instructions(builder->current_block, 1);
-                ir_instr_call_t* instruction = (ir_instr_call_t*) ir_pool_alloc(builder->pool, sizeof(ir_instr_call_t));
+                ir_instr_call_t* instruction = (ir_instr_call_t*) build_instruction(builder, sizeof(ir_instr_call_t));
                 instruction->id = INSTRUCTION_CALL;
                 instruction->result_type = pair.ir_func->return_type;
                 instruction->values = arg_values;
                 instruction->values_length = call_stmt->arity + 1;
                 instruction->func_id = pair.func_id;
-                builder->current_block->instructions[builder->current_block->instructions_length++] = (ir_instr_t*) instruction;
 
                 for(length_t t = 0; t != call_stmt->arity + 1; t++) ast_type_free(&arg_types[t]);
                 free(arg_types);
@@ -1024,10 +1036,7 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                 ir_value_t *idx_ptr = build_varptr(builder, idx_ir_type_ptr, idx_var_id);
 
                 // Set 'idx' to inital value of zero
-                ir_value_t *initial_idx = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-                initial_idx->value_type = VALUE_TYPE_LITERAL;
-                initial_idx->type = idx_ir_type;
-                initial_idx->extra = ir_pool_alloc(builder->pool, sizeof(unsigned long long));
+                ir_value_t *initial_idx = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, idx_ir_type, sizeof(unsigned long long));
                 *((unsigned long long*) initial_idx->extra) = 0;
 
                 build_store(builder, initial_idx, idx_ptr);
@@ -1144,10 +1153,8 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                 build_using_basicblock(builder, inc_basicblock_id);
 
                 ir_value_t *current_idx = build_load(builder, idx_ptr);
-                ir_value_t *ir_one_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-                ir_one_value->value_type = VALUE_TYPE_LITERAL;
+                ir_value_t *ir_one_value = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, NULL, sizeof(unsigned long long));
                 ir_type_map_find(builder->type_map, "usize", &(ir_one_value->type));
-                ir_one_value->extra = ir_pool_alloc(builder->pool, sizeof(unsigned long long));
                 *((unsigned long long*) ir_one_value->extra) = 1;
 
                 // Increament
@@ -1213,10 +1220,7 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                 ir_value_t *idx_ptr = build_varptr(builder, idx_ir_type_ptr, idx_var_id);
 
                 // Set 'idx' to inital value of zero
-                ir_value_t *initial_idx = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-                initial_idx->value_type = VALUE_TYPE_LITERAL;
-                initial_idx->type = idx_ir_type;
-                initial_idx->extra = ir_pool_alloc(builder->pool, sizeof(unsigned long long));
+                ir_value_t *initial_idx = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, idx_ir_type, sizeof(unsigned long long));
                 *((unsigned long long*) initial_idx->extra) = 0;
 
                 build_store(builder, initial_idx, idx_ptr);
@@ -1279,10 +1283,8 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
                 build_using_basicblock(builder, inc_basicblock_id);
 
                 ir_value_t *current_idx = build_load(builder, idx_ptr);
-                ir_value_t *ir_one_value = ir_pool_alloc(builder->pool, sizeof(ir_value_t));
-                ir_one_value->value_type = VALUE_TYPE_LITERAL;
+                ir_value_t *ir_one_value = build_value_with_extra(builder->pool, VALUE_TYPE_LITERAL, NULL, sizeof(unsigned long long));
                 ir_type_map_find(builder->type_map, "usize", &(ir_one_value->type));
-                ir_one_value->extra = ir_pool_alloc(builder->pool, sizeof(unsigned long long));
                 *((unsigned long long*) ir_one_value->extra) = 1;
 
                 // Increament
@@ -1315,5 +1317,7 @@ errorcode_t ir_gen_statements(ir_builder_t *builder, ast_expr_t **statements, le
         }
     }
 
+    // Anything built after these statements belongs to the enclosing statement
+    builder->source = parent_source;
     return SUCCESS;
 }
@@ -83,6 +83,10 @@ errorcode_t ir_gen_type_mappings(compiler_t *compiler, object_t *object){
     qsort(mappings, type_map->mappings_length, sizeof(ir_type_mapping_t), (void*) ir_type_mapping_cmp);
     type_map->mappings = mappings;
 
+    for(length_t i = 0; i != type_map->mappings_length; i++){
+        hash_index_insert(&type_map->index, hash_cstr(mappings[i].name), i);
+    }
+
     for(length_t i = 0; i != type_map->mappings_length; i++){
         // Fill in bodies for struct type maps
         if(mappings[i].type.kind != TYPE_KIND_STRUCTURE) continue;
@@ -126,9 +130,8 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, ast_type
     // NOTE: Stores resolved type into 'resolved_type'
     // NOTE: If this function fails, 'resolved_type' is not guaranteed to be the same.
     //       However, no memory will have to be manually freed after this call since
-    //       everything that is allocated is allocated inside the memory pool 'object->ir_module->pool'
-    // NOTE: Therefore, don't call this function if you expect it to fail, because it will pollute the pool
-    //       will inactive and unused memory.
+    //       every type that is created is interned in 'object->ir_module->type_interner'
+    // NOTE: Resolved types are interned, so resolving the same type again gives the same pointer
     // TODO: Add ability to handle cases with dynamic arrays etc.
 
     ir_module_t *ir_module = &object->ir_module;
@@ -137,8 +140,10 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, ast_type
 
     if(unresolved_type->elements_length == 1 && unresolved_type->elements[0]->id == AST_ELEM_BASE && strcmp(((ast_elem_base_t*) unresolved_type->elements[0])->base, "void") == 0){
         // Special void type
-        *resolved_type = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_t));
-        (*resolved_type)->kind = TYPE_KIND_VOID;
+        ir_type_t void_type;
+        void_type.kind = TYPE_KIND_VOID;
+        void_type.extra = NULL;
+        *resolved_type = ir_type_intern(&ir_module->type_interner, &void_type);
         return SUCCESS;
     }
 
@@ -162,24 +167,33 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, ast_type
         break;
     case AST_ELEM_FUNC: {
             ast_elem_func_t *function = (ast_elem_func_t*) unresolved_type->elements[non_concrete_layers];
-            ir_type_extra_function_t *extra = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_extra_function_t));
+            ir_type_extra_function_t extra;
 
-            *resolved_type = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_t));
-            (*resolved_type)->kind = TYPE_KIND_FUNCPTR;
-            (*resolved_type)->extra = extra;
+            extra.traits = TRAIT_NONE;
+            if(function->traits & AST_FUNC_VARARG)  extra.traits |= TYPE_KIND_FUNC_VARARG;
+            if(function->traits & AST_FUNC_STDCALL) extra.traits |= TYPE_KIND_FUNC_STDCALL;
 
-            extra->traits = TRAIT_NONE;
-            if(function->traits & AST_FUNC_VARARG)  extra->traits |= TYPE_KIND_FUNC_VARARG;
-            if(function->traits & AST_FUNC_STDCALL) extra->traits |= TYPE_KIND_FUNC_STDCALL;
-
-            extra->arity = function->arity;
-            extra->arg_types = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_t*) * extra->arity);
+            // NOTE: The argument types are only needed until the function pointer type is interned
+            extra.arity = function->arity;
+            extra.arg_types = malloc(sizeof(ir_type_t*) * extra.arity);
 
             for(length_t a = 0; a != function->arity; a++){
-                if(ir_gen_resolve_type(compiler, object, &function->arg_types[a], &extra->arg_types[a])) return FAILURE;
+                if(ir_gen_resolve_type(compiler, object, &function->arg_types[a], &extra.arg_types[a])){
+                    free(extra.arg_types);
+                    return FAILURE;
+                }
             }
 
-            if(ir_gen_resolve_type(compiler, object, function->return_type, &extra->return_type)) return FAILURE;
+            if(ir_gen_resolve_type(compiler, object, function->return_type, &extra.return_type)){
+                free(extra.arg_types);
+                return FAILURE;
+            }
+
+            ir_type_t funcptr_type;
+            funcptr_type.kind = TYPE_KIND_FUNCPTR;
+            funcptr_type.extra = &extra;
+            *resolved_type = ir_type_intern(&ir_module->type_interner, &funcptr_type);
+            free(extra.arg_types);
         }
         break;
     default: {
@@ -191,25 +205,19 @@ errorcode_t ir_gen_resolve_type(compiler_t *compiler, object_t *object, ast_type
     }
 
     for(length_t i = non_concrete_layers; i != 0; i--){
-        ir_type_t *wrapped_type = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_t));
         unsigned int non_concrete_element_id = unresolved_type->elements[i - 1]->id;
 
         if(non_concrete_element_id == AST_ELEM_POINTER){
-            wrapped_type->kind = TYPE_KIND_POINTER;
-            wrapped_type->extra = *resolved_type;
+            *resolved_type = ir_type_pointer_to(&ir_module->type_interner, *resolved_type);
         } else if(non_concrete_element_id == AST_ELEM_FIXED_ARRAY){
-            ir_type_extra_fixed_array_t *fixed_array = ir_pool_alloc(&ir_module->pool, sizeof(ir_type_extra_fixed_array_t));
-            fixed_array->subtype = *resolved_type;
-            fixed_array->length = ((ast_elem_fixed_array_t*) unresolved_type->elements[i - 1])->length;
-            wrapped_type->kind = TYPE_KIND_FIXED_ARRAY;
-            wrapped_type->extra = fixed_array;
+            length_t length = ((ast_elem_fixed_array_t*) unresolved_type->elements[i - 1])->length;
+            *resolved_type = ir_type_fixed_array_of(&ir_module->type_interner, *resolved_type, length);
         } else {
             char *unresolved_str_rep = ast_type_str(unresolved_type);
             compiler_panicf(compiler, unresolved_type->source, "INTERNAL ERROR: Unknown non-concrete type element id in type '%s'", unresolved_str_rep);
             free(unresolved_str_rep);
+            return FAILURE;
         }
-
-        *resolved_type = wrapped_type;
     }
 
     return SUCCESS;
@@ -467,7 +475,7 @@ successful_t ast_types_conform(ir_builder_t *builder, ir_value_t **ir_value, ast
                     // -------------------------------------------------------------
                     
                     // x = x + x + x * 0xFFFFFFFFFFFFul (6 bytes of 1s)
-                    reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder->pool, 0xFFFFFFFFFFFFul), placeholder_actual_type);
+                    reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder, 0xFFFFFFFFFFFFul), placeholder_actual_type);
                     values[1] = build_math(builder, INSTRUCTION_ADD, values[1], values[1], placeholder_actual_type);
                     values[1] = build_math(builder, INSTRUCTION_ADD, reflection_mask, values[1], placeholder_actual_type);
                     #endif
@@ -486,7 +494,7 @@ successful_t ast_types_conform(ir_builder_t *builder, ir_value_t **ir_value, ast
                     // -------------------------------------------------------------
                     
                     // x = x + x + x * 0xFFFFFFFF (4 bytes of 1s)
-                    reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder->pool, 0xFFFFFFFF), placeholder_actual_type);
+                    reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder, 0xFFFFFFFF), placeholder_actual_type);
                     values[1] = build_math(builder, INSTRUCTION_ADD, values[1], values[1], placeholder_actual_type);
                     values[1] = build_math(builder, INSTRUCTION_ADD, reflection_mask, values[1], placeholder_actual_type);
                     #endif
@@ -507,7 +515,7 @@ successful_t ast_types_conform(ir_builder_t *builder, ir_value_t **ir_value, ast
                     // -------------------------------------------------------------
 
                     // x = x + x + x * 0xFFFFFFFFFFFFFFul (7 bytes of 1s)
-                    reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder->pool, 0xFFFFFFFFFFFFFFul), placeholder_actual_type);
+                    reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder, 0xFFFFFFFFFFFFFFul), placeholder_actual_type);
                     values[1] = build_math(builder, INSTRUCTION_ADD, values[1], values[1], placeholder_actual_type);
                     values[1] = build_math(builder, INSTRUCTION_ADD, reflection_mask, values[1], placeholder_actual_type);
                     #endif
@@ -527,7 +535,7 @@ successful_t ast_types_conform(ir_builder_t *builder, ir_value_t **ir_value, ast
                         // -------------------------------------------------------------
                         
                         // x = x + x + x * 0xFFFFFFFF (4 bytes of 1s)
-                        reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder->pool, 0xFFFFFFFF), placeholder_actual_type);
+                        reflection_mask = build_math(builder, INSTRUCTION_MULTIPLY, values[1], build_literal_usize(builder, 0xFFFFFFFF), placeholder_actual_type);
                         values[1] = build_math(builder, INSTRUCTION_ADD, values[1], values[1], placeholder_actual_type);
                         values[1] = build_math(builder, INSTRUCTION_ADD, reflection_mask, values[1], placeholder_actual_type);
                         #endif
@@ -544,12 +552,12 @@ successful_t ast_types_conform(ir_builder_t *builder, ir_value_t **ir_value, ast
                     values[1] = *ir_value;
                     break;
                 default:
-                    values[1] = build_literal_usize(builder->pool, 0);
+                    values[1] = build_literal_usize(builder, 0);
                 }
             }
             break;
         default:
-            values[1] = build_literal_usize(builder->pool, 0);
+            values[1] = build_literal_usize(builder, 0);
         }
 
         //#define AST_ELEM_NONE          0x00
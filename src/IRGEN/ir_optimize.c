@@ -0,0 +1,704 @@
+
+#include "UTIL/util.h"
+#include "UTIL/color.h"
+#include "IR/ir_type.h"
+#include "IRGEN/ir_builder.h"
+#include "IRGEN/ir_optimize.h"
+
+void ir_optimize_module(ir_module_t *module){
+    for(length_t f = 0; f != module->funcs_length; f++){
+        // Foreign functions don't have any basic blocks
+        if(module->funcs[f].basicblocks_length == 0) continue;
+
+        ir_optimize_func(module, &module->funcs[f]);
+    }
+}
+
+void ir_optimize_func(ir_module_t *module, ir_func_t *func){
+    ir_optimizer_t optimizer;
+    optimizer.module = module;
+    optimizer.func = func;
+    optimizer.blocks = malloc(sizeof(ir_optimizer_block_t) * func->basicblocks_length);
+    optimizer.variables = malloc(sizeof(ir_optimizer_variable_t) * func->variable_count);
+    optimizer.touched = malloc(sizeof(length_t) * func->variable_count);
+    optimizer.touched_length = 0;
+    optimizer.renumbered = NULL;
+    optimizer.renumbered_length = 0;
+    optimizer.renumbered_capacity = 0;
+    hash_index_init(&optimizer.renumbered_index);
+    memset(optimizer.variables, 0, sizeof(ir_optimizer_variable_t) * func->variable_count);
+
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        ir_optimizer_block_t *block = &optimizer.blocks[b];
+        length_t instructions_length = func->basicblocks[b].instructions_length;
+
+        block->replacements = malloc(sizeof(ir_value_t*) * instructions_length);
+        block->results = malloc(sizeof(ir_value_t*) * instructions_length);
+        block->uses = malloc(sizeof(length_t) * instructions_length);
+        block->new_ids = malloc(sizeof(length_t) * instructions_length);
+        block->reachable = false;
+        block->new_id = 0;
+        memset(block->replacements, 0, sizeof(ir_value_t*) * instructions_length);
+        memset(block->results, 0, sizeof(ir_value_t*) * instructions_length);
+        memset(block->uses, 0, sizeof(length_t) * instructions_length);
+    }
+
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        ir_optimize_block(&optimizer, b);
+    }
+
+    // Resolve everything once more, since instructions can use
+    // the results of instructions in later basic blocks
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        ir_basicblock_t *block = &func->basicblocks[b];
+
+        for(length_t i = 0; i != block->instructions_length; i++){
+            if(block->instructions[i] != NULL) ir_optimize_resolve_operands(&optimizer, block->instructions[i]);
+        }
+    }
+
+    ir_optimize_find_reachable(&optimizer);
+
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        if(!optimizer.blocks[b].reachable) continue;
+        ir_basicblock_t *block = &func->basicblocks[b];
+
+        for(length_t i = 0; i != block->instructions_length; i++){
+            if(block->instructions[i] == NULL) continue;
+
+            ir_value_t **operand;
+            for(length_t o = 0; (operand = ir_instr_operand(block->instructions[i], o)); o++){
+                ir_optimize_use(&optimizer, *operand, true);
+            }
+        }
+    }
+
+    // NOTE: Compacting changes 'basicblocks_length', so remember how many there were
+    length_t blocks_length = func->basicblocks_length;
+
+    ir_optimize_remove_dead(&optimizer);
+    ir_optimize_compact(&optimizer);
+
+    for(length_t b = 0; b != blocks_length; b++){
+        free(optimizer.blocks[b].replacements);
+        free(optimizer.blocks[b].results);
+        free(optimizer.blocks[b].uses);
+        free(optimizer.blocks[b].new_ids);
+    }
+
+    free(optimizer.blocks);
+    free(optimizer.variables);
+    free(optimizer.touched);
+    free(optimizer.renumbered);
+    hash_index_free(&optimizer.renumbered_index);
+}
+
+void ir_optimize_block(ir_optimizer_t *optimizer, length_t block_id){
+    ir_basicblock_t *block = &optimizer->func->basicblocks[block_id];
+    ir_optimizer_variable_t *variables = optimizer->variables;
+
+    // Nothing is known about stack variables at the beginning of a basic block
+    ir_optimize_forget(optimizer, true);
+
+    for(length_t i = 0; i != block->instructions_length; i++){
+        ir_instr_t *instruction = block->instructions[i];
+        if(instruction == NULL) continue;
+
+        ir_optimize_resolve_operands(optimizer, instruction);
+
+        ir_value_t *replacement = NULL;
+        maybe_index_t variable;
+
+        switch(instruction->id){
+        case INSTRUCTION_VARPTR: {
+                length_t index = ((ir_instr_varptr_t*) instruction)->index;
+                if(index >= optimizer->func->variable_count) break;
+
+                // Only keep the first pointer to each stack variable
+                if(variables[index].pointer != NULL){
+                    replacement = variables[index].pointer;
+                } else {
+                    ir_optimize_touch(optimizer, index);
+                    variables[index].pointer = ir_optimize_result(optimizer, block_id, i);
+                }
+            }
+            break;
+        case INSTRUCTION_LOAD: {
+                variable = ir_optimize_variable_of(optimizer, ((ir_instr_load_t*) instruction)->value);
+                if(variable == -1) break;
+
+                // Reuse whatever value was last stored into (or loaded from) the stack variable
+                ir_value_t *known = variables[variable].value;
+
+                if(known != NULL && ir_optimize_types_equal(known->type, instruction->result_type)){
+                    replacement = known;
+                } else {
+                    ir_optimize_touch(optimizer, variable);
+                    variables[variable].value = ir_optimize_result(optimizer, block_id, i);
+                }
+            }
+            break;
+        case INSTRUCTION_STORE:
+            variable = ir_optimize_variable_of(optimizer, ((ir_instr_store_t*) instruction)->destination);
+
+            if(variable == -1){
+                // Storing through any other pointer could change any stack variable
+                ir_optimize_forget(optimizer, false);
+            } else {
+                ir_optimize_touch(optimizer, variable);
+                variables[variable].value = ((ir_instr_store_t*) instruction)->value;
+            }
+            break;
+        case INSTRUCTION_VARZEROINIT: {
+                length_t index = ((ir_instr_varzeroinit_t*) instruction)->index;
+                if(index < optimizer->func->variable_count) variables[index].value = NULL;
+            }
+            break;
+        case INSTRUCTION_BITCAST:
+        case INSTRUCTION_REINTERPRET: {
+                // Casting to the same type does nothing
+                ir_value_t *value = ((ir_instr_cast_t*) instruction)->value;
+
+                if(ir_optimize_types_equal(value->type, instruction->result_type)){
+                    replacement = value;
+                } else {
+                    replacement = ir_optimize_fold(optimizer->module, instruction);
+                }
+            }
+            break;
+        case INSTRUCTION_CONDBREAK: {
+                ir_instr_cond_break_t *cond_break = (ir_instr_cond_break_t*) instruction;
+                unsigned long long condition;
+
+                if(!ir_optimize_literal_bits(cond_break->value, &condition)) break;
+
+                // Branches on constant conditions always go the same way
+                ir_instr_break_t *break_instr = ir_pool_alloc(&optimizer->module->pool, sizeof(ir_instr_break_t));
+                break_instr->id = INSTRUCTION_BREAK;
+                break_instr->result_type = cond_break->result_type;
+                break_instr->source = cond_break->source;
+                break_instr->block_id = condition ? cond_break->true_block_id : cond_break->false_block_id;
+                block->instructions[i] = (ir_instr_t*) break_instr;
+            }
+            break;
+        default:
+            replacement = ir_optimize_fold(optimizer->module, instruction);
+            if(!ir_instr_preserves_variables(instruction->id)) ir_optimize_forget(optimizer, false);
+        }
+
+        if(replacement != NULL){
+            optimizer->blocks[block_id].replacements[i] = replacement;
+            block->instructions[i] = NULL;
+        }
+    }
+}
+
+ir_value_t *ir_optimize_resolve(ir_optimizer_t *optimizer, ir_value_t *value){
+    while(value != NULL && value->value_type == VALUE_TYPE_RESULT){
+        ir_value_result_t *result = (ir_value_result_t*) value->extra;
+        ir_value_t *replacement = optimizer->blocks[result->block_id].replacements[result->instruction_id];
+
+        if(replacement == NULL) break;
+        value = replacement;
+    }
+
+    if(value != NULL && value->value_type == VALUE_TYPE_STRUCT_CONSTRUCTION){
+        ir_value_struct_construction_t *construction = (ir_value_struct_construction_t*) value->extra;
+
+        for(length_t i = 0; i != construction->length; i++){
+            construction->values[i] = ir_optimize_resolve(optimizer, construction->values[i]);
+        }
+    }
+
+    return value;
+}
+
+void ir_optimize_resolve_operands(ir_optimizer_t *optimizer, ir_instr_t *instruction){
+    ir_value_t **operand;
+
+    for(length_t o = 0; (operand = ir_instr_operand(instruction, o)); o++){
+        *operand = ir_optimize_resolve(optimizer, *operand);
+    }
+}
+
+ir_value_t *ir_optimize_result(ir_optimizer_t *optimizer, length_t block_id, length_t instruction_id){
+    ir_value_t **result_value = &optimizer->blocks[block_id].results[instruction_id];
+
+    if(*result_value == NULL){
+        ir_type_t *result_type = optimizer->func->basicblocks[block_id].instructions[instruction_id]->result_type;
+        *result_value = build_value_with_extra(&optimizer->module->pool, VALUE_TYPE_RESULT, result_type, sizeof(ir_value_result_t));
+
+        ir_value_result_t *result = (ir_value_result_t*) (*result_value)->extra;
+        result->block_id = block_id;
+        result->instruction_id = instruction_id;
+    }
+
+    return *result_value;
+}
+
+maybe_index_t ir_optimize_variable_of(ir_optimizer_t *optimizer, ir_value_t *pointer){
+    if(pointer == NULL || pointer->value_type != VALUE_TYPE_RESULT) return -1;
+
+    ir_value_result_t *result = (ir_value_result_t*) pointer->extra;
+    ir_instr_t *instruction = optimizer->func->basicblocks[result->block_id].instructions[result->instruction_id];
+    if(instruction == NULL || instruction->id != INSTRUCTION_VARPTR) return -1;
+
+    length_t index = ((ir_instr_varptr_t*) instruction)->index;
+    return index < optimizer->func->variable_count ? (maybe_index_t) index : -1;
+}
+
+void ir_optimize_touch(ir_optimizer_t *optimizer, length_t variable){
+    if(optimizer->variables[variable].touched) return;
+
+    optimizer->variables[variable].touched = true;
+    optimizer->touched[optimizer->touched_length++] = variable;
+}
+
+void ir_optimize_forget(ir_optimizer_t *optimizer, bool forget_pointers){
+    length_t kept = 0;
+
+    for(length_t t = 0; t != optimizer->touched_length; t++){
+        ir_optimizer_variable_t *variable = &optimizer->variables[optimizer->touched[t]];
+        variable->value = NULL;
+        if(forget_pointers) variable->pointer = NULL;
+
+        // Pointers to stack variables stay valid, so keep track of the ones that remain
+        if(variable->pointer != NULL){
+            optimizer->touched[kept++] = optimizer->touched[t];
+        } else {
+            variable->touched = false;
+        }
+    }
+
+    optimizer->touched_length = kept;
+}
+
+ir_value_t *ir_optimize_fold(ir_module_t *module, ir_instr_t *instruction){
+    ir_type_t *result_type = instruction->result_type;
+    if(result_type == NULL) return NULL;
+
+    unsigned long long a, b, result;
+    unsigned int type_kind;
+    bool is_comparison = false;
+
+    switch(instruction->id){
+    case INSTRUCTION_ADD: case INSTRUCTION_SUBTRACT: case INSTRUCTION_MULTIPLY:
+    case INSTRUCTION_UDIVIDE: case INSTRUCTION_SDIVIDE: case INSTRUCTION_UMODULUS: case INSTRUCTION_SMODULUS:
+    case INSTRUCTION_EQUALS: case INSTRUCTION_NOTEQUALS:
+    case INSTRUCTION_UGREATER: case INSTRUCTION_SGREATER: case INSTRUCTION_ULESSER: case INSTRUCTION_SLESSER:
+    case INSTRUCTION_UGREATEREQ: case INSTRUCTION_SGREATEREQ: case INSTRUCTION_ULESSEREQ: case INSTRUCTION_SLESSEREQ:
+    case INSTRUCTION_AND: case INSTRUCTION_OR: case INSTRUCTION_BIT_AND: case INSTRUCTION_BIT_OR: case INSTRUCTION_BIT_XOR:
+    case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT: {
+            ir_instr_math_t *math = (ir_instr_math_t*) instruction;
+
+            if(!ir_optimize_literal_bits(math->a, &a) || !ir_optimize_literal_bits(math->b, &b)) return NULL;
+            if(math->a->type->kind != math->b->type->kind) return NULL;
+
+            type_kind = math->a->type->kind;
+            unsigned int width = global_type_kind_sizes_64[type_kind];
+            unsigned long long mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+            unsigned long long sign = 1ULL << (width - 1);
+
+            // Unsigned and signed interpretations of each operand
+            unsigned long long ua = a & mask, ub = b & mask;
+            long long sa = (long long) ((ua ^ sign) - sign), sb = (long long) ((ub ^ sign) - sign);
+
+            switch(instruction->id){
+            case INSTRUCTION_ADD:      result = a + b; break;
+            case INSTRUCTION_SUBTRACT: result = a - b; break;
+            case INSTRUCTION_MULTIPLY: result = a * b; break;
+            case INSTRUCTION_UDIVIDE: case INSTRUCTION_UMODULUS:
+                if(ub == 0) return NULL;
+                result = instruction->id == INSTRUCTION_UDIVIDE ? ua / ub : ua % ub;
+                break;
+            case INSTRUCTION_SDIVIDE: case INSTRUCTION_SMODULUS:
+                // Leave division by zero and overflowing division to happen at runtime
+                if(sb == 0 || (sb == -1 && (unsigned long long) sa == 0ULL - sign)) return NULL;
+                result = (unsigned long long) (instruction->id == INSTRUCTION_SDIVIDE ? sa / sb : sa % sb);
+                break;
+            case INSTRUCTION_EQUALS:     result = ua == ub; is_comparison = true; break;
+            case INSTRUCTION_NOTEQUALS:  result = ua != ub; is_comparison = true; break;
+            case INSTRUCTION_UGREATER:   result = ua > ub;  is_comparison = true; break;
+            case INSTRUCTION_SGREATER:   result = sa > sb;  is_comparison = true; break;
+            case INSTRUCTION_ULESSER:    result = ua < ub;  is_comparison = true; break;
+            case INSTRUCTION_SLESSER:    result = sa < sb;  is_comparison = true; break;
+            case INSTRUCTION_UGREATEREQ: result = ua >= ub; is_comparison = true; break;
+            case INSTRUCTION_SGREATEREQ: result = sa >= sb; is_comparison = true; break;
+            case INSTRUCTION_ULESSEREQ:  result = ua <= ub; is_comparison = true; break;
+            case INSTRUCTION_SLESSEREQ:  result = sa <= sb; is_comparison = true; break;
+            case INSTRUCTION_AND: case INSTRUCTION_BIT_AND: result = a & b; break;
+            case INSTRUCTION_OR:  case INSTRUCTION_BIT_OR:  result = a | b; break;
+            case INSTRUCTION_BIT_XOR: result = a ^ b; break;
+            case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT:
+                // Shifting by the width of the type or more has an undefined result
+                if(ub >= width) return NULL;
+
+                if(instruction->id == INSTRUCTION_BIT_LSHIFT){
+                    result = a << ub;
+                } else if(instruction->id == INSTRUCTION_BIT_LGC_RSHIFT){
+                    result = ua >> ub;
+                } else {
+                    // (Arithmetic shift, regardless of whether the type is signed)
+                    result = (unsigned long long) (sa < 0 ? ~(~sa >> ub) : sa >> ub);
+                }
+                break;
+            default:
+                return NULL;
+            }
+        }
+        break;
+    case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: case INSTRUCTION_BIT_COMPLEMENT: case INSTRUCTION_NEGATE: {
+            ir_value_t *value = ((ir_instr_unary_t*) instruction)->value;
+            if(!ir_optimize_literal_bits(value, &a)) return NULL;
+
+            type_kind = value->type->kind;
+
+            switch(instruction->id){
+            case INSTRUCTION_ISZERO:         result = a == 0; is_comparison = true; break;
+            case INSTRUCTION_ISNTZERO:       result = a != 0; is_comparison = true; break;
+            case INSTRUCTION_BIT_COMPLEMENT: result = ~a;     break;
+            case INSTRUCTION_NEGATE:         result = 0 - a;  break;
+            default:
+                return NULL;
+            }
+        }
+        break;
+    case INSTRUCTION_ZEXT: case INSTRUCTION_TRUNC: case INSTRUCTION_REINTERPRET: {
+            ir_value_t *value = ((ir_instr_cast_t*) instruction)->value;
+            if(!ir_optimize_literal_bits(value, &a)) return NULL;
+
+            // Only casts between integers can become literals
+            if(result_type->kind < TYPE_KIND_S8 || result_type->kind > TYPE_KIND_U64) return NULL;
+
+            unsigned int width = global_type_kind_sizes_64[value->type->kind];
+            result = instruction->id == INSTRUCTION_ZEXT && width != 64 ? a & ((1ULL << width) - 1) : a;
+
+            // The result has the type that is being casted to
+            type_kind = result_type->kind;
+        }
+        break;
+    default:
+        return NULL;
+    }
+
+    // NOTE: IR generation gives comparison instructions a boolean result type
+    if(result_type->kind != (is_comparison ? TYPE_KIND_BOOLEAN : type_kind)) return NULL;
+
+    return ir_optimize_literal(module, result_type, ir_optimize_normalize(result_type->kind, result));
+}
+
+bool ir_optimize_literal_bits(ir_value_t *value, unsigned long long *out_bits){
+    if(value == NULL || value->value_type != VALUE_TYPE_LITERAL) return false;
+
+    unsigned long long bits;
+
+    switch(value->type->kind){
+    case TYPE_KIND_S8:      bits = (unsigned long long) *((char*) value->extra); break;
+    case TYPE_KIND_U8:      bits = *((unsigned char*) value->extra); break;
+    case TYPE_KIND_S16:     bits = (unsigned long long) *((int*) value->extra); break;
+    case TYPE_KIND_U16:     bits = *((unsigned int*) value->extra); break;
+    case TYPE_KIND_S32:     bits = (unsigned long long) *((long long*) value->extra); break;
+    case TYPE_KIND_U32:     bits = *((unsigned long long*) value->extra); break;
+    case TYPE_KIND_S64:     bits = (unsigned long long) *((long long*) value->extra); break;
+    case TYPE_KIND_U64:     bits = *((unsigned long long*) value->extra); break;
+    case TYPE_KIND_BOOLEAN: bits = *((bool*) value->extra); break;
+    default:
+        return false;
+    }
+
+    *out_bits = ir_optimize_normalize(value->type->kind, bits);
+    return true;
+}
+
+unsigned long long ir_optimize_normalize(unsigned int type_kind, unsigned long long bits){
+    unsigned int width = global_type_kind_sizes_64[type_kind];
+    if(width == 0 || width >= 64) return bits;
+
+    unsigned long long mask = (1ULL << width) - 1;
+    bits &= mask;
+
+    if(global_type_kind_signs[type_kind] && (bits & (1ULL << (width - 1)))) bits |= ~mask;
+    return bits;
+}
+
+ir_value_t *ir_optimize_literal(ir_module_t *module, ir_type_t *type, unsigned long long bits){
+    ir_value_t **constant = ir_module_constant(module, VALUE_TYPE_LITERAL, type, bits);
+    if(*constant != NULL) return *constant;
+
+    // NOTE: Literals are stored the same way that 'ir_to_llvm_value' expects them
+    switch(type->kind){
+    case TYPE_KIND_S8: case TYPE_KIND_U8:
+        *constant = build_value_with_extra(&module->shared_pool, VALUE_TYPE_LITERAL, type, sizeof(char));
+        *((char*) (*constant)->extra) = (char) bits;
+        break;
+    case TYPE_KIND_S16: case TYPE_KIND_U16:
+        *constant = build_value_with_extra(&module->shared_pool, VALUE_TYPE_LITERAL, type, sizeof(int));
+        *((unsigned int*) (*constant)->extra) = (unsigned int) bits;
+        break;
+    case TYPE_KIND_S32: case TYPE_KIND_U32: case TYPE_KIND_S64: case TYPE_KIND_U64:
+        *constant = build_value_with_extra(&module->shared_pool, VALUE_TYPE_LITERAL, type, sizeof(unsigned long long));
+        *((unsigned long long*) (*constant)->extra) = bits;
+        break;
+    case TYPE_KIND_BOOLEAN:
+        *constant = build_value_with_extra(&module->shared_pool, VALUE_TYPE_LITERAL, type, sizeof(bool));
+        *((bool*) (*constant)->extra) = bits != 0;
+        break;
+    default:
+        redprintf("INTERNAL ERROR: ir_optimize_literal received non-integer type kind\n");
+        return NULL;
+    }
+
+    return *constant;
+}
+
+void ir_optimize_find_reachable(ir_optimizer_t *optimizer){
+    ir_func_t *func = optimizer->func;
+    length_t *worklist = malloc(sizeof(length_t) * func->basicblocks_length);
+    length_t worklist_length = 0;
+
+    optimizer->blocks[0].reachable = true;
+    worklist[worklist_length++] = 0;
+
+    // NOTE: A basic block can only use the results of basic blocks that
+    //       always run before it, so those will have been reached too
+    while(worklist_length != 0){
+        ir_basicblock_t *block = &func->basicblocks[worklist[--worklist_length]];
+
+        for(length_t i = 0; i != block->instructions_length; i++){
+            ir_instr_t *instruction = block->instructions[i];
+            length_t targets[2];
+            length_t targets_length = 0;
+
+            if(instruction == NULL) continue;
+
+            if(instruction->id == INSTRUCTION_BREAK){
+                targets[targets_length++] = ((ir_instr_break_t*) instruction)->block_id;
+            } else if(instruction->id == INSTRUCTION_CONDBREAK){
+                targets[targets_length++] = ((ir_instr_cond_break_t*) instruction)->true_block_id;
+                targets[targets_length++] = ((ir_instr_cond_break_t*) instruction)->false_block_id;
+            }
+
+            for(length_t t = 0; t != targets_length; t++){
+                if(optimizer->blocks[targets[t]].reachable) continue;
+
+                optimizer->blocks[targets[t]].reachable = true;
+                worklist[worklist_length++] = targets[t];
+            }
+        }
+    }
+
+    free(worklist);
+}
+
+void ir_optimize_use(ir_optimizer_t *optimizer, ir_value_t *value, bool is_use){
+    if(value == NULL) return;
+
+    if(value->value_type == VALUE_TYPE_RESULT){
+        ir_value_result_t *result = (ir_value_result_t*) value->extra;
+        length_t *uses = &optimizer->blocks[result->block_id].uses[result->instruction_id];
+
+        if(is_use) (*uses)++;
+        else (*uses)--;
+    } else if(value->value_type == VALUE_TYPE_STRUCT_CONSTRUCTION){
+        ir_value_struct_construction_t *construction = (ir_value_struct_construction_t*) value->extra;
+
+        for(length_t i = 0; i != construction->length; i++){
+            ir_optimize_use(optimizer, construction->values[i], is_use);
+        }
+    }
+}
+
+void ir_optimize_remove_dead(ir_optimizer_t *optimizer){
+    ir_func_t *func = optimizer->func;
+    bool removed_any;
+
+    // Removing an instruction can make the instructions that it used dead too
+    do {
+        removed_any = false;
+
+        for(length_t b = 0; b != func->basicblocks_length; b++){
+            if(!optimizer->blocks[b].reachable) continue;
+            ir_basicblock_t *block = &func->basicblocks[b];
+
+            for(length_t i = block->instructions_length; i != 0; i--){
+                ir_instr_t *instruction = block->instructions[i - 1];
+
+                if(instruction == NULL || optimizer->blocks[b].uses[i - 1] != 0 || !ir_instr_is_pure(instruction->id)) continue;
+
+                ir_value_t **operand;
+                for(length_t o = 0; (operand = ir_instr_operand(instruction, o)); o++){
+                    ir_optimize_use(optimizer, *operand, false);
+                }
+
+                block->instructions[i - 1] = NULL;
+                removed_any = true;
+            }
+        }
+    } while(removed_any);
+}
+
+void ir_optimize_compact(ir_optimizer_t *optimizer){
+    ir_func_t *func = optimizer->func;
+    length_t blocks_length = 0;
+
+    // Figure out where everything will end up
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        ir_optimizer_block_t *block = &optimizer->blocks[b];
+        if(!block->reachable) continue;
+
+        block->new_id = blocks_length++;
+        length_t instructions_length = 0;
+
+        for(length_t i = 0; i != func->basicblocks[b].instructions_length; i++){
+            if(func->basicblocks[b].instructions[i] != NULL) block->new_ids[i] = instructions_length++;
+        }
+    }
+
+    // Renumber references to basic blocks and instruction results
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        if(!optimizer->blocks[b].reachable) continue;
+        ir_basicblock_t *block = &func->basicblocks[b];
+
+        for(length_t i = 0; i != block->instructions_length; i++){
+            ir_instr_t *instruction = block->instructions[i];
+            if(instruction == NULL) continue;
+
+            ir_value_t **operand;
+            for(length_t o = 0; (operand = ir_instr_operand(instruction, o)); o++){
+                ir_optimize_renumber(optimizer, *operand);
+            }
+
+            if(instruction->id == INSTRUCTION_BREAK){
+                ir_instr_break_t *break_instr = (ir_instr_break_t*) instruction;
+                break_instr->block_id = optimizer->blocks[break_instr->block_id].new_id;
+            } else if(instruction->id == INSTRUCTION_CONDBREAK){
+                ir_instr_cond_break_t *cond_break = (ir_instr_cond_break_t*) instruction;
+                cond_break->true_block_id = optimizer->blocks[cond_break->true_block_id].new_id;
+                cond_break->false_block_id = optimizer->blocks[cond_break->false_block_id].new_id;
+            }
+        }
+    }
+
+    // Move what's left into place
+    for(length_t b = 0; b != func->basicblocks_length; b++){
+        ir_basicblock_t *block = &func->basicblocks[b];
+
+        if(!optimizer->blocks[b].reachable){
+            free(block->instructions);
+            continue;
+        }
+
+        length_t instructions_length = 0;
+
+        for(length_t i = 0; i != block->instructions_length; i++){
+            if(block->instructions[i] != NULL) block->instructions[instructions_length++] = block->instructions[i];
+        }
+
+        block->instructions_length = instructions_length;
+        func->basicblocks[optimizer->blocks[b].new_id] = *block;
+    }
+
+    func->basicblocks_length = blocks_length;
+}
+
+void ir_optimize_renumber(ir_optimizer_t *optimizer, ir_value_t *value){
+    if(value == NULL) return;
+
+    if(value->value_type == VALUE_TYPE_STRUCT_CONSTRUCTION){
+        ir_value_struct_construction_t *construction = (ir_value_struct_construction_t*) value->extra;
+
+        for(length_t i = 0; i != construction->length; i++){
+            ir_optimize_renumber(optimizer, construction->values[i]);
+        }
+        return;
+    }
+
+    if(value->value_type != VALUE_TYPE_RESULT) return;
+
+    ir_value_result_t *result = (ir_value_result_t*) value->extra;
+    hash_t hash = hash_data(&result, sizeof(ir_value_result_t*));
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&optimizer->renumbered_index, hash, &cursor); i != -1; i = hash_index_find_next(&optimizer->renumbered_index, hash, &cursor)){
+        if(optimizer->renumbered[i] == result) return;
+    }
+
+    expand((void**) &optimizer->renumbered, sizeof(ir_value_result_t*), optimizer->renumbered_length, &optimizer->renumbered_capacity, 1, 64);
+    hash_index_insert(&optimizer->renumbered_index, hash, optimizer->renumbered_length);
+    optimizer->renumbered[optimizer->renumbered_length++] = result;
+
+    ir_optimizer_block_t *block = &optimizer->blocks[result->block_id];
+    result->instruction_id = block->new_ids[result->instruction_id];
+    result->block_id = block->new_id;
+}
+
+bool ir_optimize_types_equal(ir_type_t *a, ir_type_t *b){
+    if(a == b) return true;
+    if(a->kind != b->kind) return false;
+
+    switch(a->kind){
+    case TYPE_KIND_POINTER:
+        return ir_optimize_types_equal((ir_type_t*) a->extra, (ir_type_t*) b->extra);
+    case TYPE_KIND_FUNCPTR: {
+            ir_type_extra_function_t *a_function = (ir_type_extra_function_t*) a->extra;
+            ir_type_extra_function_t *b_function = (ir_type_extra_function_t*) b->extra;
+
+            // (The generic function pointer type doesn't have any details)
+            if(a_function == NULL || b_function == NULL) return false;
+
+            if(a_function->arity != b_function->arity || a_function->traits != b_function->traits) return false;
+            if(!ir_optimize_types_equal(a_function->return_type, b_function->return_type)) return false;
+
+            for(length_t i = 0; i != a_function->arity; i++){
+                if(!ir_optimize_types_equal(a_function->arg_types[i], b_function->arg_types[i])) return false;
+            }
+            return true;
+        }
+    case TYPE_KIND_FIXED_ARRAY: {
+            ir_type_extra_fixed_array_t *a_fixed_array = (ir_type_extra_fixed_array_t*) a->extra;
+            ir_type_extra_fixed_array_t *b_fixed_array = (ir_type_extra_fixed_array_t*) b->extra;
+            return a_fixed_array->length == b_fixed_array->length && ir_optimize_types_equal(a_fixed_array->subtype, b_fixed_array->subtype);
+        }
+    case TYPE_KIND_UNION: case TYPE_KIND_STRUCTURE:
+        // Composites that are laid out the same can still lower to different types
+        return false;
+    }
+
+    return true;
+}
+
+bool ir_instr_is_pure(unsigned int id){
+    switch(id){
+    case INSTRUCTION_ADD: case INSTRUCTION_FADD: case INSTRUCTION_SUBTRACT: case INSTRUCTION_FSUBTRACT:
+    case INSTRUCTION_MULTIPLY: case INSTRUCTION_FMULTIPLY: case INSTRUCTION_FDIVIDE: case INSTRUCTION_FMODULUS:
+    case INSTRUCTION_EQUALS: case INSTRUCTION_FEQUALS: case INSTRUCTION_NOTEQUALS: case INSTRUCTION_FNOTEQUALS:
+    case INSTRUCTION_UGREATER: case INSTRUCTION_SGREATER: case INSTRUCTION_FGREATER:
+    case INSTRUCTION_ULESSER: case INSTRUCTION_SLESSER: case INSTRUCTION_FLESSER:
+    case INSTRUCTION_UGREATEREQ: case INSTRUCTION_SGREATEREQ: case INSTRUCTION_FGREATEREQ:
+    case INSTRUCTION_ULESSEREQ: case INSTRUCTION_SLESSEREQ: case INSTRUCTION_FLESSEREQ:
+    case INSTRUCTION_AND: case INSTRUCTION_OR: case INSTRUCTION_BIT_AND: case INSTRUCTION_BIT_OR: case INSTRUCTION_BIT_XOR:
+    case INSTRUCTION_BIT_LSHIFT: case INSTRUCTION_BIT_RSHIFT: case INSTRUCTION_BIT_LGC_RSHIFT:
+    case INSTRUCTION_PTR_ADD: case INSTRUCTION_PTR_SUBTRACT: case INSTRUCTION_PTR_DIFFERENCE:
+    case INSTRUCTION_ISZERO: case INSTRUCTION_ISNTZERO: case INSTRUCTION_BIT_COMPLEMENT:
+    case INSTRUCTION_NEGATE: case INSTRUCTION_FNEGATE:
+    case INSTRUCTION_BITCAST: case INSTRUCTION_ZEXT: case INSTRUCTION_TRUNC: case INSTRUCTION_FEXT:
+    case INSTRUCTION_FTRUNC: case INSTRUCTION_INTTOPTR: case INSTRUCTION_PTRTOINT: case INSTRUCTION_FPTOUI:
+    case INSTRUCTION_FPTOSI: case INSTRUCTION_UITOFP: case INSTRUCTION_SITOFP: case INSTRUCTION_REINTERPRET:
+    case INSTRUCTION_VARPTR: case INSTRUCTION_GLOBALVARPTR: case INSTRUCTION_MEMBER: case INSTRUCTION_ARRAY_ACCESS:
+    case INSTRUCTION_FUNC_ADDRESS: case INSTRUCTION_SIZEOF: case INSTRUCTION_OFFSETOF:
+        return true;
+    }
+
+    // (Division can trap, and everything else either has effects or depends on memory)
+    return false;
+}
+
+bool ir_instr_preserves_variables(unsigned int id){
+    switch(id){
+    case INSTRUCTION_UDIVIDE: case INSTRUCTION_SDIVIDE: case INSTRUCTION_UMODULUS: case INSTRUCTION_SMODULUS:
+    case INSTRUCTION_LOAD: case INSTRUCTION_RET: case INSTRUCTION_BREAK: case INSTRUCTION_CONDBREAK:
+        return true;
+    }
+
+    return ir_instr_is_pure(id);
+}
@@ -242,9 +242,7 @@ errorcode_t lex_buffer(compiler_t *compiler, object_t *object){
                     // Isn't a keyword, just an identifier
                     t = &((*tokens)[tokenlist->length]);
                     t->id = TOKEN_WORD;
-                    t->data = malloc(lex_state.buildup_length + 1);
-                    memcpy(t->data, lex_state.buildup, lex_state.buildup_length);
-                    ((char*) t->data)[lex_state.buildup_length] = '\0';
+                    t->data = cstr_intern(&compiler->identifiers, lex_state.buildup, lex_state.buildup_length);
                 } else {
                     // Is a keyword, figure out token index from array index
                     t = &((*tokens)[tokenlist->length]);
@@ -158,9 +158,14 @@ errorcode_t pkg_read(compiler_t *compiler, object_t *object){
                 buildup[buildup_length] = read;
                 fread(&read, sizeof(char), 1, file);
             }
-            tokenlist->tokens[t].data = malloc(buildup_length + 1);
-            memcpy(tokenlist->tokens[t].data, buildup, buildup_length);
-            ((char*)tokenlist->tokens[t].data)[buildup_length] = '\0';
+
+            if(id == TOKEN_WORD){
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, buildup, buildup_length);
+            } else {
+                tokenlist->tokens[t].data = malloc(buildup_length + 1);
+                memcpy(tokenlist->tokens[t].data, buildup, buildup_length);
+                ((char*)tokenlist->tokens[t].data)[buildup_length] = '\0';
+            }
         }
         else if(id == TOKEN_STRING){
             length_t length;
@@ -214,53 +219,41 @@ errorcode_t pkg_read(compiler_t *compiler, object_t *object){
 
             switch(id){
             case TOKEN_PKG_WBOOL:
-                tokenlist->tokens[t].data = malloc(5);
-                memcpy(tokenlist->tokens[t].data, "bool", 5);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "bool", 4);
                 break;
             case TOKEN_PKG_WBYTE:
-                tokenlist->tokens[t].data = malloc(5);
-                memcpy(tokenlist->tokens[t].data, "byte", 5);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "byte", 4);
                 break;
             case TOKEN_PKG_WUBYTE:
-                tokenlist->tokens[t].data = malloc(6);
-                memcpy(tokenlist->tokens[t].data, "ubyte", 6);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "ubyte", 5);
                 break;
             case TOKEN_PKG_WSHORT:
-                tokenlist->tokens[t].data = malloc(6);
-                memcpy(tokenlist->tokens[t].data, "short", 6);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "short", 5);
                 break;
             case TOKEN_PKG_WUSHORT:
-                tokenlist->tokens[t].data = malloc(7);
-                memcpy(tokenlist->tokens[t].data, "ushort", 7);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "ushort", 6);
                 break;
             case TOKEN_PKG_WINT:
-                tokenlist->tokens[t].data = malloc(4);
-                memcpy(tokenlist->tokens[t].data, "int", 4);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "int", 3);
                 break;
             case TOKEN_PKG_WUINT:
-                tokenlist->tokens[t].data = malloc(5);
-                memcpy(tokenlist->tokens[t].data, "uint", 5);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "uint", 4);
                 break;
             case TOKEN_PKG_WLONG:
-                tokenlist->tokens[t].data = malloc(5);
-                memcpy(tokenlist->tokens[t].data, "long", 5);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "long", 4);
                 break;
             case TOKEN_PKG_WULONG:
-                tokenlist->tokens[t].data = malloc(6);
-                memcpy(tokenlist->tokens[t].data, "ulong", 6);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "ulong", 5);
                 break;
             case TOKEN_PKG_WFLOAT:
-                tokenlist->tokens[t].data = malloc(6);
-                memcpy(tokenlist->tokens[t].data, "float", 6);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "float", 5);
                 break;
             case TOKEN_PKG_WDOUBLE:
-                tokenlist->tokens[t].data = malloc(7);
-                memcpy(tokenlist->tokens[t].data, "double", 7);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "double", 6);
                 break;
                 break;
             case TOKEN_PKG_WUSIZE:
-                tokenlist->tokens[t].data = malloc(6);
-                memcpy(tokenlist->tokens[t].data, "usize", 6);
+                tokenlist->tokens[t].data = cstr_intern(&compiler->identifiers, "usize", 5);
                 break;
             }
         }
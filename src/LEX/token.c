@@ -170,6 +170,9 @@ void tokenlist_print(tokenlist_t *tokenlist, const char *buffer){
 
 void tokenlist_free(tokenlist_t *tokenlist){
     for(length_t i = 0; i != tokenlist->length; i++){
+        // NOTE: The strings of words belong to the compiler's identifier interner
+        if(tokenlist->tokens[i].id == TOKEN_WORD) continue;
+
         if(tokenlist->tokens[i].id == TOKEN_STRING){
             free(((token_string_data_t*) tokenlist->tokens[i].data)->array);
         }
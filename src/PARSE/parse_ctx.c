@@ -1,4 +1,5 @@
 
+#include "UTIL/util.h"
 #include "UTIL/color.h"
 #include "PARSE/parse_ctx.h"
 
@@ -96,9 +97,8 @@ maybe_null_strong_cstr_t parse_take_word(parse_ctx_t *ctx, const char *error){
         return NULL;
     }
 
-    strong_cstr_t ownership = (char*) ctx->tokenlist->tokens[i].data;
-    ctx->tokenlist->tokens[(*ctx->i)++].data = NULL;
-    return ownership;
+    // NOTE: The strings of words are interned, so the caller gets its own copy
+    return strclone((char*) ctx->tokenlist->tokens[(*ctx->i)++].data);
 }
 
 // =================================================
@@ -244,9 +244,9 @@ errorcode_t parse_expr_post(parse_ctx_t *ctx, ast_expr_t **inout_expr){
                     ast_expr_member_t *memb_expr = malloc(sizeof(ast_expr_member_t));
                     memb_expr->id = EXPR_MEMBER;
                     memb_expr->value = *inout_expr;
-                    memb_expr->member = (char*) tokens[*i].data;
+                    memb_expr->member = strclone((char*) tokens[*i].data);
                     memb_expr->source = sources[*i - 1];
-                    tokens[(*i)++].data = NULL; // Take ownership
+                    (*i)++;
                     *inout_expr = (ast_expr_t*) memb_expr;
                 }
             }
@@ -1,4 +1,5 @@
 
+#include "UTIL/util.h"
 #include "UTIL/color.h"
 #include "UTIL/search.h"
 #include "UTIL/filename.h"
@@ -18,8 +19,9 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     maybe_null_weak_cstr_t read = NULL;
 
     const char * const directives[] = {
-        "compiler_version", "deprecated", "help", "mac_only", "no_type_info", "no_undef", "optimization", "options",
-        "package", "project_name", "unsupported", "windows_only"
+        "assume_no_overflow", "compiler_version", "deprecated", "fast_math", "help", "mac_only", "march", "mattr",
+        "mcpu", "no_type_info", "no_undef", "optimization", "options", "package", "project_name",
+        "prune_type_info", "unsupported", "windows_only"
     };
 
     const length_t directives_length = sizeof(directives) / sizeof(const char * const);
@@ -30,7 +32,10 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
     maybe_index_t directive = binary_string_search(directives, directives_length, directive_string);
 
     switch(directive){
-    case 0: // 'compiler_version' directive
+    case 0: // 'assume_no_overflow' directive
+        ctx->compiler->traits |= COMPILER_NO_OVERFLOW;
+        return SUCCESS;
+    case 1: // 'compiler_version' directive
         read = parse_grab_string(ctx, "Expected compiler version string after 'pragma compiler_version'");
 
         if(read == NULL){
@@ -47,7 +52,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
             return FAILURE;
         }
         return SUCCESS;
-    case 1: // 'deprecated' directive
+    case 2: // 'deprecated' directive
         read = parse_grab_string(ctx, NULL);
 
         if(read == NULL){
@@ -63,23 +68,57 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
             compiler_warn(ctx->compiler, ctx->tokenlist->sources[*i], "This file is deprecated and may be removed in the future");
         }
         return SUCCESS;
-    case 2: // 'help' directive
+    case 3: // 'fast_math' directive
+        ctx->compiler->traits |= COMPILER_FAST_MATH;
+        return SUCCESS;
+    case 4: // 'help' directive
         show_help();
         return FAILURE;
-    case 3: // 'mac_only' directive
+    case 5: // 'mac_only' directive
         #if !defined(__APPLE__) || !TARGET_OS_MAC
         compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Mac");
         return FAILURE;
         #else
         return SUCCESS;
         #endif
-    case 4: // 'no_type_info' directive
+    case 6: // 'march' directive
+        read = parse_grab_string(ctx, "Expected CPU name after 'pragma march'");
+
+        if(read == NULL){
+            puts("\nDid you mean: pragma march 'native'?");
+            return FAILURE;
+        }
+
+        free(ctx->compiler->target_cpu);
+        free(ctx->compiler->target_features);
+        ctx->compiler->target_cpu = strclone(read);
+        ctx->compiler->target_features = NULL;
+        return SUCCESS;
+    case 7: // 'mattr' directive
+        read = parse_grab_string(ctx, "Expected CPU features after 'pragma mattr'");
+
+        if(read == NULL){
+            puts("\nDid you mean: pragma mattr '+avx2,+fma'?");
+            return FAILURE;
+        }
+
+        free(ctx->compiler->target_features);
+        ctx->compiler->target_features = strclone(read);
+        return SUCCESS;
+    case 8: // 'mcpu' directive
+        read = parse_grab_string(ctx, "Expected CPU name after 'pragma mcpu'");
+        if(read == NULL) return FAILURE;
+
+        free(ctx->compiler->target_cpu);
+        ctx->compiler->target_cpu = strclone(read);
+        return SUCCESS;
+    case 9: // 'no_type_info' directive
         ctx->compiler->traits |= COMPILER_NO_TYPE_INFO;
         return SUCCESS;
-    case 5: // 'no_undef' directive
+    case 10: // 'no_undef' directive
         ctx->compiler->traits |= COMPILER_NO_UNDEF;
         return SUCCESS;
-    case 6: // 'optimization' directive
+    case 11: // 'optimization' directive
         read = parse_grab_word(ctx, "Expected optimization level after 'pragma optimization'");
 
         if(read == NULL){
@@ -99,22 +138,25 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
             return FAILURE;
         }
         return SUCCESS;
-    case 7: // 'options' directive
+    case 12: // 'options' directive
         return parse_pragma_cloptions(ctx);
-    case 8: // 'package' directive
+    case 13: // 'package' directive
         if(ctx->compiler->traits & COMPILER_INFLATE_PACKAGE) return SUCCESS;
         if(compiler_create_package(ctx->compiler, ctx->object) == 0){
             ctx->compiler->result_flags |= COMPILER_RESULT_SUCCESS;
         }
         return FAILURE;
-    case 9: // 'project_name' directive
+    case 14: // 'project_name' directive
         read = parse_grab_string(ctx, "Expected string containing project name after 'pragma project_name'");
         if(read == NULL) return FAILURE;
 
         free(ctx->compiler->output_filename);
         ctx->compiler->output_filename = filename_local(ctx->object->filename, read);
         return SUCCESS;
-    case 10: // 'unsupported' directive
+    case 15: // 'prune_type_info' directive
+        ctx->compiler->traits |= COMPILER_PRUNE_TYPE_INFO;
+        return SUCCESS;
+    case 16: // 'unsupported' directive
         read = parse_grab_string(ctx, NULL);
 
         if(read == NULL){
@@ -131,7 +173,7 @@ errorcode_t parse_pragma(parse_ctx_t *ctx){
             compiler_panic(ctx->compiler, ctx->tokenlist->sources[*i], "This file is no longer supported or never was unsupported");
         }
         return FAILURE;
-    case 11: // 'windows_only' directive
+    case 17: // 'windows_only' directive
         #ifndef _WIN32
         compiler_panicf(ctx->compiler, ctx->tokenlist->sources[*i], "This file only works on Windows");
         return FAILURE;
@@ -54,9 +54,8 @@ errorcode_t parse_type(parse_ctx_t *ctx, ast_type_t *out_type){
     case TOKEN_WORD: {
             ast_elem_base_t *base_elem = malloc(sizeof(ast_elem_base_t));
             base_elem->id = AST_ELEM_BASE;
-            base_elem->base = tokens[*i].data;
-            base_elem->source = sources[*i];
-            tokens[(*i)++].data = NULL; // Take ownership
+            base_elem->base = strclone(tokens[*i].data);
+            base_elem->source = sources[(*i)++];
             out_type->elements[out_type->elements_length] = (ast_elem_t*) base_elem;
         }
         break;
@@ -0,0 +1,38 @@
+
+#include "UTIL/util.h"
+#include "UTIL/cstr_interner.h"
+
+void cstr_interner_init(cstr_interner_t *interner){
+    interner->cstrs = NULL;
+    interner->cstrs_length = 0;
+    interner->cstrs_capacity = 0;
+    hash_index_init(&interner->index);
+}
+
+void cstr_interner_free(cstr_interner_t *interner){
+    for(length_t i = 0; i != interner->cstrs_length; i++){
+        free(interner->cstrs[i]);
+    }
+
+    free(interner->cstrs);
+    hash_index_free(&interner->index);
+}
+
+weak_cstr_t cstr_intern(cstr_interner_t *interner, const char *cstr, length_t length){
+    hash_t hash = hash_data(cstr, length);
+    length_t cursor;
+
+    for(maybe_index_t i = hash_index_find(&interner->index, hash, &cursor); i != -1; i = hash_index_find_next(&interner->index, hash, &cursor)){
+        strong_cstr_t candidate = interner->cstrs[i];
+        if(strncmp(candidate, cstr, length) == 0 && candidate[length] == '\0') return candidate;
+    }
+
+    strong_cstr_t interned = malloc(length + 1);
+    memcpy(interned, cstr, length);
+    interned[length] = '\0';
+
+    expand((void**) &interner->cstrs, sizeof(strong_cstr_t), interner->cstrs_length, &interner->cstrs_capacity, 1, 256);
+    hash_index_insert(&interner->index, hash, interner->cstrs_length);
+    interner->cstrs[interner->cstrs_length++] = interned;
+    return interned;
+}
@@ -240,7 +240,7 @@ strong_cstr_t filename_without_ext(char *filename){
 
 void filename_prepend_dotslash_if_needed(strong_cstr_t *filename){
 	length_t filename_length = strlen(*filename);
-	if(filename_length < 2) return;
+	if(filename_length == 0) return;
 	
 	if((*filename)[0] != '/' && !((*filename)[0] == '.' && (*filename)[1] == '/')){
 		strong_cstr_t new_filename = malloc(2 + filename_length + 1);
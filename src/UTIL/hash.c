@@ -0,0 +1,86 @@
+
+#include "UTIL/util.h"
+#include "UTIL/hash.h"
+
+hash_t hash_data(const void *data, length_t size){
+    return hash_continue(HASH_SEED, data, size);
+}
+
+hash_t hash_cstr(const char *cstr){
+    return hash_continue(HASH_SEED, cstr, strlen(cstr));
+}
+
+hash_t hash_continue(hash_t hash, const void *data, length_t size){
+    const unsigned char *bytes = (const unsigned char*) data;
+
+    for(length_t i = 0; i != size; i++){
+        hash ^= bytes[i];
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+hash_t hash_combine(hash_t a, hash_t b){
+    return a ^ (b + 0x9E3779B97F4A7C15ULL + (a << 6) + (a >> 2));
+}
+
+void hash_index_init(hash_index_t *index){
+    index->slots = NULL;
+    index->length = 0;
+    index->capacity = 0;
+}
+
+void hash_index_free(hash_index_t *index){
+    free(index->slots);
+}
+
+void hash_index_insert(hash_index_t *index, hash_t hash, length_t item){
+    // Keep the load factor at or below one half
+    if((index->length + 1) * 2 > index->capacity){
+        length_t old_capacity = index->capacity;
+        hash_index_slot_t *old_slots = index->slots;
+
+        index->capacity = old_capacity == 0 ? 16 : old_capacity * 2;
+        index->slots = malloc(sizeof(hash_index_slot_t) * index->capacity);
+        memset(index->slots, 0, sizeof(hash_index_slot_t) * index->capacity);
+
+        for(length_t i = 0; i != old_capacity; i++){
+            if(old_slots[i].item == 0) continue;
+
+            length_t slot = old_slots[i].hash & (index->capacity - 1);
+            while(index->slots[slot].item != 0) slot = (slot + 1) & (index->capacity - 1);
+            index->slots[slot] = old_slots[i];
+        }
+
+        free(old_slots);
+    }
+
+    length_t slot = hash & (index->capacity - 1);
+    while(index->slots[slot].item != 0) slot = (slot + 1) & (index->capacity - 1);
+
+    index->slots[slot].hash = hash;
+    index->slots[slot].item = item + 1;
+    index->length++;
+}
+
+maybe_index_t hash_index_find(hash_index_t *index, hash_t hash, length_t *cursor){
+    if(index->capacity == 0) return -1;
+
+    // Start one before the home slot, so 'hash_index_find_next' begins with it
+    *cursor = (hash - 1) & (index->capacity - 1);
+    return hash_index_find_next(index, hash, cursor);
+}
+
+maybe_index_t hash_index_find_next(hash_index_t *index, hash_t hash, length_t *cursor){
+    length_t mask = index->capacity - 1;
+
+    for(length_t slot = (*cursor + 1) & mask; index->slots[slot].item != 0; slot = (slot + 1) & mask){
+        if(index->slots[slot].hash != hash) continue;
+
+        *cursor = slot;
+        return index->slots[slot].item - 1;
+    }
+
+    return -1;
+}